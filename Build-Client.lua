@@ -24,4 +24,8 @@ include "Walnut/Build-Walnut-External.lua"
 group "App"
    include "Vlkrt-Common/Build-Vlkrt-Common.lua"
    include "Vlkrt-Client/Build-Vlkrt-Client.lua"
+group ""
+
+group "Tests"
+   include "Vlkrt-Tests/Build-Vlkrt-Tests.lua"
 group ""
\ No newline at end of file
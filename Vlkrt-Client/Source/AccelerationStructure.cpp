@@ -17,14 +17,20 @@ namespace Vlkrt
 
     AccelerationStructure::~AccelerationStructure() { Cleanup(); }
 
-    void AccelerationStructure::Build(const std::vector<Mesh>& meshes, VkBuffer vertexBuffer, VkBuffer indexBuffer,
+    void AccelerationStructure::Build(const std::vector<TriangleGeometry>& geometries,
+            const std::vector<TriangleInstance>& instances, VkBuffer vertexBuffer, VkBuffer indexBuffer,
             const std::vector<ProceduralEntity>& procedurals)
     {
-        if (meshes.empty() || vertexBuffer == VK_NULL_HANDLE || indexBuffer == VK_NULL_HANDLE) return;
+        if (instances.empty() || vertexBuffer == VK_NULL_HANDLE || indexBuffer == VK_NULL_HANDLE) return;
 
         VkCommandBuffer cmd = Walnut::Application::GetCommandBuffer(true);
 
-        BuildTriangleBLAS(meshes, vertexBuffer, indexBuffer, cmd);
+        m_TriangleBLASes.resize(geometries.size());
+        for (size_t i = 0; i < geometries.size(); i++) {
+            if (geometries[i].IndexCount > 0)
+                m_TriangleBLASes[i] = BuildTriangleBLAS(geometries[i], vertexBuffer, indexBuffer, cmd);
+        }
+        m_TriangleInstances = instances;
 
         if (!procedurals.empty()) BuildAABBBLAS(procedurals, cmd);
 
@@ -34,14 +40,63 @@ namespace Vlkrt
         Walnut::Application::FlushCommandBuffer(cmd);
     }
 
-    void AccelerationStructure::Rebuild(const std::vector<Mesh>& meshes, VkBuffer vertexBuffer, VkBuffer indexBuffer,
+    void AccelerationStructure::Rebuild(const std::vector<TriangleGeometry>& geometries,
+            const std::vector<TriangleInstance>& instances, VkBuffer vertexBuffer, VkBuffer indexBuffer,
             const std::vector<ProceduralEntity>& procedurals)
     {
         Cleanup();
-        Build(meshes, vertexBuffer, indexBuffer, procedurals);
+        Build(geometries, instances, vertexBuffer, indexBuffer, procedurals);
     }
 
-    void AccelerationStructure::Cleanup()
+    void AccelerationStructure::AddGeometries(
+            const std::vector<TriangleGeometry>& geometries, VkBuffer vertexBuffer, VkBuffer indexBuffer)
+    {
+        if (geometries.size() <= m_TriangleBLASes.size()) return;
+
+        VkCommandBuffer cmd   = Walnut::Application::GetCommandBuffer(true);
+        const size_t firstNew = m_TriangleBLASes.size();
+        m_TriangleBLASes.resize(geometries.size());
+        for (size_t i = firstNew; i < geometries.size(); i++) {
+            if (geometries[i].IndexCount > 0)
+                m_TriangleBLASes[i] = BuildTriangleBLAS(geometries[i], vertexBuffer, indexBuffer, cmd);
+        }
+        Walnut::Application::FlushCommandBuffer(cmd);
+    }
+
+    void AccelerationStructure::RebuildProcedurals(
+            const std::vector<ProceduralEntity>& procedurals, const std::vector<TriangleInstance>& instances)
+    {
+        if (!IsBuilt()) return;
+
+        DestroyAABBBLAS();
+        m_TriangleInstances = instances;
+        m_ProceduralCount   = static_cast<uint32_t>(procedurals.size());
+
+        // As in UpdateInstances, the current TLAS stays intact as the refit's source
+        const VkAccelerationStructureKHR source = m_TLASRefitCount < kMaxTLASRefits ? m_TLAS : VK_NULL_HANDLE;
+        VkCommandBuffer cmd                     = Walnut::Application::GetCommandBuffer(true);
+        if (!procedurals.empty()) BuildAABBBLAS(procedurals, cmd);
+        DestroyTLAS();
+        BuildTLAS(cmd, source);
+        Walnut::Application::FlushCommandBuffer(cmd);
+    }
+
+    void AccelerationStructure::UpdateInstances(const std::vector<TriangleInstance>& instances)
+    {
+        if (!IsBuilt()) return;
+
+        m_TriangleInstances = instances;
+
+        // The current TLAS is only handed to SubmitResourceFree, so it stays intact for frames still tracing it and
+        // as the refit's source
+        const VkAccelerationStructureKHR source = m_TLASRefitCount < kMaxTLASRefits ? m_TLAS : VK_NULL_HANDLE;
+        VkCommandBuffer cmd                     = Walnut::Application::GetCommandBuffer(true);
+        DestroyTLAS();
+        BuildTLAS(cmd, source);
+        Walnut::Application::FlushCommandBuffer(cmd);
+    }
+
+    void AccelerationStructure::DestroyTLAS()
     {
         auto defer = [&](auto&& fn) { Walnut::Application::SubmitResourceFree(std::forward<decltype(fn)>(fn)); };
 
@@ -56,6 +111,18 @@ namespace Vlkrt
             });
             m_TLASBuffer = VK_NULL_HANDLE;
         }
+        if (m_InstanceBuffer != VK_NULL_HANDLE) {
+            defer([device = m_Device, b = m_InstanceBuffer, m = m_InstanceMemory]() {
+                vkDestroyBuffer(device, b, nullptr);
+                vkFreeMemory(device, m, nullptr);
+            });
+            m_InstanceBuffer = VK_NULL_HANDLE;
+        }
+    }
+
+    void AccelerationStructure::DestroyAABBBLAS()
+    {
+        auto defer = [&](auto&& fn) { Walnut::Application::SubmitResourceFree(std::forward<decltype(fn)>(fn)); };
 
         if (m_AABBBLAS != VK_NULL_HANDLE) {
             defer([device = m_Device, h = m_AABBBLAS]() { pvkDestroyAccelerationStructureKHR(device, h, nullptr); });
@@ -75,28 +142,25 @@ namespace Vlkrt
             });
             m_AABBGeomBuffer = VK_NULL_HANDLE;
         }
+    }
 
-        if (m_TriangleBLAS != VK_NULL_HANDLE) {
-            defer([device = m_Device, h = m_TriangleBLAS]() {
-                pvkDestroyAccelerationStructureKHR(device, h, nullptr);
-            });
-            m_TriangleBLAS = VK_NULL_HANDLE;
-        }
-        if (m_TriangleBLASBuffer != VK_NULL_HANDLE) {
-            defer([device = m_Device, b = m_TriangleBLASBuffer, m = m_TriangleBLASMemory]() {
-                vkDestroyBuffer(device, b, nullptr);
-                vkFreeMemory(device, m, nullptr);
-            });
-            m_TriangleBLASBuffer = VK_NULL_HANDLE;
-        }
+    void AccelerationStructure::Cleanup()
+    {
+        auto defer = [&](auto&& fn) { Walnut::Application::SubmitResourceFree(std::forward<decltype(fn)>(fn)); };
 
-        if (m_InstanceBuffer != VK_NULL_HANDLE) {
-            defer([device = m_Device, b = m_InstanceBuffer, m = m_InstanceMemory]() {
+        DestroyTLAS();
+        DestroyAABBBLAS();
+
+        for (const BLAS& blas : m_TriangleBLASes) {
+            if (blas.Handle == VK_NULL_HANDLE) continue;
+            defer([device = m_Device, h = blas.Handle, b = blas.Buffer, m = blas.Memory]() {
+                pvkDestroyAccelerationStructureKHR(device, h, nullptr);
                 vkDestroyBuffer(device, b, nullptr);
                 vkFreeMemory(device, m, nullptr);
             });
-            m_InstanceBuffer = VK_NULL_HANDLE;
         }
+        m_TriangleBLASes.clear();
+        m_TriangleInstances.clear();
 
         if (m_ScratchBuffer != VK_NULL_HANDLE) {
             defer([device = m_Device, b = m_ScratchBuffer, m = m_ScratchMemory]() {
@@ -110,29 +174,26 @@ namespace Vlkrt
         m_ProceduralCount = 0;
     }
 
-    void AccelerationStructure::BuildTriangleBLAS(
-            const std::vector<Mesh>& meshes, VkBuffer vertexBuffer, VkBuffer indexBuffer, VkCommandBuffer cmd)
+    auto AccelerationStructure::BuildTriangleBLAS(const TriangleGeometry& geometry, VkBuffer vertexBuffer,
+            VkBuffer indexBuffer, VkCommandBuffer cmd) -> BLAS
     {
-        uint32_t totalTriangles = 0;
-        uint32_t totalVertices  = 0;
-        for (const auto& mesh : meshes) {
-            totalTriangles += static_cast<uint32_t>(mesh.Indices.size() / 3);
-            totalVertices += static_cast<uint32_t>(mesh.Vertices.size());
-        }
+        uint32_t triangleCount = geometry.IndexCount / 3;
 
         VkAccelerationStructureGeometryTrianglesDataKHR trianglesData
                 = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_TRIANGLES_DATA_KHR };
         trianglesData.vertexFormat             = VK_FORMAT_R32G32B32_SFLOAT;
-        trianglesData.vertexData.deviceAddress = GetBufferDeviceAddress(vertexBuffer);
+        trianglesData.vertexData.deviceAddress = GetBufferDeviceAddress(vertexBuffer)
+                                                 + sizeof(GPUVertex) * static_cast<VkDeviceSize>(geometry.FirstVertex);
         trianglesData.vertexStride             = sizeof(GPUVertex);
-        trianglesData.maxVertex                = totalVertices > 0 ? totalVertices - 1 : 0;
+        trianglesData.maxVertex                = geometry.VertexCount > 0 ? geometry.VertexCount - 1 : 0;
         trianglesData.indexType                = VK_INDEX_TYPE_UINT32;
-        trianglesData.indexData.deviceAddress  = GetBufferDeviceAddress(indexBuffer);
+        trianglesData.indexData.deviceAddress  = GetBufferDeviceAddress(indexBuffer)
+                                                + sizeof(uint32_t) * static_cast<VkDeviceSize>(geometry.FirstIndex);
 
-        VkAccelerationStructureGeometryKHR geometry = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR };
-        geometry.geometryType                       = VK_GEOMETRY_TYPE_TRIANGLES_KHR;
-        geometry.geometry.triangles                 = trianglesData;
-        geometry.flags                              = VK_GEOMETRY_OPAQUE_BIT_KHR;
+        VkAccelerationStructureGeometryKHR asGeometry = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR };
+        asGeometry.geometryType                       = VK_GEOMETRY_TYPE_TRIANGLES_KHR;
+        asGeometry.geometry.triangles                 = trianglesData;
+        asGeometry.flags                              = VK_GEOMETRY_OPAQUE_BIT_KHR;
 
         VkAccelerationStructureBuildGeometryInfoKHR buildInfo
                 = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR };
@@ -140,37 +201,41 @@ namespace Vlkrt
         buildInfo.flags         = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR;
         buildInfo.mode          = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
         buildInfo.geometryCount = 1;
-        buildInfo.pGeometries   = &geometry;
+        buildInfo.pGeometries   = &asGeometry;
 
         VkAccelerationStructureBuildSizesInfoKHR sizeInfo
                 = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR };
         pvkGetAccelerationStructureBuildSizesKHR(
-                m_Device, VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR, &buildInfo, &totalTriangles, &sizeInfo);
+                m_Device, VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR, &buildInfo, &triangleCount, &sizeInfo);
 
-        m_TriangleBLASBuffer = CreateBuffer(sizeInfo.accelerationStructureSize,
+        BLAS blas;
+        blas.Buffer = CreateBuffer(sizeInfo.accelerationStructureSize,
                 VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_TriangleBLASMemory);
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, blas.Memory);
 
         VkAccelerationStructureCreateInfoKHR createInfo = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR };
-        createInfo.buffer                               = m_TriangleBLASBuffer;
+        createInfo.buffer                               = blas.Buffer;
         createInfo.size                                 = sizeInfo.accelerationStructureSize;
         createInfo.type                                 = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
-        pvkCreateAccelerationStructureKHR(m_Device, &createInfo, nullptr, &m_TriangleBLAS);
+        pvkCreateAccelerationStructureKHR(m_Device, &createInfo, nullptr, &blas.Handle);
 
-        CreateScratchBuffer(sizeInfo.buildScratchSize);
-        buildInfo.dstAccelerationStructure  = m_TriangleBLAS;
+        if (sizeInfo.buildScratchSize > m_ScratchBufferSize) CreateScratchBuffer(sizeInfo.buildScratchSize);
+        buildInfo.dstAccelerationStructure  = blas.Handle;
         buildInfo.scratchData.deviceAddress = GetBufferDeviceAddress(m_ScratchBuffer);
 
         VkAccelerationStructureBuildRangeInfoKHR buildRange{};
-        buildRange.primitiveCount                              = totalTriangles;
+        buildRange.primitiveCount                              = triangleCount;
         const VkAccelerationStructureBuildRangeInfoKHR* pRange = &buildRange;
         pvkCmdBuildAccelerationStructuresKHR(cmd, 1, &buildInfo, &pRange);
 
+        // Also orders the next build's use of the shared scratch buffer after this one
         VkMemoryBarrier barrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
         barrier.srcAccessMask   = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
-        barrier.dstAccessMask   = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
+        barrier.dstAccessMask
+                = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
         vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
                 VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+        return blas;
     }
 
     void AccelerationStructure::BuildAABBBLAS(const std::vector<ProceduralEntity>& procedurals, VkCommandBuffer cmd)
@@ -271,12 +336,8 @@ namespace Vlkrt
                 VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, 0, 1, &barrier, 0, nullptr, 0, nullptr);
     }
 
-    void AccelerationStructure::BuildTLAS(VkCommandBuffer cmd)
+    void AccelerationStructure::BuildTLAS(VkCommandBuffer cmd, VkAccelerationStructureKHR source)
     {
-        bool hasAABB           = (m_AABBBLAS != VK_NULL_HANDLE);
-        uint32_t instanceCount = hasAABB ? 2u : 1u;
-
-        // Instance 0: triangle BLAS
         auto blasAddr = [&](VkAccelerationStructureKHR as) -> VkDeviceAddress {
             VkAccelerationStructureDeviceAddressInfoKHR info
                     = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR };
@@ -284,24 +345,31 @@ namespace Vlkrt
             return pvkGetAccelerationStructureDeviceAddressKHR(m_Device, &info);
         };
 
-        std::vector<VkAccelerationStructureInstanceKHR> instances(instanceCount);
+        std::vector<VkAccelerationStructureInstanceKHR> instances;
+        instances.reserve(m_TriangleInstances.size() + 1);
+
+        // Triangle instances — SBT offset 0, all faces double-sided
+        for (const TriangleInstance& instance : m_TriangleInstances) {
+            if (instance.Geometry >= m_TriangleBLASes.size()) continue;
+            const BLAS& blas = m_TriangleBLASes[instance.Geometry];
+            if (blas.Handle == VK_NULL_HANDLE) continue;
 
-        // Triangle instance — SBT offset 0, all faces double-sided
-        auto& tri                                  = instances[0];
-        tri                                        = {};
-        tri.transform.matrix[0][0]                 = 1.0f;
-        tri.transform.matrix[1][1]                 = 1.0f;
-        tri.transform.matrix[2][2]                 = 1.0f;
-        tri.instanceCustomIndex                    = 0;
-        tri.mask                                   = 0xFF;
-        tri.instanceShaderBindingTableRecordOffset = 0;
-        tri.flags                                  = VK_GEOMETRY_INSTANCE_TRIANGLE_FACING_CULL_DISABLE_BIT_KHR;
-        tri.accelerationStructureReference         = blasAddr(m_TriangleBLAS);
+            VkAccelerationStructureInstanceKHR tri{};
+            // VkTransformMatrixKHR is a row-major 3x4; glm matrices are column-major
+            for (int r = 0; r < 3; r++) {
+                for (int c = 0; c < 4; c++) tri.transform.matrix[r][c] = instance.Transform[c][r];
+            }
+            tri.instanceCustomIndex                    = instance.CustomIndex;
+            tri.mask                                   = 0xFF;
+            tri.instanceShaderBindingTableRecordOffset = 0;
+            tri.flags                                  = VK_GEOMETRY_INSTANCE_TRIANGLE_FACING_CULL_DISABLE_BIT_KHR;
+            tri.accelerationStructureReference         = blasAddr(blas.Handle);
+            instances.push_back(tri);
+        }
 
         // AABB instance — SBT offset 2, no face culling
-        if (hasAABB) {
-            auto& aabb                                  = instances[1];
-            aabb                                        = {};
+        if (m_AABBBLAS != VK_NULL_HANDLE) {
+            VkAccelerationStructureInstanceKHR aabb{};
             aabb.transform.matrix[0][0]                 = 1.0f;
             aabb.transform.matrix[1][1]                 = 1.0f;
             aabb.transform.matrix[2][2]                 = 1.0f;
@@ -310,7 +378,9 @@ namespace Vlkrt
             aabb.instanceShaderBindingTableRecordOffset = 2;
             aabb.flags                                  = VK_GEOMETRY_INSTANCE_FORCE_OPAQUE_BIT_KHR;
             aabb.accelerationStructureReference         = blasAddr(m_AABBBLAS);
+            instances.push_back(aabb);
         }
+        uint32_t instanceCount = static_cast<uint32_t>(instances.size());
 
         // Upload instance data
         VkDeviceSize instBufSize = sizeof(VkAccelerationStructureInstanceKHR) * instanceCount;
@@ -318,10 +388,12 @@ namespace Vlkrt
                         VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR
                                 | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_InstanceMemory);
-        void* mapped;
-        vkMapMemory(m_Device, m_InstanceMemory, 0, instBufSize, 0, &mapped);
-        memcpy(mapped, instances.data(), instBufSize);
-        vkUnmapMemory(m_Device, m_InstanceMemory);
+        if (instBufSize > 0) {
+            void* mapped;
+            vkMapMemory(m_Device, m_InstanceMemory, 0, instBufSize, 0, &mapped);
+            memcpy(mapped, instances.data(), instBufSize);
+            vkUnmapMemory(m_Device, m_InstanceMemory);
+        }
 
         // Build TLAS
         VkAccelerationStructureGeometryInstancesDataKHR instancesData
@@ -336,11 +408,19 @@ namespace Vlkrt
         VkAccelerationStructureBuildGeometryInfoKHR buildInfo
                 = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR };
         buildInfo.type          = VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR;
-        buildInfo.flags         = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR;
+        buildInfo.flags         = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR
+                                  | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR;
         buildInfo.mode          = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
         buildInfo.geometryCount = 1;
         buildInfo.pGeometries   = &geometry;
 
+        // An update needs the same instances, possibly moved or pointing at other BLASes
+        const bool refit = source != VK_NULL_HANDLE && instanceCount == m_TLASInstanceCount;
+        if (refit) {
+            buildInfo.mode                     = VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR;
+            buildInfo.srcAccelerationStructure = source;
+        }
+
         VkAccelerationStructureBuildSizesInfoKHR sizeInfo
                 = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR };
         pvkGetAccelerationStructureBuildSizesKHR(
@@ -356,7 +436,8 @@ namespace Vlkrt
         createInfo.type                                 = VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR;
         pvkCreateAccelerationStructureKHR(m_Device, &createInfo, nullptr, &m_TLAS);
 
-        if (sizeInfo.buildScratchSize > m_ScratchBufferSize) CreateScratchBuffer(sizeInfo.buildScratchSize);
+        const VkDeviceSize scratchSize = refit ? sizeInfo.updateScratchSize : sizeInfo.buildScratchSize;
+        if (scratchSize > m_ScratchBufferSize) CreateScratchBuffer(scratchSize);
 
         buildInfo.dstAccelerationStructure  = m_TLAS;
         buildInfo.scratchData.deviceAddress = GetBufferDeviceAddress(m_ScratchBuffer);
@@ -365,6 +446,8 @@ namespace Vlkrt
         buildRange.primitiveCount                              = instanceCount;
         const VkAccelerationStructureBuildRangeInfoKHR* pRange = &buildRange;
         pvkCmdBuildAccelerationStructuresKHR(cmd, 1, &buildInfo, &pRange);
+        m_TLASInstanceCount = instanceCount;
+        m_TLASRefitCount    = refit ? m_TLASRefitCount + 1 : 0;
 
         VkMemoryBarrier barrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
         barrier.srcAccessMask   = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
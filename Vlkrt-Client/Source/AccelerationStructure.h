@@ -1,17 +1,20 @@
 #pragma once
 
 #include <vulkan/vulkan.h>
+#include <glm/glm.hpp>
 #include <vector>
 
 namespace Vlkrt
 {
-    struct Mesh;
     struct ProceduralEntity;
 
     /// <summary>
-    /// Manages two BLASes (triangle geometry + AABB procedural geometry) and a single TLAS.
+    /// Manages the triangle BLASes (one per unique mesh geometry), an AABB BLAS for procedural geometry and a single
+    /// TLAS.
     ///
-    /// Triangle BLAS  — geometry for all triangle meshes.  TLAS instanceSBTOffset = 0.
+    /// Triangle BLAS  — one per TriangleGeometry, over its object-space range of the vertex and index buffers.
+    ///                  One TLAS instance per TriangleInstance, instanceSBTOffset = 0, instanceCustomIndex =
+    ///                  TriangleInstance::CustomIndex.
     /// AABB BLAS      — one VkAabbPositionsKHR geometry per ProceduralEntity.  TLAS instanceSBTOffset = 2.
     ///
     /// The SBT layout expected by the renderer:
@@ -22,14 +25,45 @@ namespace Vlkrt
     /// </summary>
     class AccelerationStructure
     {
+    public:
+        // A range of the vertex and index buffers; indices are relative to FirstVertex
+        struct TriangleGeometry
+        {
+            uint32_t FirstVertex{ 0 };
+            uint32_t VertexCount{ 0 };
+            uint32_t FirstIndex{ 0 };
+            uint32_t IndexCount{ 0 };
+        };
+
+        struct TriangleInstance
+        {
+            glm::mat4 Transform{ 1.0f };
+            uint32_t Geometry{ 0 };     // Index into the geometries
+            uint32_t CustomIndex{ 0 };  // InstanceID() in the hit shaders
+        };
+
+        // Refits loosen the tree as instances move away from where it was built, so every so many it is rebuilt
+        static constexpr uint32_t kMaxTLASRefits = 32;
+
     public:
         AccelerationStructure();
         ~AccelerationStructure();
 
-        void Build(const std::vector<Mesh>& meshes, VkBuffer vertexBuffer, VkBuffer indexBuffer,
-                const std::vector<ProceduralEntity>& procedurals = {});
-        void Rebuild(const std::vector<Mesh>& meshes, VkBuffer vertexBuffer, VkBuffer indexBuffer,
-                const std::vector<ProceduralEntity>& procedurals = {});
+        void Build(const std::vector<TriangleGeometry>& geometries, const std::vector<TriangleInstance>& instances,
+                VkBuffer vertexBuffer, VkBuffer indexBuffer, const std::vector<ProceduralEntity>& procedurals = {});
+        void Rebuild(const std::vector<TriangleGeometry>& geometries, const std::vector<TriangleInstance>& instances,
+                VkBuffer vertexBuffer, VkBuffer indexBuffer, const std::vector<ProceduralEntity>& procedurals = {});
+        // Builds the BLASes of the geometries past the ones already built, which must be unchanged; instances refer to
+        // them from the next TLAS update on
+        void AddGeometries(
+                const std::vector<TriangleGeometry>& geometries, VkBuffer vertexBuffer, VkBuffer indexBuffer);
+        // Rebuilds the AABB BLAS for the procedurals, and then the TLAS; the triangle BLASes are kept
+        void RebuildProcedurals(
+                const std::vector<ProceduralEntity>& procedurals, const std::vector<TriangleInstance>& instances);
+        // Replaces the TLAS alone, for instances that moved or switched geometry; they must refer to the geometries
+        // built so far. The new TLAS is refitted from the current one when the instance count allows, and rebuilt
+        // otherwise; GetTLAS changes either way.
+        void UpdateInstances(const std::vector<TriangleInstance>& instances);
         void Cleanup();
 
         auto GetTLAS() const -> VkAccelerationStructureKHR { return m_TLAS; }
@@ -37,10 +71,20 @@ namespace Vlkrt
         auto GetProceduralCount() const -> uint32_t { return m_ProceduralCount; }
 
     private:
-        void BuildTriangleBLAS(
-                const std::vector<Mesh>& meshes, VkBuffer vertexBuffer, VkBuffer indexBuffer, VkCommandBuffer cmd);
+        struct BLAS
+        {
+            VkAccelerationStructureKHR Handle{ VK_NULL_HANDLE };
+            VkBuffer Buffer{ VK_NULL_HANDLE };
+            VkDeviceMemory Memory{ VK_NULL_HANDLE };
+        };
+
+        auto BuildTriangleBLAS(const TriangleGeometry& geometry, VkBuffer vertexBuffer, VkBuffer indexBuffer,
+                VkCommandBuffer cmd) -> BLAS;
         void BuildAABBBLAS(const std::vector<ProceduralEntity>& procedurals, VkCommandBuffer cmd);
-        void BuildTLAS(VkCommandBuffer cmd);
+        // Refits source (a TLAS over as many instances) into the new TLAS if given, instead of building from scratch
+        void BuildTLAS(VkCommandBuffer cmd, VkAccelerationStructureKHR source = VK_NULL_HANDLE);
+        void DestroyTLAS();
+        void DestroyAABBBLAS();
         void CreateScratchBuffer(VkDeviceSize size);
 
         auto CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties,
@@ -48,10 +92,9 @@ namespace Vlkrt
         auto GetBufferDeviceAddress(VkBuffer buffer) const -> VkDeviceAddress;
 
     private:
-        // Triangle BLAS
-        VkAccelerationStructureKHR m_TriangleBLAS{ VK_NULL_HANDLE };
-        VkBuffer m_TriangleBLASBuffer{ VK_NULL_HANDLE };
-        VkDeviceMemory m_TriangleBLASMemory{ VK_NULL_HANDLE };
+        // Triangle BLASes, by geometry; empty geometries get a null one
+        std::vector<BLAS> m_TriangleBLASes;
+        std::vector<TriangleInstance> m_TriangleInstances;
 
         // AABB BLAS (procedural primitives)
         VkAccelerationStructureKHR m_AABBBLAS{ VK_NULL_HANDLE };
@@ -65,8 +108,10 @@ namespace Vlkrt
         VkAccelerationStructureKHR m_TLAS{ VK_NULL_HANDLE };
         VkBuffer m_TLASBuffer{ VK_NULL_HANDLE };
         VkDeviceMemory m_TLASMemory{ VK_NULL_HANDLE };
+        uint32_t m_TLASInstanceCount{ 0 };
+        uint32_t m_TLASRefitCount{ 0 };  // Since the last full build
 
-        // Instance buffer (host-visible, ≤2 entries: triangle + optional AABB)
+        // Instance buffer (host-visible: one entry per triangle instance, plus the AABB one)
         VkBuffer m_InstanceBuffer{ VK_NULL_HANDLE };
         VkDeviceMemory m_InstanceMemory{ VK_NULL_HANDLE };
 
@@ -0,0 +1,519 @@
+#include "Benchmarks.h"
+#include "GeometryRegistry.h"
+#include "MeshLoader.h"
+#include "MeshOptimizer.h"
+#include "MeshletBuilder.h"
+#include "Renderer.h"
+#include "SceneBVH.h"
+#include "SceneCache.h"
+#include "SceneLoader.h"
+#include "ThreadPool.h"
+#include "VertexPacking.h"
+
+#include "Walnut/Core/Log.h"
+#include "Walnut/Timer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Vlkrt
+{
+    namespace
+    {
+        // Keeps results alive so the optimizer cannot drop the measured work
+        static volatile size_t s_Sink = 0;
+
+        struct RandomQueries
+        {
+            std::vector<glm::vec3> Origins;
+            std::vector<glm::vec3> Directions;
+            std::vector<AABB> Boxes;
+        };
+
+        static auto MakeQueries(const AABB& bounds, uint32_t count) -> RandomQueries
+        {
+            std::mt19937 rng(1337u);
+            std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+            std::uniform_real_distribution<float> signedUnit(-1.0f, 1.0f);
+
+            const glm::vec3 extent   = bounds.GetExtent();
+            const float queryHalfBox = 0.05f * std::max(std::max(extent.x, extent.y), extent.z);
+
+            RandomQueries queries;
+            queries.Origins.reserve(count);
+            queries.Directions.reserve(count);
+            queries.Boxes.reserve(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                glm::vec3 origin = bounds.Min + extent * glm::vec3(unit(rng), unit(rng), unit(rng));
+                glm::vec3 dir(signedUnit(rng), signedUnit(rng), signedUnit(rng));
+                if (glm::dot(dir, dir) < 1e-6f) dir = glm::vec3(0.0f, -1.0f, 0.0f);
+
+                queries.Origins.push_back(origin);
+                queries.Directions.push_back(glm::normalize(dir));
+                queries.Boxes.push_back({ origin - glm::vec3(queryHalfBox), origin + glm::vec3(queryHalfBox) });
+            }
+            return queries;
+        }
+    }  // namespace
+
+    auto Benchmarks::RunSceneBVH(const Scene& scene, uint32_t queryCount) -> std::string
+    {
+        constexpr uint32_t kBuildIterations = 10;
+        constexpr uint32_t kNearestK        = 8;
+
+        SceneBVH bvh;
+        Walnut::Timer timer;
+        for (uint32_t i = 0; i < kBuildIterations; ++i) bvh.Build(scene);
+        const float buildMs = timer.ElapsedMillis() / kBuildIterations;
+
+        std::ostringstream report;
+        if (bvh.GetItemCount() == 0) {
+            report << "SceneBVH: scene has no meshes or procedurals";
+            return report.str();
+        }
+
+        // Refit every item, the worst case for an incremental update
+        std::vector<uint32_t> allMeshes(scene.StaticMeshes.size());
+        std::vector<uint32_t> allProcedurals(scene.ProceduralEntities.size());
+        for (uint32_t i = 0; i < (uint32_t) allMeshes.size(); ++i) allMeshes[i] = i;
+        for (uint32_t i = 0; i < (uint32_t) allProcedurals.size(); ++i) allProcedurals[i] = i;
+        timer.Reset();
+        bvh.Refit(scene, allMeshes, allProcedurals);
+        const float refitMs = timer.ElapsedMillis();
+
+        // Linear-scan baseline over the same world bounds
+        std::vector<std::pair<SpatialItem, AABB>> flat;
+        flat.reserve(bvh.GetItemCount());
+        for (uint32_t i = 0; i < (uint32_t) scene.StaticMeshes.size(); ++i) {
+            AABB b = bvh.GetItemBounds({ EntityType::Mesh, i });
+            if (b.IsValid()) flat.push_back({ { EntityType::Mesh, i }, b });
+        }
+        for (uint32_t i = 0; i < (uint32_t) scene.ProceduralEntities.size(); ++i) {
+            flat.push_back({ { EntityType::Procedural, i }, bvh.GetItemBounds({ EntityType::Procedural, i }) });
+        }
+
+        const RandomQueries queries = MakeQueries(bvh.GetRootBounds(), queryCount);
+        size_t checksum             = 0;
+
+        timer.Reset();
+        for (uint32_t q = 0; q < queryCount; ++q) {
+            if (auto hit = bvh.Raycast(queries.Origins[q], queries.Directions[q])) checksum += hit->Item.Index;
+        }
+        const float rayBvhMs = timer.ElapsedMillis();
+
+        timer.Reset();
+        for (uint32_t q = 0; q < queryCount; ++q) {
+            const glm::vec3 invDir = 1.0f / queries.Directions[q];
+            float closest          = FLT_MAX;
+            uint32_t closestIndex  = 0;
+            for (const auto& [item, bounds] : flat) {
+                float t = 0.0f;
+                if (bounds.IntersectRay(queries.Origins[q], invDir, closest, t)) {
+                    closest      = t;
+                    closestIndex = item.Index;
+                }
+            }
+            checksum += closestIndex;
+        }
+        const float rayLinearMs = timer.ElapsedMillis();
+
+        std::vector<SpatialItem> overlapItems;
+        timer.Reset();
+        for (uint32_t q = 0; q < queryCount; ++q) {
+            overlapItems.clear();
+            bvh.QueryOverlap(queries.Boxes[q], overlapItems);
+            checksum += overlapItems.size();
+        }
+        const float overlapBvhMs = timer.ElapsedMillis();
+
+        timer.Reset();
+        for (uint32_t q = 0; q < queryCount; ++q) {
+            size_t count = 0;
+            for (const auto& [item, bounds] : flat) count += bounds.Overlaps(queries.Boxes[q]) ? 1 : 0;
+            checksum += count;
+        }
+        const float overlapLinearMs = timer.ElapsedMillis();
+
+        timer.Reset();
+        for (uint32_t q = 0; q < queryCount; ++q) checksum += bvh.QueryNearest(queries.Origins[q], kNearestK).size();
+        const float nearestBvhMs = timer.ElapsedMillis();
+
+        std::vector<std::pair<float, uint32_t>> distances(flat.size());
+        timer.Reset();
+        for (uint32_t q = 0; q < queryCount; ++q) {
+            for (size_t i = 0; i < flat.size(); ++i) {
+                distances[i] = { flat[i].second.DistanceSquared(queries.Origins[q]), flat[i].first.Index };
+            }
+            const size_t k = std::min<size_t>(kNearestK, distances.size());
+            std::partial_sort(distances.begin(), distances.begin() + k, distances.end());
+            checksum += k;
+        }
+        const float nearestLinearMs = timer.ElapsedMillis();
+
+        s_Sink = s_Sink + checksum;
+
+        auto perQueryUs = [&](float ms) { return ms * 1000.0f / (float) queryCount; };
+        char line[160];
+        report << "SceneBVH: " << bvh.GetItemCount() << " items, " << bvh.GetNodeCount() << " nodes\n";
+        std::snprintf(line, sizeof(line), "Build %.3f ms, full refit %.3f ms\n", buildMs, refitMs);
+        report << line;
+        std::snprintf(line, sizeof(line), "Raycast   %.3f us (linear %.3f us)\n", perQueryUs(rayBvhMs),
+                perQueryUs(rayLinearMs));
+        report << line;
+        std::snprintf(line, sizeof(line), "Overlap   %.3f us (linear %.3f us)\n", perQueryUs(overlapBvhMs),
+                perQueryUs(overlapLinearMs));
+        report << line;
+        std::snprintf(line, sizeof(line), "%u-nearest %.3f us (linear %.3f us)", kNearestK, perQueryUs(nearestBvhMs),
+                perQueryUs(nearestLinearMs));
+        report << line;
+
+        WL_INFO_TAG("Benchmarks", "{}", report.str());
+        return report.str();
+    }
+
+    auto Benchmarks::RunSceneLoad(const std::string& filename) -> std::string
+    {
+        std::ostringstream report;
+        Scene scene;
+        SceneEntity root;
+
+        // Cold source load: YAML parse plus every OBJ/glTF decoded from disk, except geometry the open scene shares
+        // (it stays registered, so the live scene's meshes are never swapped out from under it)
+        GeometryRegistry::EvictUnused();
+        Walnut::Timer timer;
+        if (!SceneLoader::LoadFromYAMLWithHierarchy(filename, scene, root, false)) {
+            report << "Scene load: failed to load '" << filename << "'";
+            return report.str();
+        }
+        const float yamlMs = timer.ElapsedMillis();
+
+        timer.Reset();
+        const bool baked   = SceneCache::Save(filename, scene, root);
+        const float bakeMs = timer.ElapsedMillis();
+        if (!baked) {
+            report << "Scene load: failed to bake '" << filename << "'";
+            return report.str();
+        }
+
+        // Cold baked load: no geometry resident, so every blob is copied out of the mapping
+        GeometryRegistry::EvictUnused();
+        timer.Reset();
+        const bool loaded      = SceneCache::TryLoad(filename, scene, root);
+        const float bakedMs    = timer.ElapsedMillis();
+        const size_t meshCount = scene.StaticMeshes.size();
+
+        // Warm baked load: geometry still resident from the previous load
+        timer.Reset();
+        SceneCache::TryLoad(filename, scene, root);
+        const float warmMs = timer.ElapsedMillis();
+
+        std::error_code ec;
+        const auto cacheBytes = std::filesystem::file_size(SceneCache::GetCachePath(filename), ec);
+
+        char line[160];
+        report << "Scene load '" << filename << "': " << meshCount << " meshes\n";
+        std::snprintf(line, sizeof(line), "YAML (cold) %.2f ms, bake %.2f ms (%.1f MB)\n", yamlMs, bakeMs,
+                ec ? 0.0 : cacheBytes / (1024.0 * 1024.0));
+        report << line;
+        std::snprintf(line, sizeof(line), "Baked (cold) %.2f ms%s, baked (warm) %.2f ms", bakedMs,
+                loaded ? "" : " [failed]", warmMs);
+        report << line;
+
+        WL_INFO_TAG("Benchmarks", "{}", report.str());
+        return report.str();
+    }
+
+    auto Benchmarks::RunGLTFDecode(const Scene& scene) -> std::string
+    {
+        std::ostringstream report;
+        std::unordered_set<std::string> files;
+        for (const auto& mesh : scene.StaticMeshes) {
+            std::string ext = std::filesystem::path(mesh.Filename).extension().string();
+            std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+            if (ext == ".gltf" || ext == ".glb") files.insert(mesh.Filename);
+        }
+        if (files.empty()) {
+            report << "glTF decode: scene references no glTF files";
+            return report.str();
+        }
+
+        // Primitives are decoded only on a registry miss, so drop everything the open scene does not hold
+        GeometryRegistry::EvictUnused();
+        float parseMs     = 0.0f;
+        float decodeMs    = 0.0f;
+        uint64_t vertices = 0;
+        size_t meshCount  = 0;
+        for (const auto& file : files) {
+            const LoadedGLTFScene imported = MeshLoader::LoadGLTF(file);
+            parseMs += imported.ParseMillis;
+            decodeMs += imported.DecodeMillis;
+            vertices += imported.DecodedVertexCount;
+            meshCount += imported.Meshes.size();
+        }
+
+        char line[160];
+        report << "glTF decode: " << files.size() << " files, " << meshCount << " meshes\n";
+        std::snprintf(line, sizeof(line), "Parse %.2f ms, decode %.2f ms\n", parseMs, decodeMs);
+        report << line;
+        std::snprintf(line, sizeof(line), "%.2f M vertices, %.1f M vertices/s", vertices / 1.0e6,
+                decodeMs > 0.0f ? vertices / (decodeMs * 1000.0) : 0.0);
+        report << line;
+
+        WL_INFO_TAG("Benchmarks", "{}", report.str());
+        return report.str();
+    }
+
+    auto Benchmarks::RunMeshOptimization(const Scene& scene) -> std::string
+    {
+        std::ostringstream report;
+        std::unordered_set<const MeshGeometry*> seen;
+        std::vector<const MeshGeometry*> geometries;
+        for (const auto& mesh : scene.StaticMeshes) {
+            if (mesh.Geometry && seen.insert(mesh.Geometry.get()).second) geometries.push_back(mesh.Geometry.get());
+        }
+        if (geometries.empty()) {
+            report << "Mesh optimization: scene has no meshes";
+            return report.str();
+        }
+
+        // Triangle-weighted averages; column 0 is the geometry as loaded, 1 vertex cache order, 2 spatial + cache
+        double triangles = 0.0;
+        double acmr[3]{}, atvr[3]{}, fetch[3]{};
+        float optimizeMs[2]{};
+        for (const MeshGeometry* geometry : geometries) {
+            const double weight = static_cast<double>(geometry->Indices.size() / 3);
+            triangles += weight;
+            for (int pass = 0; pass < 3; ++pass) {
+                MeshLocalityMetrics metrics;
+                if (pass == 0) {
+                    metrics = MeshOptimizer::Analyze(*geometry);
+                }
+                else {
+                    Walnut::Timer timer;
+                    const MeshGeometry optimized = MeshOptimizer::Optimize(*geometry, pass == 2);
+                    optimizeMs[pass - 1] += timer.ElapsedMillis();
+                    metrics = MeshOptimizer::Analyze(optimized);
+                }
+                acmr[pass] += metrics.ACMR * weight;
+                atvr[pass] += metrics.ATVR * weight;
+                fetch[pass] += metrics.FetchEfficiency * weight;
+            }
+        }
+        if (triangles == 0.0) triangles = 1.0;
+
+        static constexpr const char* kPassNames[3] = { "As loaded", "Cache order", "Spatial+cache" };
+        char line[160];
+        report << "Mesh optimization: " << geometries.size() << " geometries, " << static_cast<uint64_t>(triangles)
+               << " triangles\n";
+        for (int pass = 0; pass < 3; ++pass) {
+            std::snprintf(line, sizeof(line), "%-13s ACMR %.3f, ATVR %.3f, fetch %.3f", kPassNames[pass],
+                    acmr[pass] / triangles, atvr[pass] / triangles, fetch[pass] / triangles);
+            report << line;
+            if (pass > 0) {
+                std::snprintf(line, sizeof(line), " (%.2f ms)", optimizeMs[pass - 1]);
+                report << line;
+            }
+            if (pass < 2) report << "\n";
+        }
+
+        WL_INFO_TAG("Benchmarks", "{}", report.str());
+        return report.str();
+    }
+
+    auto Benchmarks::RunMeshlets(const Scene& scene, const glm::vec3& viewPosition) -> std::string
+    {
+        std::ostringstream report;
+        std::unordered_map<const MeshGeometry*, MeshletData> meshlets;
+        Walnut::Timer timer;
+        for (const auto& mesh : scene.StaticMeshes) {
+            if (mesh.Geometry && !meshlets.contains(mesh.Geometry.get())) {
+                meshlets.emplace(mesh.Geometry.get(), MeshletBuilder::Build(*mesh.Geometry));
+            }
+        }
+        const float buildMs = timer.ElapsedMillis();
+        if (meshlets.empty()) {
+            report << "Meshlets: scene has no meshes";
+            return report.str();
+        }
+
+        uint64_t clusterCount = 0, vertexCount = 0, triangleCount = 0;
+        for (const auto& [geometry, data] : meshlets) {
+            clusterCount += data.Meshlets.size();
+            vertexCount += data.VertexIndices.size();
+            triangleCount += data.TriangleIndices.size() / 3;
+        }
+
+        // Cones are in object space, so test every instance from the view position brought into its space
+        uint64_t instanceClusters = 0, culledClusters = 0;
+        for (const auto& mesh : scene.StaticMeshes) {
+            if (!mesh.Geometry) continue;
+            const glm::vec3 localView = glm::vec3(glm::inverse(mesh.Transform) * glm::vec4(viewPosition, 1.0f));
+            for (const Meshlet& meshlet : meshlets.at(mesh.Geometry.get()).Meshlets) {
+                ++instanceClusters;
+                if (meshlet.IsBackfacing(localView)) ++culledClusters;
+            }
+        }
+
+        char line[160];
+        report << "Meshlets (" << MeshletBuilder::kMaxVertices << "v/" << MeshletBuilder::kMaxTriangles << "t): "
+               << meshlets.size() << " geometries, " << clusterCount << " clusters\n";
+        std::snprintf(line, sizeof(line), "Build %.2f ms, avg %.1f vertices / %.1f triangles per cluster\n", buildMs,
+                clusterCount ? static_cast<double>(vertexCount) / clusterCount : 0.0,
+                clusterCount ? static_cast<double>(triangleCount) / clusterCount : 0.0);
+        report << line;
+        std::snprintf(line, sizeof(line), "Back-facing from camera: %llu / %llu instanced clusters (%.1f%%)",
+                static_cast<unsigned long long>(culledClusters), static_cast<unsigned long long>(instanceClusters),
+                instanceClusters ? 100.0 * culledClusters / instanceClusters : 0.0);
+        report << line;
+
+        WL_INFO_TAG("Benchmarks", "{}", report.str());
+        return report.str();
+    }
+
+    auto Benchmarks::RunInstanceUpdate(const Scene& scene) -> std::string
+    {
+        constexpr uint32_t kIterations = 10;
+
+        std::ostringstream report;
+        std::vector<const Mesh*> meshes;
+        size_t vertexCount = 0;
+        for (const auto& mesh : scene.StaticMeshes) {
+            meshes.push_back(&mesh);
+            vertexCount += mesh.GetVertices().size();
+        }
+        for (const auto& mesh : scene.DynamicMeshes) {
+            meshes.push_back(&mesh);
+            vertexCount += mesh.GetVertices().size();
+        }
+        if (vertexCount == 0) {
+            report << "Instance update: scene has no meshes";
+            return report.str();
+        }
+
+        // World-space baking one vertex at a time, as before per-instance transforms: any moved mesh re-packed the
+        // whole scene
+        std::vector<GPUVertex> baked(vertexCount);
+        Walnut::Timer timer;
+        for (uint32_t i = 0; i < kIterations; ++i) {
+            GPUVertex* out = baked.data();
+            for (const Mesh* mesh : meshes) {
+                const auto& vertices = mesh->GetVertices();
+                VertexPacking::PackScalar(vertices.data(), vertices.size(), out, &mesh->Transform);
+                out += vertices.size();
+            }
+            s_Sink = s_Sink + static_cast<size_t>(baked[i % vertexCount].position.x);
+        }
+        const float bakeMs = timer.ElapsedMillis() / kIterations;
+
+        // Instanced: only the moved mesh's record is rewritten
+        std::vector<GPUMeshInstance> records(meshes.size());
+        constexpr uint32_t kRecordIterations = 10000;
+        timer.Reset();
+        for (uint32_t i = 0; i < kRecordIterations; ++i) {
+            const Mesh& mesh = *meshes[i % meshes.size()];
+            GPUMeshInstance record{};
+            record.objectToWorld     = mesh.Transform;
+            record.prevObjectToWorld = mesh.Transform;
+            record.normalMatrix      = glm::mat4(glm::transpose(glm::inverse(glm::mat3(mesh.Transform))));
+            record.materialIndex     = mesh.MaterialIndex;
+
+            records[i % meshes.size()] = record;
+        }
+        s_Sink = s_Sink + static_cast<size_t>(records[0].normalMatrix[0][0]);
+        const float recordMs = timer.ElapsedMillis() / kRecordIterations;
+
+        char line[160];
+        report << "Instance update: " << meshes.size() << " meshes, " << vertexCount << " vertices\n";
+        std::snprintf(line, sizeof(line), "Bake all vertices %.3f ms (%.2f MB), one instance record %.4f ms (%zu B)",
+                bakeMs, sizeof(GPUVertex) * vertexCount / (1024.0 * 1024.0), recordMs, sizeof(GPUMeshInstance));
+        report << line;
+
+        WL_INFO_TAG("Benchmarks", "{}", report.str());
+        return report.str();
+    }
+
+    auto Benchmarks::RunVertexPacking(const Scene& scene) -> std::string
+    {
+        constexpr uint32_t kIterations = 10;
+
+        std::ostringstream report;
+        std::vector<const Mesh*> meshes;
+        size_t vertexCount = 0;
+        for (const auto& mesh : scene.StaticMeshes) {
+            meshes.push_back(&mesh);
+            vertexCount += mesh.GetVertices().size();
+        }
+        for (const auto& mesh : scene.DynamicMeshes) {
+            meshes.push_back(&mesh);
+            vertexCount += mesh.GetVertices().size();
+        }
+        if (vertexCount == 0) {
+            report << "Vertex packing: scene has no meshes";
+            return report.str();
+        }
+
+        using PackFunction = void (*)(const Vertex*, size_t, GPUVertex*, const glm::mat4*);
+        std::vector<GPUVertex> packed(vertexCount);
+        auto measure = [&](PackFunction pack, bool transformed) -> float {
+            Walnut::Timer timer;
+            for (uint32_t i = 0; i < kIterations; ++i) {
+                GPUVertex* out = packed.data();
+                for (const Mesh* mesh : meshes) {
+                    const auto& vertices = mesh->GetVertices();
+                    pack(vertices.data(), vertices.size(), out, transformed ? &mesh->Transform : nullptr);
+                    out += vertices.size();
+                }
+                s_Sink = s_Sink + static_cast<size_t>(packed[i % vertexCount].position.y);
+            }
+            return timer.ElapsedMillis() / kIterations;
+        };
+
+        static constexpr const char* kKernelNames[3] = { "Scalar", "SIMD", "SIMD parallel" };
+        const PackFunction kernels[3]
+                = { &VertexPacking::PackScalar, &VertexPacking::Pack, &VertexPacking::PackParallel };
+
+        char line[160];
+        report << "Vertex packing: " << meshes.size() << " meshes, " << vertexCount << " vertices ("
+               << ThreadPool::Get().GetThreadCount() << " workers)";
+        for (int kernel = 0; kernel < 3; ++kernel) {
+            const float objectMs      = measure(kernels[kernel], false);
+            const float transformedMs = measure(kernels[kernel], true);
+            std::snprintf(line, sizeof(line), "\n%-13s object %.3f ms, transformed %.3f ms (%.1f M vertices/s)",
+                    kKernelNames[kernel], objectMs, transformedMs,
+                    transformedMs > 0.0f ? vertexCount / (transformedMs * 1000.0) : 0.0);
+            report << line;
+        }
+
+        // Round-trip error of the compact encodings, as the hit shader decodes them
+        measure(&VertexPacking::Pack, false);
+        float maxNormalDegrees   = 0.0f;
+        float maxTexCoordError   = 0.0f;
+        const GPUVertex* encoded = packed.data();
+        for (const Mesh* mesh : meshes) {
+            for (const Vertex& vertex : mesh->GetVertices()) {
+                const float normalLength = glm::length(vertex.Normal);
+                if (normalLength > 0.0f) {
+                    const glm::vec3 decoded = VertexPacking::DecodeNormal(encoded->normal);
+                    const float cosAngle    = std::min(glm::dot(decoded, vertex.Normal / normalLength), 1.0f);
+                    maxNormalDegrees        = std::max(maxNormalDegrees, glm::degrees(std::acos(cosAngle)));
+                }
+                const glm::vec2 texCoordError
+                        = glm::abs(VertexPacking::DecodeTexCoord(encoded->texCoord) - vertex.TexCoord);
+                maxTexCoordError = std::max(maxTexCoordError, std::max(texCoordError.x, texCoordError.y));
+                ++encoded;
+            }
+        }
+        std::snprintf(line, sizeof(line), "\n%zu B vertices (48 B padded): normal error %.4f deg, UV error %.2e",
+                sizeof(GPUVertex), maxNormalDegrees, maxTexCoordError);
+        report << line;
+
+        WL_INFO_TAG("Benchmarks", "{}", report.str());
+        return report.str();
+    }
+}  // namespace Vlkrt
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Scene.h"
+
+#include <string>
+
+namespace Vlkrt
+{
+    /// <summary>
+    /// In-app micro-benchmarks for the CPU-side scene systems, run on demand from the Stats panel against the loaded
+    /// scene. Each benchmark logs its timings and returns them as a short multi-line report for display.
+    /// </summary>
+    class Benchmarks
+    {
+    public:
+        // SceneBVH build/refit cost and ray, overlap and k-nearest queries against a linear scan.
+        static auto RunSceneBVH(const Scene& scene, uint32_t queryCount = 10000) -> std::string;
+        // Loading a YAML scene from source against loading its baked binary cache, both with no assets resident.
+        static auto RunSceneLoad(const std::string& filename) -> std::string;
+        // Cold import of every glTF file the scene references, split into tinygltf parse and vertex/index decode.
+        static auto RunGLTFDecode(const Scene& scene) -> std::string;
+        // Locality metrics of the scene's geometry as loaded, and after MeshOptimizer with and without spatial sort.
+        static auto RunMeshOptimization(const Scene& scene) -> std::string;
+        // Meshlet build cost and fill for the scene's geometry, and the share of clusters whose normal cone rejects
+        // them as back-facing from viewPosition.
+        static auto RunMeshlets(const Scene& scene, const glm::vec3& viewPosition) -> std::string;
+        // Moving one mesh: re-baking every mesh's vertices into world space against rewriting one instance record.
+        static auto RunInstanceUpdate(const Scene& scene) -> std::string;
+        // GPUVertex packing of every mesh's vertices: scalar reference, SIMD kernel and SIMD across the thread pool,
+        // in object space and with each mesh's transform.
+        static auto RunVertexPacking(const Scene& scene) -> std::string;
+    };
+}  // namespace Vlkrt
@@ -1,4 +1,8 @@
 #include "ClientLayer.h"
+#include "Benchmarks.h"
+#include "GeometryRegistry.h"
+#include "MaterialRegistry.h"
+#include "MeshSimplifier.h"
 #include "ServerPacket.h"
 #include "SceneLoader.h"
 #include "ScriptEngine.h"
@@ -68,7 +72,11 @@ namespace Vlkrt
         scanDirectory(SCRIPTS_DIR, m_AvailableScripts, { ".lua" });
     }
 
-    void ClientLayer::OnDetach() { ScriptEngine::Shutdown(); }
+    void ClientLayer::OnDetach()
+    {
+        m_SceneLoadJob.reset();
+        ScriptEngine::Shutdown();
+    }
 
     void ClientLayer::OnUpdate(float ts)
     {
@@ -76,6 +84,9 @@ namespace Vlkrt
             m_Renderer.PreloadTextures(m_AvailableTextures);
             m_TexturesLoaded = true;
         }
+        m_Renderer.UpdateTextureStreaming();
+
+        PollSceneLoad(false);
 
         RunScripts(m_SceneRoot, ts);
 
@@ -149,7 +160,16 @@ namespace Vlkrt
         // Sync hierarchy changes to flat arrays; only invalidate if data changed
         m_SceneDirty = false;
         FlattenHierarchyToScene(m_SceneRoot, glm::mat4(1.0f));
+        if (m_Scene.GenerateLODs && SelectMeshLODs()) m_SceneDirty = true;
         if (m_SceneDirty) m_Renderer.InvalidateScene();
+
+        // Refit the spatial index and hierarchy bounds with whatever moved this frame
+        if (!m_MovedMeshIndices.empty() || !m_MovedProceduralIndices.empty()) {
+            m_SpatialIndex.Refit(m_Scene, m_MovedMeshIndices, m_MovedProceduralIndices);
+            SceneLoader::UpdateMovedBounds(m_Scene, m_HierarchyMapping, m_MovedMeshIndices, m_MovedProceduralIndices);
+            m_MovedMeshIndices.clear();
+            m_MovedProceduralIndices.clear();
+        }
     }
 
     void ClientLayer::OnRender()
@@ -212,16 +232,44 @@ namespace Vlkrt
                     m_Camera.GetPosition().z);
             ImGui::Text("Camera Forward: (%.2f, %.2f, %.2f)", m_Camera.GetDirection().x, m_Camera.GetDirection().y,
                     m_Camera.GetDirection().z);
+            if (!ImGui::GetIO().WantCaptureMouse) {
+                ImVec2 mouse = ImGui::GetIO().MousePos;
+                auto hit     = PickAtViewportPosition(glm::vec2(mouse.x - viewport->Pos.x, mouse.y - viewport->Pos.y));
+                if (hit) {
+                    const std::string& name = hit->Item.Type == EntityType::Mesh
+                                                      ? m_Scene.StaticMeshes[hit->Item.Index].Name
+                                                      : m_Scene.ProceduralEntities[hit->Item.Index].Name;
+                    ImGui::Text("Hovered: %s (%.2f)", name.c_str(), hit->Distance);
+                }
+            }
             ImGui::Separator();
 
             const auto& passStats = m_Renderer.GetLastPassStats();
             ImGui::Text("Resolution: %ux%u", passStats.Width, passStats.Height);
             ImGui::Text("Estimated GPU Memory: %.2f MB", passStats.EstimatedGraphicsMemoryMB);
+            ImGui::Text("Vertices: %.2f MB (%.2f MB saved by compact format)", passStats.VertexBufferMB,
+                    passStats.VertexBufferSavedMB);
+            ImGui::Text("Motion History (CPU): %.1f KB", passStats.MotionHistoryCpuKB);
+            ImGui::Text("Textures: %.1f / %.0f MB, %u resident, %u bound", passStats.TextureResidentMB,
+                    passStats.TextureBudgetMB, passStats.TexturesResident, passStats.TexturesBound);
+            if (passStats.TexturesPartial > 0) ImGui::Text("Partial textures: %u", passStats.TexturesPartial);
+            if (passStats.TexturesSkipped > 0) ImGui::Text("Over texture limit: %u", passStats.TexturesSkipped);
+            ImGui::Text("Evicted: %llu, over budget: %llu", static_cast<unsigned long long>(passStats.TexturesEvicted),
+                    static_cast<unsigned long long>(passStats.TexturesRejected));
+            ImGui::Text("Mip page-ins: %llu, page-outs: %llu",
+                    static_cast<unsigned long long>(passStats.TextureMipPageIns),
+                    static_cast<unsigned long long>(passStats.TextureMipPageOuts));
+            int textureBudgetMB = static_cast<int>(m_Renderer.GetTextureBudget() / (1024 * 1024));
+            ImGui::SetNextItemWidth(200.0f);
+            if (ImGui::SliderInt("Texture Budget (MB)", &textureBudgetMB, 64, 8192)) {
+                m_Renderer.SetTextureBudget(static_cast<uint64_t>(textureBudgetMB) * 1024 * 1024);
+            }
             ImGui::Separator();
             ImGui::Text("Last render: %.3fms", m_LastRenderTime);
             ImGui::Separator();
             ImGui::Text("Frame Total: %.3f ms", passStats.FrameTotalMs);
             ImGui::Text("Scene Setup: %.3f ms", passStats.SceneSetupMs);
+            ImGui::Text("Scene Geometry Update: %.3f ms", passStats.SceneGeometryUpdateMs);
             ImGui::Text("UBO Upload: %.3f ms", passStats.UBOUploadMs);
             ImGui::Text("RT (GPU): %.3f ms", passStats.RayTraceGpuMs);
             if (passStats.NRDEnabled) { ImGui::Text("NRD (GPU): %.3f ms", passStats.NRDGpuMs); }
@@ -248,6 +296,7 @@ namespace Vlkrt
                     ImGui::Text("Mean Abs Diff: %.6f", denoiseMetrics.RawLumaMeanAbsDiff);
                 }
             }
+            ImGuiRenderBenchmarks();
             ImGui::End();
 
             // Raytracing settings panel
@@ -442,6 +491,12 @@ namespace Vlkrt
                         m_Renderer.ResetAccumulation();
                     }
                 }
+                if (m_Scene.GenerateLODs) {
+                    ImGui::Separator();
+                    ImGui::Text("Level of Detail");
+                    ImGui::SetNextItemWidth(200.0f);
+                    ImGui::SliderFloat("LOD Pixel Error", &m_Scene.LODPixelError, 0.25f, 8.0f, "%.2f px");
+                }
                 ImGui::Separator();
 
                 // PBR Showcase: adjustable sun direction
@@ -504,9 +559,13 @@ namespace Vlkrt
         // Clear only dynamic meshes
         m_Scene.DynamicMeshes.clear();
 
+        // All player cubes are instances of one shared geometry
+        const float cubeSize = 1.0f;
+        if (!m_PlayerGeometry) m_PlayerGeometry = GeometryRegistry::GetCube(cubeSize);
+
         // Add current player as cube mesh
-        const float cubeSize     = 1.0f;
-        Mesh playerMesh          = MeshLoader::GenerateCube(cubeSize);
+        Mesh playerMesh;
+        playerMesh.Geometry      = m_PlayerGeometry;
         playerMesh.MaterialIndex = 0;
         glm::vec3 playerPos      = m_PlayerPosition + glm::vec3(0.0f, cubeSize * 0.5f, 0.0f);
         playerMesh.Transform     = glm::translate(glm::mat4(1.0f), playerPos);
@@ -517,13 +576,15 @@ namespace Vlkrt
         for (const auto& [playerID, playerData] : m_PlayerData) {
             if (playerID == m_PlayerID) continue;
 
-            Mesh otherPlayerMesh          = MeshLoader::GenerateCube(cubeSize);
+            Mesh otherPlayerMesh;
+            otherPlayerMesh.Geometry      = m_PlayerGeometry;
             otherPlayerMesh.MaterialIndex = 1;
             glm::vec3 otherPos            = playerData.Position + glm::vec3(0.0f, cubeSize * 0.5f, 0.0f);
             otherPlayerMesh.Transform     = glm::translate(glm::mat4(1.0f), otherPos);
             m_Scene.DynamicMeshes.push_back(otherPlayerMesh);
         }
         m_PlayerDataMutex.unlock();
+        m_Scene.MarkMeshesChanged();
     }
 
     void ClientLayer::RunScripts(SceneEntity& entity, float ts)
@@ -540,19 +601,53 @@ namespace Vlkrt
 
     void ClientLayer::LoadScene(const std::string& sceneName)
     {
-        auto [scene, root] = SceneLoader::LoadFromYAMLWithHierarchy(sceneName + ".yaml");
-        m_Scene            = scene;
-        m_SceneRoot        = root;
-
-        // Re-link parent pointers after copy assignment.
-        // LoadFromYAMLWithHierarchy builds pointers in a temporary hierarchy; once copied,
-        // those addresses are stale and must be rebuilt for runtime editing logic.
-        m_SceneRoot.Parent = nullptr;
-        auto relinkParents = [&](auto&& self, SceneEntity& entity, SceneEntity* parent) -> void {
-            entity.Parent = parent;
-            for (auto& child : entity.Children) self(self, child, &entity);
-        };
-        for (auto& child : m_SceneRoot.Children) relinkParents(relinkParents, child, &m_SceneRoot);
+        BeginLoadScene(sceneName);
+        PollSceneLoad(true);
+    }
+
+    void ClientLayer::BeginLoadScene(const std::string& sceneName)
+    {
+        if (m_SceneLoadJob) {
+            WL_WARN_TAG("Client", "Scene '{}' is still loading; ignoring request for '{}'",
+                    m_SceneLoadJob->GetSceneName(), sceneName);
+            return;
+        }
+
+        m_SelectedScene = sceneName;
+        m_SceneLoadJob  = std::make_unique<SceneLoadJob>(sceneName, m_Renderer.GetResidentTextureKeys());
+    }
+
+    void ClientLayer::PollSceneLoad(bool wait)
+    {
+        if (!m_SceneLoadJob || (!wait && !m_SceneLoadJob->IsReady())) return;
+
+        const std::string sceneName = m_SceneLoadJob->GetSceneName();
+        const float loadMillis      = m_SceneLoadJob->GetElapsedMillis();
+        SceneLoadJob::Result loaded = m_SceneLoadJob->TakeResult();
+        m_SceneLoadJob.reset();
+
+        if (!loaded.Success) {
+            // Keep the scene that is on screen
+            WL_ERROR_TAG("Client", "Failed to load scene '{}'", sceneName);
+            m_SelectedScene = m_CurrentScene;
+            return;
+        }
+
+        WL_INFO_TAG("Client", "Loaded scene '{}' in {} ms", sceneName, loadMillis);
+        ApplyLoadedScene(std::move(loaded), sceneName);
+    }
+
+    void ClientLayer::ApplyLoadedScene(SceneLoadJob::Result&& loaded, const std::string& sceneName)
+    {
+        // Swap the new scene in as a whole; the old one is released before its unshared geometry is collected
+        m_HierarchyMapping = HierarchyMapping{};
+        m_Scene            = std::move(loaded.LoadedScene);
+        m_SceneRoot        = std::move(loaded.Root);
+        GeometryRegistry::CollectGarbage();
+        MaterialRegistry::CollectGarbage();
+
+        // Upload before the structure rebuild so that binding the scene's textures finds them resident
+        m_Renderer.AddDecodedTextures(loaded.Textures);
 
         m_CurrentScene  = sceneName;
         m_SelectedScene = sceneName;
@@ -565,6 +660,8 @@ namespace Vlkrt
 
         m_HierarchyMapping = SceneLoader::CreateMapping(m_SceneRoot, m_Scene);
         SyncSceneToHierarchy();
+        SceneLoader::UpdateHierarchyBounds(m_SceneRoot, m_Scene, m_HierarchyMapping);
+        m_SpatialIndex.Build(m_Scene);
         m_Renderer.InvalidateSceneStructure();
         m_Renderer.ResetAccumulation();
     }
@@ -584,6 +681,9 @@ namespace Vlkrt
         // Clear hierarchy — factory scenes have no YAML hierarchy
         m_SceneRoot        = SceneEntity{};
         m_HierarchyMapping = HierarchyMapping{};
+        GeometryRegistry::CollectGarbage();
+        MaterialRegistry::CollectGarbage();
+        m_SpatialIndex.Build(m_Scene);
         m_Renderer.InvalidateSceneStructure();
         m_Renderer.ResetAccumulation();
     }
@@ -648,7 +748,7 @@ namespace Vlkrt
         SceneLoader::SaveToYAMLWithHierarchy(m_CurrentScene + ".yaml", m_Scene, m_SceneRoot);
 
         // Reload scene from file to verify save
-        LoadScene(m_CurrentScene);
+        BeginLoadScene(m_CurrentScene);
     }
 
     void ClientLayer::ImGuiRenderSceneHierarchy()
@@ -657,18 +757,35 @@ namespace Vlkrt
 
         ImGui::Text("Current Scene: %s", m_CurrentScene.c_str());
 
+        ImGui::BeginDisabled(m_SceneLoadJob != nullptr);
+
         if (ImGui::BeginCombo("##SceneSelector", m_SelectedScene.c_str())) {
             for (const auto& sceneName : m_AvailableScenes) {
-                if (ImGui::Selectable(sceneName.c_str(), m_SelectedScene == sceneName)) {
-                    m_SelectedScene = sceneName;
-                    LoadScene(sceneName);
-                }
+                if (ImGui::Selectable(sceneName.c_str(), m_SelectedScene == sceneName)) { BeginLoadScene(sceneName); }
             }
             ImGui::EndCombo();
         }
 
         if (ImGui::Button("Save Scene", ImVec2(-1, 0))) { SaveScene(); }
-        if (ImGui::Button("Reload Scene", ImVec2(-1, 0))) { LoadScene(m_CurrentScene); }
+        if (ImGui::Button("Reload Scene", ImVec2(-1, 0))) { BeginLoadScene(m_CurrentScene); }
+        ImGui::EndDisabled();
+
+        // The current scene stays live and editable until the new one is swapped in
+        if (m_SceneLoadJob) {
+            const SceneLoadProgress& progress = m_SceneLoadJob->GetProgress();
+            const double bytesParsed          = static_cast<double>(progress.BytesParsed.load());
+            const double bytesTotal           = static_cast<double>(progress.BytesTotal.load());
+            const float fraction              = bytesTotal > 0.0 ? static_cast<float>(bytesParsed / bytesTotal) : 0.0f;
+
+            ImGui::Text("Loading %s...", m_SceneLoadJob->GetSceneName().c_str());
+            ImGui::ProgressBar(fraction, ImVec2(-1, 0));
+            ImGui::Text("Parsed: %.1f / %.1f MB", bytesParsed / (1024.0 * 1024.0), bytesTotal / (1024.0 * 1024.0));
+            ImGui::Text("Meshes: %u / %u", progress.MeshesDone.load(), progress.MeshesTotal.load());
+            ImGui::Text("Textures: %u / %u", progress.TexturesDecoded.load(), progress.TexturesTotal.load());
+        }
+        if (const size_t streaming = m_Renderer.GetPendingTextureCount(); streaming > 0) {
+            ImGui::Text("Streaming textures: %zu", streaming);
+        }
 
         ImGui::Separator();
         for (auto& child : m_SceneRoot.Children) { ImGuiRenderEntity(child, glm::mat4(1.0f)); }
@@ -694,6 +811,9 @@ namespace Vlkrt
             std::string nameLabel = "Name##" + idStr;
             ImGui::InputText(nameLabel.c_str(), &entity.Name);
 
+            // Move the camera so the entity and its children fill the view
+            if (entity.Bounds.IsValid() && ImGui::Button(("Frame##" + idStr).c_str())) FrameBounds(entity.Bounds);
+
             ImGui::Separator();
 
             // Transform controls (collapsed by default)
@@ -763,6 +883,11 @@ namespace Vlkrt
     void ClientLayer::ImGuiRenderEntityProperties(SceneEntity& entity)
     {
         auto idStr = std::to_string((uintptr_t) &entity);
+        // Material edits reach the renderer through the materials' generation
+        auto materialEdited = [this]() {
+            m_Scene.MarkMaterialsChanged();
+            m_Renderer.ResetAccumulation();
+        };
 
         switch (entity.Type) {
             case EntityType::Light: {
@@ -810,57 +935,57 @@ namespace Vlkrt
                     // Disney BSDF properties
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::ColorEdit3(("Albedo##" + idStr).c_str(), glm::value_ptr(mat.Albedo)))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::ColorEdit3(("Emission##" + idStr).c_str(), glm::value_ptr(mat.Emission)))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::ColorEdit3(("Extinction##" + idStr).c_str(), glm::value_ptr(mat.Extinction)))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("Roughness##" + idStr).c_str(), &mat.Roughness, 0.0f, 1.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("Metallic##" + idStr).c_str(), &mat.Metallic, 0.0f, 1.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("Subsurface##" + idStr).c_str(), &mat.Subsurface, 0.0f, 1.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("Anisotropic##" + idStr).c_str(), &mat.Anisotropic, 0.0f, 1.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("Sheen##" + idStr).c_str(), &mat.Sheen, 0.0f, 1.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("Sheen Tint##" + idStr).c_str(), &mat.SheenTint, 0.0f, 1.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("Specular Tint##" + idStr).c_str(), &mat.SpecularTint, 0.0f, 1.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("Spec. Trans.##" + idStr).c_str(), &mat.SpecularTransmission, 0.0f, 1.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("Clearcoat##" + idStr).c_str(), &mat.Clearcoat, 0.0f, 1.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("Clearcoat Gloss##" + idStr).c_str(), &mat.ClearcoatGloss, 0.0f, 1.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("Eta##" + idStr).c_str(), &mat.Eta, 1.0f, 3.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("At Distance##" + idStr).c_str(), &mat.AtDistance, 0.01f, 10.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("Step Scale##" + idStr).c_str(), &mat.StepScale, 0.01f, 2.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
 
                     // Tiling factor
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::DragFloat(("Tiling##" + idStr).c_str(), &mat.Tiling, 0.1f, 0.01f, 100.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
 
                     ImGui::Text("Texture");
 
@@ -872,12 +997,12 @@ namespace Vlkrt
                                 mat.TextureFilename.empty() ? "(none)" : mat.TextureFilename.c_str())) {
                         if (ImGui::Selectable("(none)", mat.TextureFilename.empty())) {
                             mat.TextureFilename.clear();
-                            m_Renderer.ResetAccumulation();
+                            materialEdited();
                         }
                         for (const auto& textureName : m_AvailableTextures) {
                             if (ImGui::Selectable(textureName.c_str(), mat.TextureFilename == textureName)) {
                                 mat.TextureFilename = textureName;
-                                m_Renderer.ResetAccumulation();
+                                materialEdited();
                             }
                         }
                         ImGui::EndCombo();
@@ -889,16 +1014,19 @@ namespace Vlkrt
                         if (ImGui::Selectable(modelName.c_str(), entity.MeshData.Filename == modelName)) {
                             entity.MeshData.Filename = modelName;
 
-                            // Load new mesh data and update the flat scene mesh
-                            Mesh newMesh = MeshLoader::LoadOBJ(modelName);
-                            auto it      = m_HierarchyMapping.EntityToMeshIdx.find(&entity);
+                            // Swap the geometry of the flat scene mesh, keeping its transform and material
+                            auto it = m_HierarchyMapping.EntityToMeshIdx.find(&entity);
                             if (it != m_HierarchyMapping.EntityToMeshIdx.end()) {
                                 uint32_t meshIdx = it->second;
                                 if (meshIdx < m_Scene.StaticMeshes.size()) {
-                                    // Keep transform and material index, update geometry
-                                    newMesh.Transform             = m_Scene.StaticMeshes[meshIdx].Transform;
-                                    newMesh.MaterialIndex         = m_Scene.StaticMeshes[meshIdx].MaterialIndex;
-                                    m_Scene.StaticMeshes[meshIdx] = newMesh;
+                                    Mesh& mesh    = m_Scene.StaticMeshes[meshIdx];
+                                    mesh.Filename = modelName;
+                                    mesh.Geometry = GeometryRegistry::GetOBJ(modelName);
+                                    SceneLoader::ResolveMaterialSlots(m_Scene, mesh);
+                                    m_Scene.MarkMeshesChanged();
+                                    SceneLoader::UpdateHierarchyBounds(m_SceneRoot, m_Scene, m_HierarchyMapping);
+                                    m_SpatialIndex.Build(m_Scene);
+                                    m_Renderer.InvalidateSceneStructure();
                                 }
                             }
 
@@ -927,52 +1055,52 @@ namespace Vlkrt
 
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::ColorEdit3(("Albedo##" + idStr).c_str(), glm::value_ptr(mat.Albedo)))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::ColorEdit3(("Emission##" + idStr).c_str(), glm::value_ptr(mat.Emission)))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::ColorEdit3(("Extinction##" + idStr).c_str(), glm::value_ptr(mat.Extinction)))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("Roughness##" + idStr).c_str(), &mat.Roughness, 0.0f, 1.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("Metallic##" + idStr).c_str(), &mat.Metallic, 0.0f, 1.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("Subsurface##" + idStr).c_str(), &mat.Subsurface, 0.0f, 1.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("Anisotropic##" + idStr).c_str(), &mat.Anisotropic, 0.0f, 1.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("Sheen##" + idStr).c_str(), &mat.Sheen, 0.0f, 1.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("Sheen Tint##" + idStr).c_str(), &mat.SheenTint, 0.0f, 1.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("Specular Tint##" + idStr).c_str(), &mat.SpecularTint, 0.0f, 1.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("Spec. Trans.##" + idStr).c_str(), &mat.SpecularTransmission, 0.0f, 1.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("Clearcoat##" + idStr).c_str(), &mat.Clearcoat, 0.0f, 1.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("Clearcoat Gloss##" + idStr).c_str(), &mat.ClearcoatGloss, 0.0f, 1.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("Eta##" + idStr).c_str(), &mat.Eta, 1.0f, 3.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("At Distance##" + idStr).c_str(), &mat.AtDistance, 0.01f, 10.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::SliderFloat(("Step Scale##" + idStr).c_str(), &mat.StepScale, 0.01f, 2.0f))
-                        m_Renderer.ResetAccumulation();
+                        materialEdited();
                 }
 
                 if (ImGui::Checkbox(("Analytic##" + idStr).c_str(), &entity.ProceduralData.IsAnalytic))
@@ -1018,6 +1146,37 @@ namespace Vlkrt
         }
     }
 
+    void ClientLayer::FrameBounds(const AABB& bounds)
+    {
+        // Back off along the current view direction until the bounding sphere fits the vertical field of view
+        glm::vec3 center = bounds.GetCenter();
+        float radius     = std::max(glm::length(bounds.GetExtent()) * 0.5f, 0.01f);
+        float distance   = radius / std::sin(glm::radians(m_Camera.GetFOV()) * 0.5f);
+
+        m_Camera.SetPosition(center - m_Camera.GetDirection() * distance);
+        m_Camera.SetTarget(center);
+        m_Renderer.ResetAccumulation();
+    }
+
+    auto ClientLayer::SelectMeshLODs() -> bool
+    {
+        if (m_ViewportHeight == 0) return false;
+
+        // Pixels covered by one world unit at distance 1: half the viewport height over tan(fov / 2)
+        const float pixelsPerUnit = 0.5f * static_cast<float>(m_ViewportHeight) * m_Camera.GetProjection()[1][1];
+        bool changed              = false;
+        for (auto& mesh : m_Scene.StaticMeshes) {
+            const uint32_t lod
+                    = MeshSimplifier::SelectLOD(mesh, m_Camera.GetPosition(), pixelsPerUnit, m_Scene.LODPixelError);
+            if (lod != mesh.LODIndex) {
+                mesh.LODIndex = lod;
+                changed       = true;
+            }
+        }
+        if (changed) m_Scene.MarkMeshesChanged();
+        return changed;
+    }
+
     void ClientLayer::FlattenHierarchyToScene(const SceneEntity& entity, const glm::mat4& parentWorld)
     {
         auto nearlyEqual     = [](float a, float b, float eps = 1e-5f) { return std::abs(a - b) <= eps; };
@@ -1058,7 +1217,9 @@ namespace Vlkrt
                             mesh.Transform     = worldTransform;
                             mesh.MaterialIndex = entity.MeshData.MaterialIndex;
                             m_SceneDirty       = true;
+                            m_Scene.MarkMeshesChanged();
                             m_Renderer.MarkDirtyMeshes({ meshIdx });
+                            m_MovedMeshIndices.push_back(meshIdx);
                         }
                     }
                 }
@@ -1085,6 +1246,7 @@ namespace Vlkrt
                         light.Position  = newPos;
                         light.Direction = newDir;
                         m_SceneDirty    = true;
+                        m_Scene.MarkLightsChanged();
                         m_Renderer.MarkDirtyLights({ lightIdx });
                     }
                 }
@@ -1107,7 +1269,9 @@ namespace Vlkrt
                         pe.IsAnalytic    = entity.ProceduralData.IsAnalytic;
                         pe.PrimitiveType = entity.ProceduralData.PrimitiveType;
                         m_SceneDirty     = true;
+                        m_Scene.MarkProceduralsChanged();
                         m_Renderer.MarkDirtyMeshes({ procIdx });
+                        m_MovedProceduralIndices.push_back(procIdx);
                         if (structureChanged) m_Renderer.InvalidateSceneStructure();
                     }
                 }
@@ -1119,6 +1283,41 @@ namespace Vlkrt
         for (const auto& child : entity.Children) { FlattenHierarchyToScene(child, worldTransform); }
     }
 
+    auto ClientLayer::PickAtViewportPosition(const glm::vec2& position) const -> std::optional<SpatialRayHit>
+    {
+        if (m_ViewportWidth == 0 || m_ViewportHeight == 0) return std::nullopt;
+
+        // Same camera ray construction as GenerateCameraRay in the shaders (unjittered)
+        glm::vec2 ndc = position / glm::vec2((float) m_ViewportWidth, (float) m_ViewportHeight) * 2.0f - 1.0f;
+        ndc.y         = -ndc.y;
+
+        glm::mat4 clipToWorld = glm::inverse(m_Camera.GetProjection() * m_Camera.GetView());
+        glm::vec4 world       = clipToWorld * glm::vec4(ndc, 0.0f, 1.0f);
+        glm::vec3 origin      = m_Camera.GetPosition();
+        glm::vec3 direction   = glm::normalize(glm::vec3(world) / world.w - origin);
+
+        return m_SpatialIndex.Raycast(origin, direction);
+    }
+
+    void ClientLayer::ImGuiRenderBenchmarks()
+    {
+        if (!ImGui::CollapsingHeader("Benchmarks")) return;
+
+        if (ImGui::Button("Spatial Index")) m_BenchmarkReport = Benchmarks::RunSceneBVH(m_Scene);
+        ImGui::SameLine();
+        if (ImGui::Button("Scene Load")) m_BenchmarkReport = Benchmarks::RunSceneLoad(m_CurrentScene + ".yaml");
+        ImGui::SameLine();
+        if (ImGui::Button("glTF Decode")) m_BenchmarkReport = Benchmarks::RunGLTFDecode(m_Scene);
+        ImGui::SameLine();
+        if (ImGui::Button("Mesh Optimize")) m_BenchmarkReport = Benchmarks::RunMeshOptimization(m_Scene);
+        if (ImGui::Button("Meshlets")) m_BenchmarkReport = Benchmarks::RunMeshlets(m_Scene, m_Camera.GetPosition());
+        ImGui::SameLine();
+        if (ImGui::Button("Instance Update")) m_BenchmarkReport = Benchmarks::RunInstanceUpdate(m_Scene);
+        ImGui::SameLine();
+        if (ImGui::Button("Vertex Packing")) m_BenchmarkReport = Benchmarks::RunVertexPacking(m_Scene);
+        if (!m_BenchmarkReport.empty()) ImGui::TextUnformatted(m_BenchmarkReport.c_str());
+    }
+
     void ClientLayer::ImGuiRenderChatPanel()
     {
         if (ImGui::Begin("Chat", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
@@ -7,8 +7,10 @@
 #include "Camera.h"
 #include "Scene.h"
 #include "SceneLoader.h"
+#include "SceneLoadJob.h"
 #include "MeshLoader.h"
 #include "SceneFactory.h"
+#include "SceneBVH.h"
 #include "UserInfo.h"
 
 #include <mutex>
@@ -17,6 +19,8 @@
 #include <vector>
 #include <string>
 #include <deque>
+#include <memory>
+#include <optional>
 
 namespace Vlkrt
 {
@@ -48,7 +52,11 @@ namespace Vlkrt
         void OnDataReceived(const Walnut::Buffer& buffer);
         void UpdateScene();
         void RunScripts(SceneEntity& entity, float ts);
-        void LoadScene(const std::string& scenePath);
+        // Blocks until the scene is loaded; BeginLoadScene loads in the background and PollSceneLoad swaps it in.
+        void LoadScene(const std::string& sceneName);
+        void BeginLoadScene(const std::string& sceneName);
+        void PollSceneLoad(bool wait);
+        void ApplyLoadedScene(SceneLoadJob::Result&& loaded, const std::string& sceneName);
         void SyncSceneToHierarchy();
         void SaveScene();
 
@@ -61,6 +69,11 @@ namespace Vlkrt
         void ImGuiRenderTransformControls(Transform& localTransform, const std::string& id);
         void ImGuiRenderEntityProperties(SceneEntity& entity);
         void FlattenHierarchyToScene(const SceneEntity& entity, const glm::mat4& parentWorld);
+        // Picks each mesh's level of detail from its projected size; true if any mesh switched.
+        auto SelectMeshLODs() -> bool;
+        void FrameBounds(const AABB& bounds);
+        void ImGuiRenderBenchmarks();
+        auto PickAtViewportPosition(const glm::vec2& position) const -> std::optional<SpatialRayHit>;
 
         // Chat UI functions
         void ImGuiRenderChatPanel();
@@ -102,12 +115,21 @@ namespace Vlkrt
         // Scene management
         std::string m_CurrentScene{ "default" };
         std::string m_SelectedScene{ "default" };
+        std::unique_ptr<SceneLoadJob> m_SceneLoadJob;  // In-flight background load, if any
 
         // Hierarchical scene data
         SceneEntity m_SceneRoot;
         SceneHierarchy m_SceneHierarchy;
         HierarchyMapping m_HierarchyMapping;
 
+        // CPU spatial index over static meshes and procedurals, refit from the indices touched each frame
+        SceneBVH m_SpatialIndex;
+        std::vector<uint32_t> m_MovedMeshIndices;
+        std::vector<uint32_t> m_MovedProceduralIndices;
+
+        // Shared geometry instanced by every player cube
+        std::shared_ptr<const MeshGeometry> m_PlayerGeometry;
+
         // Scene change tracking
         glm::vec3 m_LastPlayerPosition{};
         size_t m_LastPlayerCount{ 0 };
@@ -118,5 +140,8 @@ namespace Vlkrt
         std::vector<std::string> m_AvailableModels;
         std::vector<std::string> m_AvailableScenes;
         std::vector<std::string> m_AvailableScripts;
+
+        // Last benchmark report shown in the Stats panel
+        std::string m_BenchmarkReport;
     };
 }  // namespace Vlkrt
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "GPUTexture.h"
+#include "VulkanUtils.h"
+
+#include "Walnut/Application.h"
+
+#include <stdexcept>
+
+namespace Vlkrt
+{
+    GPUTexture::GPUTexture(uint32_t width, uint32_t height, TextureFormat format, uint32_t mipCount)
+        : m_Device(Walnut::Application::GetDevice()), m_Width(width), m_Height(height), m_MipCount(mipCount),
+          m_Format(format)
+    {
+        VkImageCreateInfo imageInfo = { VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+        imageInfo.imageType         = VK_IMAGE_TYPE_2D;
+        imageInfo.format            = GetVkFormat(format);
+        imageInfo.extent            = { width, height, 1 };
+        imageInfo.mipLevels         = mipCount;
+        imageInfo.arrayLayers       = 1;
+        imageInfo.samples           = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling            = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage             = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        imageInfo.sharingMode       = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout     = VK_IMAGE_LAYOUT_UNDEFINED;
+        if (vkCreateImage(m_Device, &imageInfo, nullptr, &m_Image) != VK_SUCCESS) {
+            throw std::runtime_error("vkCreateImage failed in GPUTexture::GPUTexture");
+        }
+
+        VkMemoryRequirements memRequirements;
+        vkGetImageMemoryRequirements(m_Device, m_Image, &memRequirements);
+
+        VkMemoryAllocateInfo allocInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+        allocInfo.allocationSize       = memRequirements.size;
+        allocInfo.memoryTypeIndex
+                = FindMemoryTypeIndex(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        if (allocInfo.memoryTypeIndex == UINT32_MAX
+                || vkAllocateMemory(m_Device, &allocInfo, nullptr, &m_Memory) != VK_SUCCESS
+                || vkBindImageMemory(m_Device, m_Image, m_Memory, 0) != VK_SUCCESS) {
+            Release();
+            throw std::runtime_error("Failed to allocate image memory in GPUTexture::GPUTexture");
+        }
+        m_SizeBytes = memRequirements.size;
+
+        VkImageViewCreateInfo viewInfo           = { VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO };
+        viewInfo.image                           = m_Image;
+        viewInfo.viewType                        = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format                          = imageInfo.format;
+        viewInfo.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        viewInfo.subresourceRange.baseMipLevel   = 0;
+        viewInfo.subresourceRange.levelCount     = mipCount;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount     = 1;
+        if (vkCreateImageView(m_Device, &viewInfo, nullptr, &m_ImageView) != VK_SUCCESS) {
+            Release();
+            throw std::runtime_error("vkCreateImageView failed in GPUTexture::GPUTexture");
+        }
+
+        // Material textures tile, and the shaders pick the mip level themselves (ray cones)
+        VkSamplerCreateInfo samplerInfo = { VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO };
+        samplerInfo.magFilter           = VK_FILTER_LINEAR;
+        samplerInfo.minFilter           = VK_FILTER_LINEAR;
+        samplerInfo.mipmapMode          = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+        samplerInfo.addressModeU        = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+        samplerInfo.addressModeV        = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+        samplerInfo.addressModeW        = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+        samplerInfo.minLod              = 0.0f;
+        samplerInfo.maxLod              = static_cast<float>(mipCount);
+        if (vkCreateSampler(m_Device, &samplerInfo, nullptr, &m_Sampler) != VK_SUCCESS) {
+            Release();
+            throw std::runtime_error("vkCreateSampler failed in GPUTexture::GPUTexture");
+        }
+    }
+
+    GPUTexture::~GPUTexture() { Release(); }
+
+    auto GPUTexture::GetVkFormat(TextureFormat format) -> VkFormat
+    {
+        // UNORM like the RGBA8 textures before baking; the shaders treat texture values as stored
+        switch (format) {
+            case TextureFormat::BC1: return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+            case TextureFormat::BC3: return VK_FORMAT_BC3_UNORM_BLOCK;
+            case TextureFormat::BC5: return VK_FORMAT_BC5_UNORM_BLOCK;
+            case TextureFormat::BC7: return VK_FORMAT_BC7_UNORM_BLOCK;
+            case TextureFormat::RGBA8:
+            default: return VK_FORMAT_R8G8B8A8_UNORM;
+        }
+    }
+
+    void GPUTexture::Release()
+    {
+        if (m_Image == VK_NULL_HANDLE && m_Memory == VK_NULL_HANDLE) return;
+
+        Walnut::Application::SubmitResourceFree(
+                [device = m_Device, image = m_Image, memory = m_Memory, view = m_ImageView, sampler = m_Sampler]() {
+                    if (sampler) vkDestroySampler(device, sampler, nullptr);
+                    if (view) vkDestroyImageView(device, view, nullptr);
+                    if (image) vkDestroyImage(device, image, nullptr);
+                    if (memory) vkFreeMemory(device, memory, nullptr);
+                });
+        m_Image     = VK_NULL_HANDLE;
+        m_Memory    = VK_NULL_HANDLE;
+        m_ImageView = VK_NULL_HANDLE;
+        m_Sampler   = VK_NULL_HANDLE;
+    }
+}  // namespace Vlkrt
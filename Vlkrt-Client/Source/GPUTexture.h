@@ -0,0 +1,55 @@
+#pragma once
+
+#include "TextureLoader.h"
+
+#include <cstdint>
+
+#include <vulkan/vulkan.h>
+
+namespace Vlkrt
+{
+    /// <summary>
+    /// Sampled texture on the GPU with a full mip chain, in any TextureFormat. Unlike Walnut::Image it supports block
+    /// compression and mips, and it is never written by shaders. The pixels are uploaded by TextureStreamer; a new
+    /// texture is in VK_IMAGE_LAYOUT_UNDEFINED.
+    /// </summary>
+    class GPUTexture
+    {
+    public:
+        // Throws std::runtime_error if the image cannot be created
+        GPUTexture(uint32_t width, uint32_t height, TextureFormat format, uint32_t mipCount);
+        // Destruction is deferred until the frames in flight that may sample the texture are done
+        ~GPUTexture();
+
+        GPUTexture(const GPUTexture&)            = delete;
+        GPUTexture& operator=(const GPUTexture&) = delete;
+
+        static auto GetVkFormat(TextureFormat format) -> VkFormat;
+
+        auto GetWidth() const -> uint32_t { return m_Width; }
+        auto GetHeight() const -> uint32_t { return m_Height; }
+        auto GetMipCount() const -> uint32_t { return m_MipCount; }
+        auto GetFormat() const -> TextureFormat { return m_Format; }
+        auto GetSizeBytes() const -> uint64_t { return m_SizeBytes; }  // Device memory the image occupies
+
+        auto GetVkImage() const -> VkImage { return m_Image; }
+        auto GetVkImageView() const -> VkImageView { return m_ImageView; }
+        auto GetVkSampler() const -> VkSampler { return m_Sampler; }
+
+    private:
+        void Release();
+
+    private:
+        VkDevice m_Device{ VK_NULL_HANDLE };
+        VkImage m_Image{ VK_NULL_HANDLE };
+        VkDeviceMemory m_Memory{ VK_NULL_HANDLE };
+        VkImageView m_ImageView{ VK_NULL_HANDLE };
+        VkSampler m_Sampler{ VK_NULL_HANDLE };
+
+        uint32_t m_Width{ 0 };
+        uint32_t m_Height{ 0 };
+        uint32_t m_MipCount{ 0 };
+        TextureFormat m_Format{ TextureFormat::RGBA8 };
+        uint64_t m_SizeBytes{ 0 };
+    };
+}  // namespace Vlkrt
@@ -0,0 +1,156 @@
+#include "GeometryRegistry.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "Utils.h"
+
+#include <cstdio>
+#include <string>
+#include <unordered_set>
+
+namespace Vlkrt
+{
+    namespace
+    {
+        // Unused assets of each kind kept resident for reuse by the next scene
+        constexpr uint64_t kRetainedBytes = 256ull * 1024 * 1024;
+
+        static auto GeometryBytes(const MeshGeometry& geometry) -> uint64_t
+        {
+            uint64_t bytes = geometry.Vertices.size() * sizeof(Vertex)
+                             + (geometry.Indices.size() + geometry.TriangleMaterials.size()) * sizeof(uint32_t);
+            for (const auto& lod : geometry.LODs) {
+                bytes += (lod.Indices.size() + lod.TriangleMaterials.size()) * sizeof(uint32_t);
+            }
+            return bytes;
+        }
+
+        static auto HashGeometry(const MeshGeometry& geometry) -> uint64_t
+        {
+            uint64_t hash = kFNVOffsetBasis;
+            hash          = HashBytes(hash, geometry.Vertices.data(), geometry.Vertices.size() * sizeof(Vertex));
+            hash          = HashBytes(hash, geometry.Indices.data(), geometry.Indices.size() * sizeof(uint32_t));
+            hash          = HashBytes(
+                    hash, geometry.TriangleMaterials.data(), geometry.TriangleMaterials.size() * sizeof(uint32_t));
+            for (const auto& name : geometry.MaterialNames) hash = HashBytes(hash, name.c_str(), name.size() + 1);
+            return hash;
+        }
+    }  // namespace
+
+    std::mutex GeometryRegistry::s_Mutex;
+    ResourcePool<const MeshGeometry> GeometryRegistry::s_Geometry;
+    ResourcePool<const LoadedGLTFScene> GeometryRegistry::s_GLTFScenes;
+
+    auto GeometryRegistry::GetOrCreate(const std::string& key, const GeometryFactory& factory)
+            -> std::shared_ptr<const MeshGeometry>
+    {
+        {
+            std::scoped_lock lock(s_Mutex);
+            if (auto geometry = s_Geometry.Get(s_Geometry.Find(key))) return geometry;
+        }
+
+        // Build outside the lock so that loading one asset does not block lookups of others
+        auto geometry = factory();
+        if (!geometry) geometry = std::make_shared<const MeshGeometry>();
+
+        std::scoped_lock lock(s_Mutex);
+        if (auto existing = s_Geometry.Get(s_Geometry.Find(key))) return existing;  // Another thread published it first
+        s_Geometry.Insert(key, geometry, GeometryBytes(*geometry));
+        return geometry;
+    }
+
+    auto GeometryRegistry::GetOBJ(const std::string& filename) -> std::shared_ptr<const MeshGeometry>
+    {
+        return GetOrCreate("obj:" + filename, [&] { return MeshLoader::LoadOBJ(filename).Geometry; });
+    }
+
+    auto GeometryRegistry::GetCube(float size) -> std::shared_ptr<const MeshGeometry>
+    {
+        return GetOrCreate(
+                "builtin:cube:" + std::to_string(size), [&] { return MeshLoader::GenerateCube(size).Geometry; });
+    }
+
+    auto GeometryRegistry::GetQuad(float size) -> std::shared_ptr<const MeshGeometry>
+    {
+        return GetOrCreate(
+                "builtin:quad:" + std::to_string(size), [&] { return MeshLoader::GenerateQuad(size).Geometry; });
+    }
+
+    auto GeometryRegistry::GetGLTF(const std::string& filename) -> std::shared_ptr<const LoadedGLTFScene>
+    {
+        const std::string key = "gltf:" + filename;
+        {
+            std::scoped_lock lock(s_Mutex);
+            if (auto scene = s_GLTFScenes.Get(s_GLTFScenes.Find(key))) return scene;
+        }
+
+        auto scene = std::make_shared<const LoadedGLTFScene>(MeshLoader::LoadGLTF(filename));
+
+        // Sized by the geometry it keeps alive, so that retaining an import is weighed like retaining its primitives
+        uint64_t bytes = scene->Materials.size() * sizeof(Material);
+        std::unordered_set<const MeshGeometry*> counted;
+        for (const auto& mesh : scene->Meshes) {
+            bytes += sizeof(Mesh);
+            if (mesh.Geometry && counted.insert(mesh.Geometry.get()).second) bytes += GeometryBytes(*mesh.Geometry);
+        }
+
+        std::scoped_lock lock(s_Mutex);
+        if (auto existing = s_GLTFScenes.Get(s_GLTFScenes.Find(key))) return existing;
+        s_GLTFScenes.Insert(key, scene, bytes);
+        return scene;
+    }
+
+    auto GeometryRegistry::GetOptimized(const std::shared_ptr<const MeshGeometry>& source, bool spatialSort)
+            -> std::shared_ptr<const MeshGeometry>
+    {
+        if (!source || source->Indices.empty()) return source;
+
+        char key[64];
+        std::snprintf(key, sizeof(key), "optimized:%s:%016llx:%zu", spatialSort ? "spatial" : "cache",
+                static_cast<unsigned long long>(HashGeometry(*source)), source->Vertices.size());
+        return GetOrCreate(key, [&] {
+            return std::make_shared<const MeshGeometry>(MeshOptimizer::Optimize(*source, spatialSort));
+        });
+    }
+
+    auto GeometryRegistry::GetWithLODs(const std::shared_ptr<const MeshGeometry>& source, uint32_t levels)
+            -> std::shared_ptr<const MeshGeometry>
+    {
+        if (!source || source->Indices.size() / 3 < MeshSimplifier::kMinTriangles || levels == 0) return source;
+
+        char key[64];
+        std::snprintf(key, sizeof(key), "lod:%u:%016llx:%zu", levels,
+                static_cast<unsigned long long>(HashGeometry(*source)), source->Vertices.size());
+        return GetOrCreate(key, [&] {
+            auto geometry  = std::make_shared<MeshGeometry>(*source);
+            geometry->LODs = MeshSimplifier::GenerateLODs(*source, levels);
+            return std::shared_ptr<const MeshGeometry>(std::move(geometry));
+        });
+    }
+
+    void GeometryRegistry::CollectGarbage()
+    {
+        std::scoped_lock lock(s_Mutex);
+        // Cached glTF imports hold their primitives, so they go first to let that geometry become unreferenced
+        s_GLTFScenes.EvictUnreferenced(kRetainedBytes);
+        s_Geometry.EvictUnreferenced(kRetainedBytes);
+    }
+
+    void GeometryRegistry::EvictUnused()
+    {
+        std::scoped_lock lock(s_Mutex);
+        s_GLTFScenes.EvictUnreferenced(0);
+        s_Geometry.EvictUnreferenced(0);
+    }
+
+    auto GeometryRegistry::GetLiveGeometryCount() -> size_t
+    {
+        std::scoped_lock lock(s_Mutex);
+        return s_Geometry.GetReferencedCount();
+    }
+
+    auto GeometryRegistry::GetResidentGeometryBytes() -> uint64_t
+    {
+        std::scoped_lock lock(s_Mutex);
+        return s_Geometry.GetResidentBytes();
+    }
+}  // namespace Vlkrt
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Scene.h"
+#include "MeshLoader.h"
+#include "ResourcePool.h"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace Vlkrt
+{
+    /// <summary>
+    /// Process-wide registry of immutable imported assets: mesh geometry and whole glTF imports, keyed by asset name.
+    /// Every request for the same key returns the same shared data instead of loading a new copy. Assets no longer
+    /// used by any mesh stay resident until CollectGarbage trims them to a byte budget, so switching back to a scene
+    /// reuses them instead of reloading from disk.
+    /// </summary>
+    class GeometryRegistry
+    {
+    public:
+        using GeometryFactory = std::function<std::shared_ptr<const MeshGeometry>()>;
+
+        static auto GetOrCreate(const std::string& key, const GeometryFactory& factory)
+                -> std::shared_ptr<const MeshGeometry>;
+
+        static auto GetOBJ(const std::string& filename) -> std::shared_ptr<const MeshGeometry>;
+        static auto GetCube(float size) -> std::shared_ptr<const MeshGeometry>;
+        static auto GetQuad(float size) -> std::shared_ptr<const MeshGeometry>;
+        // Meshes (with transforms relative to the file's root) and materials of a glTF file, imported once.
+        static auto GetGLTF(const std::string& filename) -> std::shared_ptr<const LoadedGLTFScene>;
+        // MeshOptimizer output for source, keyed by its content so that shared geometry is optimized once.
+        static auto GetOptimized(const std::shared_ptr<const MeshGeometry>& source, bool spatialSort)
+                -> std::shared_ptr<const MeshGeometry>;
+        // Copy of source with a MeshSimplifier LOD chain of up to levels entries, keyed like GetOptimized.
+        static auto GetWithLODs(const std::shared_ptr<const MeshGeometry>& source, uint32_t levels)
+                -> std::shared_ptr<const MeshGeometry>;
+
+        // Evicts unused assets, least recently used first, until the unused ones fit in the retention budget.
+        static void CollectGarbage();
+        // Evicts every unused asset regardless of the budget. Geometry a live scene still holds stays resident.
+        static void EvictUnused();
+        static auto GetLiveGeometryCount() -> size_t;
+        static auto GetResidentGeometryBytes() -> uint64_t;
+
+    private:
+        static std::mutex s_Mutex;
+        static ResourcePool<const MeshGeometry> s_Geometry;
+        static ResourcePool<const LoadedGLTFScene> s_GLTFScenes;
+    };
+}  // namespace Vlkrt
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace Vlkrt
+{
+    /// <summary>
+    /// Read-only memory mapping of a whole file. The view stays valid until the object is closed or destroyed.
+    /// Move-only.
+    /// </summary>
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        explicit MappedFile(const std::filesystem::path& path) { Open(path); }
+        ~MappedFile() { Close(); }
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        MappedFile(const MappedFile&)            = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        auto Open(const std::filesystem::path& path) -> bool;
+        void Close();
+
+        auto IsOpen() const -> bool { return m_Data != nullptr; }
+        auto GetData() const -> const uint8_t* { return m_Data; }
+        auto GetSize() const -> size_t { return m_Size; }
+
+    private:
+        const uint8_t* m_Data{ nullptr };
+        size_t m_Size{ 0 };
+#ifdef WL_PLATFORM_WINDOWS
+        void* m_FileHandle{ nullptr };
+        void* m_MappingHandle{ nullptr };
+#else
+        int m_FileDescriptor{ -1 };
+#endif
+    };
+}  // namespace Vlkrt
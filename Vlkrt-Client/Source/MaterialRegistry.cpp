@@ -0,0 +1,115 @@
+#include "MaterialRegistry.h"
+
+#include <type_traits>
+
+namespace Vlkrt
+{
+    namespace
+    {
+        // Unused definitions kept resident for reuse by the next scene
+        constexpr uint64_t kRetainedBytes = 1024 * 1024;
+
+        // Everything that affects shading, so equal keys mean interchangeable materials. Name and the authoring
+        // MaterialIndex are left out.
+        static auto MaterialKey(const Material& material) -> std::string
+        {
+            std::string key;
+            auto appendValue = [&](const auto& value) {
+                static_assert(std::is_trivially_copyable_v<std::decay_t<decltype(value)>>);
+                key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+            };
+            auto appendString = [&](const std::string& value) {
+                appendValue(static_cast<uint32_t>(value.size()));
+                key += value;
+            };
+
+            appendValue(material.Albedo);
+            appendValue(material.Emission);
+            appendValue(material.Extinction);
+            appendValue(material.AtDistance);
+            appendValue(material.Roughness);
+            appendValue(material.Metallic);
+            appendValue(material.Subsurface);
+            appendValue(material.Anisotropic);
+            appendValue(material.Sheen);
+            appendValue(material.SheenTint);
+            appendValue(material.Clearcoat);
+            appendValue(material.ClearcoatGloss);
+            appendValue(material.SpecularTint);
+            appendValue(material.SpecularTransmission);
+            appendValue(material.Eta);
+            appendValue(material.StepScale);
+            appendValue(material.LightIndex);
+            appendValue(material.Tiling);
+            appendString(material.TextureFilename);
+            appendString(material.TextureAlbedoFilename);
+            appendString(material.TextureNormalFilename);
+            appendString(material.TextureMetallicRoughnessFilename);
+            appendString(material.TextureEmissiveFilename);
+            appendString(material.TextureOcclusionFilename);
+            return key;
+        }
+    }  // namespace
+
+    std::mutex MaterialRegistry::s_Mutex;
+    ResourcePool<const Material> MaterialRegistry::s_Materials;
+
+    auto MaterialRegistry::Intern(const Material& material) -> std::shared_ptr<const Material>
+    {
+        const std::string key = MaterialKey(material);
+
+        std::scoped_lock lock(s_Mutex);
+        if (auto existing = s_Materials.Get(s_Materials.Find(key))) return existing;
+
+        auto interned = std::make_shared<const Material>(material);
+        s_Materials.Insert(key, interned, sizeof(Material) + key.size());
+        return interned;
+    }
+
+    auto MaterialRegistry::Find(const Material& material) -> MaterialHandle
+    {
+        const std::string key = MaterialKey(material);
+        std::scoped_lock lock(s_Mutex);
+        return s_Materials.Find(key);
+    }
+
+    auto MaterialRegistry::Get(MaterialHandle handle) -> std::shared_ptr<const Material>
+    {
+        std::scoped_lock lock(s_Mutex);
+        return s_Materials.Get(handle);
+    }
+
+    auto MaterialRegistry::AddToScene(Scene& scene, const Material& material, bool reuseIdentical) -> uint32_t
+    {
+        auto interned = Intern(material);
+        if (reuseIdentical) {
+            for (size_t i = 0; i < scene.MaterialSources.size(); ++i) {
+                if (scene.MaterialSources[i] == interned) return static_cast<uint32_t>(i);
+            }
+        }
+
+        // Scenes whose earlier materials were added directly have no sources for them
+        scene.MaterialSources.resize(scene.Materials.size());
+        scene.Materials.push_back(material);
+        scene.MaterialSources.push_back(std::move(interned));
+        return static_cast<uint32_t>(scene.Materials.size() - 1);
+    }
+
+    void MaterialRegistry::CollectGarbage()
+    {
+        std::scoped_lock lock(s_Mutex);
+        s_Materials.EvictUnreferenced(kRetainedBytes);
+    }
+
+    auto MaterialRegistry::GetLiveMaterialCount() -> size_t
+    {
+        std::scoped_lock lock(s_Mutex);
+        return s_Materials.GetReferencedCount();
+    }
+
+    auto MaterialRegistry::GetResidentMaterialCount() -> size_t
+    {
+        std::scoped_lock lock(s_Mutex);
+        return s_Materials.GetResidentCount();
+    }
+}  // namespace Vlkrt
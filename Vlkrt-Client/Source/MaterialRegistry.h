@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Scene.h"
+#include "ResourcePool.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace Vlkrt
+{
+    using MaterialHandle = ResourceHandle<const Material>;
+
+    /// <summary>
+    /// Process-wide, deduplicated store of material definitions. Materials that shade the same (same parameters and
+    /// textures, whatever their names) are interned to one shared definition, referenced by every scene built from it
+    /// through Scene::MaterialSources. Definitions no scene references stay resident until CollectGarbage trims them,
+    /// so reloading a scene reuses them. Scene::Materials remains the per-scene table the shaders and editor index.
+    /// </summary>
+    class MaterialRegistry
+    {
+    public:
+        static auto Intern(const Material& material) -> std::shared_ptr<const Material>;
+        static auto Find(const Material& material) -> MaterialHandle;
+        static auto Get(MaterialHandle handle) -> std::shared_ptr<const Material>;
+
+        // Appends material to scene, interned; with reuseIdentical, returns the index of a scene material interned
+        // to the same definition instead of appending a duplicate.
+        static auto AddToScene(Scene& scene, const Material& material, bool reuseIdentical = false) -> uint32_t;
+
+        // Evicts unreferenced definitions, least recently used first, until they fit in the retention budget.
+        static void CollectGarbage();
+        static auto GetLiveMaterialCount() -> size_t;
+        static auto GetResidentMaterialCount() -> size_t;
+
+    private:
+        static std::mutex s_Mutex;
+        static ResourcePool<const Material> s_Materials;
+    };
+}  // namespace Vlkrt
@@ -1,17 +1,25 @@
 #include "MeshLoader.h"
+#include "GeometryRegistry.h"
+#include "ObjParser.h"
+#include "ThreadPool.h"
 #include "Utils.h"
 
 #include "Walnut/Core/Log.h"
+#include "Walnut/Timer.h"
 
 #include <algorithm>
+#include <cmath>
 #include <filesystem>
 #include <glm/gtc/matrix_transform.hpp>
 #include <functional>
+#include <cstddef>
 #include <cstring>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
-#include "tiny_obj_loader.h"
-
 #define TINYGLTF_IMPLEMENTATION
 #define TINYGLTF_NO_INCLUDE_STB_IMAGE
 #define TINYGLTF_NO_STB_IMAGE_WRITE
@@ -47,136 +55,222 @@ namespace Vlkrt
             return absoluteTexturePath.lexically_normal().generic_string();
         }
 
-        static auto ReadAccessorUInt(const tinygltf::Model& model, const tinygltf::Accessor& accessor, size_t index)
-                -> uint32_t
+        // OBJ corner identity: position, normal and texcoord indices (-1 when absent)
+        struct ObjVertexKey
+        {
+            int Position;
+            int Normal;
+            int TexCoord;
+
+            auto operator==(const ObjVertexKey& other) const -> bool = default;
+        };
+
+        struct ObjVertexKeyHash
+        {
+            auto operator()(const ObjVertexKey& key) const -> size_t
+            {
+                uint64_t h = static_cast<uint32_t>(key.Position);
+                h          = h * 0x9E3779B97F4A7C15ull ^ static_cast<uint32_t>(key.Normal);
+                h          = h * 0x9E3779B97F4A7C15ull ^ static_cast<uint32_t>(key.TexCoord);
+                return static_cast<size_t>(h ^ (h >> 32));
+            }
+        };
+
+        // An accessor resolved once to its first element and byte stride, so attributes decode in one strided pass
+        struct AccessorStream
+        {
+            const uint8_t* Data{ nullptr };
+            size_t Count{ 0 };
+            size_t Stride{ 0 };
+            int ComponentType{ -1 };
+            int ComponentCount{ 0 };
+            bool Normalized{ false };
+        };
+
+        static auto ResolveAccessor(const tinygltf::Model& model, const tinygltf::Accessor& accessor) -> AccessorStream
+        {
+            if (accessor.sparse.isSparse) {
+                WL_WARN_TAG("MeshLoader", "Sparse glTF accessor '{}' is not supported", accessor.name);
+                return {};
+            }
+            if (accessor.bufferView < 0 || accessor.bufferView >= (int) model.bufferViews.size()) return {};
+
+            const auto& view = model.bufferViews[accessor.bufferView];
+            if (view.buffer < 0 || view.buffer >= (int) model.buffers.size()) return {};
+
+            const auto& buffer       = model.buffers[view.buffer];
+            const int componentSize  = tinygltf::GetComponentSizeInBytes(accessor.componentType);
+            const int componentCount = tinygltf::GetNumComponentsInType(accessor.type);
+            const int stride         = accessor.ByteStride(view);  // Element size when the view is tightly packed
+            if (componentSize <= 0 || componentCount <= 0 || stride <= 0) return {};
+
+            // Validate the whole range once so the decode loops need no bounds checks
+            const size_t offset      = view.byteOffset + accessor.byteOffset;
+            const size_t elementSize = static_cast<size_t>(componentSize) * componentCount;
+            if (accessor.count > 0 && offset + (accessor.count - 1) * stride + elementSize > buffer.data.size()) {
+                WL_WARN_TAG("MeshLoader", "glTF accessor '{}' runs past the end of its buffer", accessor.name);
+                return {};
+            }
+
+            AccessorStream stream;
+            stream.Data           = buffer.data.data() + offset;
+            stream.Count          = accessor.count;
+            stream.Stride         = static_cast<size_t>(stride);
+            stream.ComponentType  = accessor.componentType;
+            stream.ComponentCount = componentCount;
+            stream.Normalized     = accessor.normalized;
+            return stream;
+        }
+
+        // glTF normalized-integer to float conversion (signed values clamp at -1)
+        template <typename T>
+        static auto NormalizeComponent(T value) -> float
         {
-            const auto& view    = model.bufferViews[accessor.bufferView];
-            const auto& buffer  = model.buffers[view.buffer];
-            const size_t stride = accessor.ByteStride(view) ? accessor.ByteStride(view)
-                                                            : tinygltf::GetComponentSizeInBytes(accessor.componentType)
-                                                                      * tinygltf::GetNumComponentsInType(accessor.type);
-            const uint8_t* data = buffer.data.data() + view.byteOffset + accessor.byteOffset + index * stride;
-
-            switch (accessor.componentType) {
-                case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE: return *reinterpret_cast<const uint8_t*>(data);
-                case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: return *reinterpret_cast<const uint16_t*>(data);
-                case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT: return *reinterpret_cast<const uint32_t*>(data);
-                default: return 0u;
+            constexpr float kMax = static_cast<float>(std::numeric_limits<T>::max());
+            if constexpr (std::is_signed_v<T>)
+                return std::max(static_cast<float>(value) / kMax, -1.0f);
+            else
+                return static_cast<float>(value) / kMax;
+        }
+
+        // Converts the first N components of every element to float and writes them dstStride bytes apart. Components
+        // are memcpy'd in, since quantized attributes are only aligned to their component size.
+        template <typename T, int N, bool Normalized>
+        static void DecodeComponents(const AccessorStream& stream, uint8_t* dst, size_t dstStride)
+        {
+            const uint8_t* src = stream.Data;
+            for (size_t i = 0; i < stream.Count; ++i, src += stream.Stride, dst += dstStride) {
+                T in[N];
+                float out[N];
+                std::memcpy(in, src, sizeof(in));
+                for (int c = 0; c < N; ++c) {
+                    if constexpr (std::is_same_v<T, float> || !Normalized)
+                        out[c] = static_cast<float>(in[c]);
+                    else
+                        out[c] = NormalizeComponent(in[c]);
+                }
+                std::memcpy(dst, out, sizeof(out));
+            }
+        }
+
+        template <typename T, int N>
+        static void DecodeComponents(const AccessorStream& stream, uint8_t* dst, size_t dstStride)
+        {
+            if (stream.Normalized)
+                DecodeComponents<T, N, true>(stream, dst, dstStride);
+            else
+                DecodeComponents<T, N, false>(stream, dst, dstStride);
+        }
+
+        // Float, normalized and plain integer (KHR_mesh_quantization) vecN attributes. False if the format is unusable.
+        template <int N>
+        static auto DecodeAttribute(const AccessorStream& stream, uint8_t* dst, size_t dstStride) -> bool
+        {
+            if (!stream.Data || stream.ComponentCount < N) return false;
+
+            switch (stream.ComponentType) {
+                case TINYGLTF_COMPONENT_TYPE_FLOAT: DecodeComponents<float, N, false>(stream, dst, dstStride); break;
+                case TINYGLTF_COMPONENT_TYPE_BYTE: DecodeComponents<int8_t, N>(stream, dst, dstStride); break;
+                case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE: DecodeComponents<uint8_t, N>(stream, dst, dstStride); break;
+                case TINYGLTF_COMPONENT_TYPE_SHORT: DecodeComponents<int16_t, N>(stream, dst, dstStride); break;
+                case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+                    DecodeComponents<uint16_t, N>(stream, dst, dstStride);
+                    break;
+                default: return false;
             }
+            return true;
         }
 
-        static auto ReadAccessorVec2(const tinygltf::Model& model, const tinygltf::Accessor& accessor, size_t index)
-                -> glm::vec2
+        template <typename T>
+        static void WidenIndices(const AccessorStream& stream, uint32_t* dst)
         {
-            const auto& view    = model.bufferViews[accessor.bufferView];
-            const auto& buffer  = model.buffers[view.buffer];
-            const size_t stride = accessor.ByteStride(view)
-                                          ? accessor.ByteStride(view)
-                                          : sizeof(float) * tinygltf::GetNumComponentsInType(accessor.type);
-            const uint8_t* data = buffer.data.data() + view.byteOffset + accessor.byteOffset + index * stride;
-            const float* f      = reinterpret_cast<const float*>(data);
-            return glm::vec2(f[0], f[1]);
+            if (stream.Stride == sizeof(T) && reinterpret_cast<uintptr_t>(stream.Data) % alignof(T) == 0) {
+                // Tightly packed: a contiguous widening copy the compiler vectorizes
+                const T* src = reinterpret_cast<const T*>(stream.Data);
+                for (size_t i = 0; i < stream.Count; ++i) dst[i] = src[i];
+                return;
+            }
+
+            const uint8_t* src = stream.Data;
+            for (size_t i = 0; i < stream.Count; ++i, src += stream.Stride) {
+                T index;
+                std::memcpy(&index, src, sizeof(T));
+                dst[i] = index;
+            }
         }
 
-        static auto ReadAccessorVec3(const tinygltf::Model& model, const tinygltf::Accessor& accessor, size_t index)
-                -> glm::vec3
+        static auto DecodeIndices(const AccessorStream& stream, uint32_t* dst) -> bool
         {
-            const auto& view    = model.bufferViews[accessor.bufferView];
-            const auto& buffer  = model.buffers[view.buffer];
-            const size_t stride = accessor.ByteStride(view)
-                                          ? accessor.ByteStride(view)
-                                          : sizeof(float) * tinygltf::GetNumComponentsInType(accessor.type);
-            const uint8_t* data = buffer.data.data() + view.byteOffset + accessor.byteOffset + index * stride;
-            const float* f      = reinterpret_cast<const float*>(data);
-            return glm::vec3(f[0], f[1], f[2]);
+            if (!stream.Data || stream.ComponentCount != 1) return false;
+
+            switch (stream.ComponentType) {
+                case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE: WidenIndices<uint8_t>(stream, dst); break;
+                case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: WidenIndices<uint16_t>(stream, dst); break;
+                case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+                    if (stream.Stride == sizeof(uint32_t))
+                        std::memcpy(dst, stream.Data, stream.Count * sizeof(uint32_t));
+                    else
+                        WidenIndices<uint32_t>(stream, dst);
+                    break;
+                default: return false;
+            }
+            return true;
         }
     }  // namespace
 
     auto MeshLoader::LoadOBJ(const std::string& filename, const glm::mat4& transform) -> Mesh
     {
+        Walnut::Timer loadTimer;
         Mesh mesh;
-
-        tinyobj::attrib_t attrib;
-        std::vector<tinyobj::shape_t> shapes;
-        std::vector<tinyobj::material_t> materials;
-        std::string warn, err;
+        auto geometry = std::make_shared<MeshGeometry>();
 
         auto filepath = Vlkrt::MODELS_DIR + filename;
-        bool success  = tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, filepath.c_str(), Vlkrt::MODELS_DIR,
-                true,  // convert quads to triangles
-                true);
-        if (!success) {
-            WL_ERROR_TAG("MeshLoader", "Failed to load OBJ file '{}': {}", filepath, err);
+        ObjData obj;
+        if (!ObjParser::Parse(filepath, obj)) return mesh;
+
+        // A file of only points or lines is valid; it loads as an empty mesh
+        const size_t cornerCount = obj.Corners.size();
+        if (cornerCount == 0) [[unlikely]] {
+            WL_INFO_TAG("MeshLoader", "OBJ file '{}' contains no faces", filepath);
+            mesh.Transform = transform;
+            mesh.Geometry  = std::move(geometry);
             return mesh;
         }
 
-        if (!warn.empty()) { WL_WARN_TAG("MeshLoader", "OBJ loading warnings for '{}': {}", filepath, warn); }
-
-        if (shapes.empty()) [[unlikely]] {
-            WL_WARN_TAG("MeshLoader", "OBJ file '{}' contains no shapes", filepath);
-            return mesh;
+        // Build a single indexed mesh (obj files can have multiple named groups, we'll merge them). Corners that
+        // reference the same position/normal/texcoord triple are welded into one vertex.
+        std::unordered_map<ObjVertexKey, uint32_t, ObjVertexKeyHash> vertexCache;
+        vertexCache.reserve(cornerCount);
+        geometry->Indices.reserve(cornerCount);
+
+        bool missingPosition = false;
+        for (const auto& corner : obj.Corners) {
+            const ObjVertexKey key{ corner.Position, corner.Normal, corner.TexCoord };
+            auto [it, inserted] = vertexCache.try_emplace(key, static_cast<uint32_t>(geometry->Vertices.size()));
+            geometry->Indices.push_back(it->second);
+            if (!inserted) continue;
+
+            // Missing attributes default to zero; zero normals are calculated below
+            Vertex vertex{};
+            if (corner.Position >= 0)
+                vertex.Position = obj.Positions[corner.Position];
+            else
+                missingPosition = true;
+            if (corner.Normal >= 0) vertex.Normal = obj.Normals[corner.Normal];
+            if (corner.TexCoord >= 0) vertex.TexCoord = obj.TexCoords[corner.TexCoord];
+            geometry->Vertices.push_back(vertex);
         }
+        if (missingPosition) { WL_WARN_TAG("MeshLoader", "Vertex without position in OBJ file '{}'", filepath); }
 
-        // Combine all shapes into a single mesh
-        // (obj files can have multiple named groups, we'll merge them)
-        uint32_t vertexOffset = 0;
-        for (const auto& shape : shapes) {
-            const auto& mesh_data = shape.mesh;
-            if (mesh_data.indices.empty()) continue;
-
-            for (size_t faceIdx = 0; faceIdx < mesh_data.indices.size(); faceIdx += 3) {
-                auto idx0 = mesh_data.indices[faceIdx + 0];
-                auto idx1 = mesh_data.indices[faceIdx + 1];
-                auto idx2 = mesh_data.indices[faceIdx + 2];
-
-                // Create three vertices for this triangle
-                for (uint32_t i = 0; i < 3; ++i) {
-                    auto idx = mesh_data.indices[faceIdx + i];
-                    Vertex vertex;
-
-                    // Position
-                    if (idx.vertex_index >= 0) {
-                        vertex.Position.x = attrib.vertices[3 * idx.vertex_index + 0];
-                        vertex.Position.y = attrib.vertices[3 * idx.vertex_index + 1];
-                        vertex.Position.z = attrib.vertices[3 * idx.vertex_index + 2];
-                    }
-                    else {
-                        vertex.Position = glm::vec3(0.0f);
-                        WL_WARN_TAG("MeshLoader", "Vertex without position in OBJ file");
-                    }
-
-                    // Normal
-                    if (idx.normal_index >= 0) {
-                        vertex.Normal.x = attrib.normals[3 * idx.normal_index + 0];
-                        vertex.Normal.y = attrib.normals[3 * idx.normal_index + 1];
-                        vertex.Normal.z = attrib.normals[3 * idx.normal_index + 2];
-                    }
-                    else {
-                        vertex.Normal = glm::vec3(0.0f);  // Will be calculated later
-                    }
-
-                    // Texture coordinate
-                    if (idx.texcoord_index >= 0) {
-                        vertex.TexCoord.x = attrib.texcoords[2 * idx.texcoord_index + 0];
-                        vertex.TexCoord.y = attrib.texcoords[2 * idx.texcoord_index + 1];
-                    }
-                    else {
-                        vertex.TexCoord = glm::vec2(0.0f);
-                    }
-
-                    mesh.Vertices.push_back(vertex);
-                }
-
-                mesh.Indices.push_back(vertexOffset + 0);
-                mesh.Indices.push_back(vertexOffset + 1);
-                mesh.Indices.push_back(vertexOffset + 2);
-                vertexOffset += 3;
-            }
+        // One material for the whole file needs no per-triangle table
+        if (obj.MaterialNames.size() > 1) {
+            geometry->TriangleMaterials = std::move(obj.TriangleMaterials);
+            geometry->MaterialNames     = std::move(obj.MaterialNames);
         }
 
         // If the obj file didn't have normals, calculate them
         bool hasNormals = true;
-        for (const auto& vertex : mesh.Vertices) {
+        for (const auto& vertex : geometry->Vertices) {
             if (glm::length(vertex.Normal) < 0.001f) {
                 hasNormals = false;
                 break;
@@ -184,18 +278,18 @@ namespace Vlkrt
         }
         if (!hasNormals) {
             WL_INFO_TAG("MeshLoader", "Calculating normals for OBJ file '{}'", filepath);
-            CalculateNormals(mesh);
-        }
-
-        // Set material index from obj
-        if (!shapes.empty() && !shapes[0].mesh.material_ids.empty()) {
-            mesh.MaterialIndex = shapes[0].mesh.material_ids[0];
+            CalculateNormals(*geometry);
         }
 
         // Apply transform
         mesh.Transform = transform;
 
-        WL_INFO_TAG("MeshLoader", "Loaded OBJ file '{}': {} vertices", filepath, mesh.Vertices.size());
+        WL_INFO_TAG("MeshLoader", "Loaded OBJ file '{}': {} vertices welded from {} corners ({:.2f}x fewer) in {} ms",
+                filepath, geometry->Vertices.size(), cornerCount,
+                geometry->Vertices.empty() ? 0.0 : (double) cornerCount / geometry->Vertices.size(),
+                loadTimer.ElapsedMillis());
+        geometry->ComputeBounds();
+        mesh.Geometry = std::move(geometry);
 
         return mesh;
     }
@@ -210,6 +304,7 @@ namespace Vlkrt
             return result;
         }
 
+        Walnut::Timer parseTimer;
         tinygltf::Model model;
         tinygltf::TinyGLTF loader;
         std::string warn, err;
@@ -227,6 +322,7 @@ namespace Vlkrt
             WL_ERROR_TAG("MeshLoader", "Failed to load glTF '{}': {}", filepath.string(), err);
             return result;
         }
+        result.ParseMillis = parseTimer.ElapsedMillis();
 
         auto texturePathFromIndex = [&](int textureIndex) -> std::string {
             if (textureIndex < 0 || textureIndex >= (int) model.textures.size()) return {};
@@ -313,6 +409,72 @@ namespace Vlkrt
                    * glm::scale(glm::mat4(1.0f), scale);
         };
 
+        // Decodes one primitive; registered per (file, mesh, primitive) so that nodes instancing the same glTF mesh,
+        // and other entities referencing the same file, share a single copy of the vertex data.
+        auto decodePrimitive = [&](const tinygltf::Primitive& primitive) -> std::shared_ptr<const MeshGeometry> {
+            Walnut::Timer decodeTimer;
+            auto geometry = std::make_shared<MeshGeometry>();
+
+            // An empty geometry is registered like any other, so the caller skips the primitive once per file
+            auto reject = [&](const char* reason) -> std::shared_ptr<const MeshGeometry> {
+                WL_WARN_TAG("MeshLoader", "Skipping glTF primitive with {} in '{}'", reason, filepath.string());
+                geometry->Vertices.clear();
+                geometry->Indices.clear();
+                return geometry;
+            };
+
+            const int posAccessor = primitive.attributes.at("POSITION");
+            if (posAccessor < 0 || posAccessor >= (int) model.accessors.size()) return reject("no POSITION accessor");
+            const AccessorStream positions = ResolveAccessor(model, model.accessors[posAccessor]);
+            geometry->Vertices.assign(positions.Count, Vertex{ {}, glm::vec3(0.0f, 1.0f, 0.0f), glm::vec2(0.0f) });
+
+            uint8_t* vertexBase = reinterpret_cast<uint8_t*>(geometry->Vertices.data());
+            if (!DecodeAttribute<3>(positions, vertexBase + offsetof(Vertex, Position), sizeof(Vertex))) {
+                return reject("unsupported POSITION data");
+            }
+
+            // Optional attributes keep their defaults when missing or unusable
+            auto decodeOptional = [&](const char* name, auto components, size_t memberOffset) -> bool {
+                auto it = primitive.attributes.find(name);
+                if (it == primitive.attributes.end()) return false;
+
+                const AccessorStream stream = ResolveAccessor(model, model.accessors[it->second]);
+                if (stream.Count != positions.Count
+                        || !DecodeAttribute<decltype(components)::value>(
+                                stream, vertexBase + memberOffset, sizeof(Vertex))) {
+                    WL_WARN_TAG("MeshLoader", "Ignoring unsupported {} data in '{}'", name, filepath.string());
+                    return false;
+                }
+                return true;
+            };
+            const bool hasNormals
+                    = decodeOptional("NORMAL", std::integral_constant<int, 3>{}, offsetof(Vertex, Normal));
+            decodeOptional("TEXCOORD_0", std::integral_constant<int, 2>{}, offsetof(Vertex, TexCoord));
+
+            if (primitive.indices >= 0) {
+                const AccessorStream indices = ResolveAccessor(model, model.accessors[primitive.indices]);
+                geometry->Indices.resize(indices.Count);
+                if (!DecodeIndices(indices, geometry->Indices.data())) return reject("unsupported indices");
+
+                const auto maxIndex = std::max_element(geometry->Indices.begin(), geometry->Indices.end());
+                if (maxIndex != geometry->Indices.end() && *maxIndex >= geometry->Vertices.size()) {
+                    return reject("indices past the end of its vertices");
+                }
+            }
+            else {
+                geometry->Indices.resize(geometry->Vertices.size());
+                std::iota(geometry->Indices.begin(), geometry->Indices.end(), 0u);
+            }
+            if (!hasNormals) CalculateNormals(*geometry);  // glTF leaves missing normals to the client
+
+            geometry->ComputeBounds();
+            result.DecodeMillis += decodeTimer.ElapsedMillis();
+            result.DecodedVertexCount += geometry->Vertices.size();
+            return geometry;
+        };
+
+        const std::string registryPrefix = "gltf:" + filepath.lexically_normal().generic_string() + "#";
+
         std::function<void(int, const glm::mat4&)> loadNode;
         loadNode = [&](int nodeIndex, const glm::mat4& parent) {
             const tinygltf::Node& node = model.nodes[nodeIndex];
@@ -335,38 +497,10 @@ namespace Vlkrt
                     mesh.Filename      = filename;
                     mesh.Transform     = transform * world;
                     mesh.MaterialIndex = (primitive.material >= 0) ? (uint32_t) primitive.material : 0u;
-
-                    const tinygltf::Accessor& posAccessor    = model.accessors[primitive.attributes.at("POSITION")];
-                    const tinygltf::Accessor* normalAccessor = nullptr;
-                    const tinygltf::Accessor* uvAccessor     = nullptr;
-                    if (auto it = primitive.attributes.find("NORMAL"); it != primitive.attributes.end()) {
-                        normalAccessor = &model.accessors[it->second];
-                    }
-                    if (auto it = primitive.attributes.find("TEXCOORD_0"); it != primitive.attributes.end()) {
-                        uvAccessor = &model.accessors[it->second];
-                    }
-
-                    mesh.Vertices.reserve(posAccessor.count);
-                    for (size_t vi = 0; vi < posAccessor.count; ++vi) {
-                        Vertex v{};
-                        v.Position = ReadAccessorVec3(model, posAccessor, vi);
-                        v.Normal   = normalAccessor ? ReadAccessorVec3(model, *normalAccessor, vi)
-                                                    : glm::vec3(0.0f, 1.0f, 0.0f);
-                        v.TexCoord = uvAccessor ? ReadAccessorVec2(model, *uvAccessor, vi) : glm::vec2(0.0f);
-                        mesh.Vertices.push_back(v);
-                    }
-
-                    if (primitive.indices >= 0) {
-                        const tinygltf::Accessor& idxAccessor = model.accessors[primitive.indices];
-                        mesh.Indices.reserve(idxAccessor.count);
-                        for (size_t ii = 0; ii < idxAccessor.count; ++ii) {
-                            mesh.Indices.push_back(ReadAccessorUInt(model, idxAccessor, ii));
-                        }
-                    }
-                    else {
-                        mesh.Indices.reserve(mesh.Vertices.size());
-                        for (uint32_t i = 0; i < (uint32_t) mesh.Vertices.size(); ++i) { mesh.Indices.push_back(i); }
-                    }
+                    mesh.Geometry      = GeometryRegistry::GetOrCreate(
+                            registryPrefix + std::to_string(node.mesh) + "/" + std::to_string(primIdx),
+                            [&] { return decodePrimitive(primitive); });
+                    if (mesh.Geometry->Vertices.empty()) continue;
 
                     result.Meshes.push_back(std::move(mesh));
                 }
@@ -391,59 +525,63 @@ namespace Vlkrt
     auto MeshLoader::GenerateCube(float size, const glm::mat4& transform) -> Mesh
     {
         Mesh mesh;
+        auto geometry = std::make_shared<MeshGeometry>();
         float h = size * 0.5f;
 
         glm::vec3 positions[8] = { { -h, -h, -h }, { h, -h, -h }, { h, h, -h }, { -h, h, -h }, { -h, -h, h },
             { h, -h, h }, { h, h, h }, { -h, h, h } };
 
         // +Z
-        mesh.Vertices.push_back({ { -h, -h, h }, { 0, 0, 1 }, { 0, 0 } });
-        mesh.Vertices.push_back({ { h, -h, h }, { 0, 0, 1 }, { 1, 0 } });
-        mesh.Vertices.push_back({ { h, h, h }, { 0, 0, 1 }, { 1, 1 } });
-        mesh.Vertices.push_back({ { -h, h, h }, { 0, 0, 1 }, { 0, 1 } });
+        geometry->Vertices.push_back({ { -h, -h, h }, { 0, 0, 1 }, { 0, 0 } });
+        geometry->Vertices.push_back({ { h, -h, h }, { 0, 0, 1 }, { 1, 0 } });
+        geometry->Vertices.push_back({ { h, h, h }, { 0, 0, 1 }, { 1, 1 } });
+        geometry->Vertices.push_back({ { -h, h, h }, { 0, 0, 1 }, { 0, 1 } });
 
         // -Z
-        mesh.Vertices.push_back({ { h, -h, -h }, { 0, 0, -1 }, { 0, 0 } });
-        mesh.Vertices.push_back({ { -h, -h, -h }, { 0, 0, -1 }, { 1, 0 } });
-        mesh.Vertices.push_back({ { -h, h, -h }, { 0, 0, -1 }, { 1, 1 } });
-        mesh.Vertices.push_back({ { h, h, -h }, { 0, 0, -1 }, { 0, 1 } });
+        geometry->Vertices.push_back({ { h, -h, -h }, { 0, 0, -1 }, { 0, 0 } });
+        geometry->Vertices.push_back({ { -h, -h, -h }, { 0, 0, -1 }, { 1, 0 } });
+        geometry->Vertices.push_back({ { -h, h, -h }, { 0, 0, -1 }, { 1, 1 } });
+        geometry->Vertices.push_back({ { h, h, -h }, { 0, 0, -1 }, { 0, 1 } });
 
         // +X
-        mesh.Vertices.push_back({ { h, -h, h }, { 1, 0, 0 }, { 0, 0 } });
-        mesh.Vertices.push_back({ { h, -h, -h }, { 1, 0, 0 }, { 1, 0 } });
-        mesh.Vertices.push_back({ { h, h, -h }, { 1, 0, 0 }, { 1, 1 } });
-        mesh.Vertices.push_back({ { h, h, h }, { 1, 0, 0 }, { 0, 1 } });
+        geometry->Vertices.push_back({ { h, -h, h }, { 1, 0, 0 }, { 0, 0 } });
+        geometry->Vertices.push_back({ { h, -h, -h }, { 1, 0, 0 }, { 1, 0 } });
+        geometry->Vertices.push_back({ { h, h, -h }, { 1, 0, 0 }, { 1, 1 } });
+        geometry->Vertices.push_back({ { h, h, h }, { 1, 0, 0 }, { 0, 1 } });
 
         // -X
-        mesh.Vertices.push_back({ { -h, -h, -h }, { -1, 0, 0 }, { 0, 0 } });
-        mesh.Vertices.push_back({ { -h, -h, h }, { -1, 0, 0 }, { 1, 0 } });
-        mesh.Vertices.push_back({ { -h, h, h }, { -1, 0, 0 }, { 1, 1 } });
-        mesh.Vertices.push_back({ { -h, h, -h }, { -1, 0, 0 }, { 0, 1 } });
+        geometry->Vertices.push_back({ { -h, -h, -h }, { -1, 0, 0 }, { 0, 0 } });
+        geometry->Vertices.push_back({ { -h, -h, h }, { -1, 0, 0 }, { 1, 0 } });
+        geometry->Vertices.push_back({ { -h, h, h }, { -1, 0, 0 }, { 1, 1 } });
+        geometry->Vertices.push_back({ { -h, h, -h }, { -1, 0, 0 }, { 0, 1 } });
 
         // +Y
-        mesh.Vertices.push_back({ { -h, h, h }, { 0, 1, 0 }, { 0, 0 } });
-        mesh.Vertices.push_back({ { h, h, h }, { 0, 1, 0 }, { 1, 0 } });
-        mesh.Vertices.push_back({ { h, h, -h }, { 0, 1, 0 }, { 1, 1 } });
-        mesh.Vertices.push_back({ { -h, h, -h }, { 0, 1, 0 }, { 0, 1 } });
+        geometry->Vertices.push_back({ { -h, h, h }, { 0, 1, 0 }, { 0, 0 } });
+        geometry->Vertices.push_back({ { h, h, h }, { 0, 1, 0 }, { 1, 0 } });
+        geometry->Vertices.push_back({ { h, h, -h }, { 0, 1, 0 }, { 1, 1 } });
+        geometry->Vertices.push_back({ { -h, h, -h }, { 0, 1, 0 }, { 0, 1 } });
 
         // -Y
-        mesh.Vertices.push_back({ { -h, -h, -h }, { 0, -1, 0 }, { 0, 0 } });
-        mesh.Vertices.push_back({ { h, -h, -h }, { 0, -1, 0 }, { 1, 0 } });
-        mesh.Vertices.push_back({ { h, -h, h }, { 0, -1, 0 }, { 1, 1 } });
-        mesh.Vertices.push_back({ { -h, -h, h }, { 0, -1, 0 }, { 0, 1 } });
+        geometry->Vertices.push_back({ { -h, -h, -h }, { 0, -1, 0 }, { 0, 0 } });
+        geometry->Vertices.push_back({ { h, -h, -h }, { 0, -1, 0 }, { 1, 0 } });
+        geometry->Vertices.push_back({ { h, -h, h }, { 0, -1, 0 }, { 1, 1 } });
+        geometry->Vertices.push_back({ { -h, -h, h }, { 0, -1, 0 }, { 0, 1 } });
 
         for (uint32_t i = 0; i < 6; ++i) {
             auto base = i * 4;
-            mesh.Indices.push_back(base + 0);
-            mesh.Indices.push_back(base + 1);
-            mesh.Indices.push_back(base + 2);
-            mesh.Indices.push_back(base + 2);
-            mesh.Indices.push_back(base + 3);
-            mesh.Indices.push_back(base + 0);
+            geometry->Indices.push_back(base + 0);
+            geometry->Indices.push_back(base + 1);
+            geometry->Indices.push_back(base + 2);
+            geometry->Indices.push_back(base + 2);
+            geometry->Indices.push_back(base + 3);
+            geometry->Indices.push_back(base + 0);
         }
 
+        geometry->ComputeBounds();
+
         // Apply transform
         mesh.Transform = transform;
+        mesh.Geometry  = std::move(geometry);
 
         return mesh;
     }
@@ -451,49 +589,83 @@ namespace Vlkrt
     auto MeshLoader::GenerateQuad(float size, const glm::mat4& transform) -> Mesh
     {
         Mesh mesh;
+        auto geometry = std::make_shared<MeshGeometry>();
         float h = size * 0.5f;
 
         // Quad in XZ plane (y=0) with upward normal (+Y)
-        mesh.Vertices.push_back({ { -h, 0.0f, h }, { 0, 1, 0 }, { 0, 0 } });
-        mesh.Vertices.push_back({ { h, 0.0f, h }, { 0, 1, 0 }, { 1, 0 } });
-        mesh.Vertices.push_back({ { h, 0.0f, -h }, { 0, 1, 0 }, { 1, 1 } });
-        mesh.Vertices.push_back({ { -h, 0.0f, -h }, { 0, 1, 0 }, { 0, 1 } });
-
-        mesh.Indices.push_back(0);
-        mesh.Indices.push_back(1);
-        mesh.Indices.push_back(2);
-        mesh.Indices.push_back(2);
-        mesh.Indices.push_back(3);
-        mesh.Indices.push_back(0);
+        geometry->Vertices.push_back({ { -h, 0.0f, h }, { 0, 1, 0 }, { 0, 0 } });
+        geometry->Vertices.push_back({ { h, 0.0f, h }, { 0, 1, 0 }, { 1, 0 } });
+        geometry->Vertices.push_back({ { h, 0.0f, -h }, { 0, 1, 0 }, { 1, 1 } });
+        geometry->Vertices.push_back({ { -h, 0.0f, -h }, { 0, 1, 0 }, { 0, 1 } });
+
+        geometry->Indices.push_back(0);
+        geometry->Indices.push_back(1);
+        geometry->Indices.push_back(2);
+        geometry->Indices.push_back(2);
+        geometry->Indices.push_back(3);
+        geometry->Indices.push_back(0);
+
+        geometry->ComputeBounds();
 
         // Apply transform
         mesh.Transform = transform;
+        mesh.Geometry  = std::move(geometry);
 
         return mesh;
     }
 
-    void MeshLoader::CalculateNormals(Mesh& mesh)
+    void MeshLoader::CalculateNormals(MeshGeometry& geometry)
     {
-        // Reset all normals to zero
-        for (auto& vertex : mesh.Vertices) { vertex.Normal = glm::vec3(0.0f); }
-
-        // Calculate face normals and accumulate
-        for (size_t i = 0; i < mesh.Indices.size(); i += 3) {
-            auto i0 = mesh.Indices[i + 0];
-            auto i1 = mesh.Indices[i + 1];
-            auto i2 = mesh.Indices[i + 2];
-
-            glm::vec3& v0 = mesh.Vertices[i0].Position;
-            glm::vec3& v1 = mesh.Vertices[i1].Position;
-            glm::vec3& v2 = mesh.Vertices[i2].Position;
-
-            glm::vec3 edge1      = v1 - v0;
-            glm::vec3 edge2      = v2 - v0;
-            glm::vec3 faceNormal = glm::normalize(glm::cross(edge1, edge2));
-
-            mesh.Vertices[i0].Normal += faceNormal;
-            mesh.Vertices[i1].Normal += faceNormal;
-            mesh.Vertices[i2].Normal += faceNormal;
-        }
+        constexpr size_t kGrainSize = 16 * 1024;  // Triangles or vertices per ThreadPool task
+        const size_t triangleCount  = geometry.Indices.size() / 3;
+        const size_t vertexCount    = geometry.Vertices.size();
+
+        // Face normal per triangle corner, weighted by the corner's angle so that the result does not depend on how
+        // the surface around a vertex is tessellated. Degenerate triangles contribute nothing.
+        std::vector<glm::vec3> cornerNormals(triangleCount * 3, glm::vec3(0.0f));
+        ThreadPool::Get().ParallelFor(
+                triangleCount,
+                [&](size_t begin, size_t end) {
+                    for (size_t t = begin; t < end; ++t) {
+                        const uint32_t* corners = &geometry.Indices[3 * t];
+                        const glm::vec3 p[3]    = { geometry.Vertices[corners[0]].Position,
+                               geometry.Vertices[corners[1]].Position, geometry.Vertices[corners[2]].Position };
+
+                        const glm::vec3 normal = glm::cross(p[1] - p[0], p[2] - p[0]);
+                        const float length     = glm::length(normal);
+                        if (!(length > std::numeric_limits<float>::min()) || !std::isfinite(length)) continue;
+
+                        for (int k = 0; k < 3; ++k) {
+                            const glm::vec3 e0 = p[(k + 1) % 3] - p[k];
+                            const glm::vec3 e1 = p[(k + 2) % 3] - p[k];
+                            const float cosine = glm::dot(e0, e1) / (glm::length(e0) * glm::length(e1));
+                            cornerNormals[3 * t + k] = normal * (std::acos(glm::clamp(cosine, -1.0f, 1.0f)) / length);
+                        }
+                    }
+                },
+                kGrainSize);
+
+        // Gather through a vertex -> corner table rather than scattering into shared vertices: no per-thread copies
+        // of the vertex array, and corners are summed in a fixed order so the result is deterministic.
+        std::vector<uint32_t> offsets(vertexCount + 1, 0);
+        for (size_t i = 0; i < triangleCount * 3; ++i) ++offsets[geometry.Indices[i] + 1];
+        for (size_t v = 0; v < vertexCount; ++v) offsets[v + 1] += offsets[v];
+        std::vector<uint32_t> vertexCorners(triangleCount * 3);
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (uint32_t i = 0; i < triangleCount * 3; ++i) vertexCorners[fill[geometry.Indices[i]]++] = i;
+
+        ThreadPool::Get().ParallelFor(
+                vertexCount,
+                [&](size_t begin, size_t end) {
+                    for (size_t v = begin; v < end; ++v) {
+                        glm::vec3 sum(0.0f);
+                        for (uint32_t c = offsets[v]; c < offsets[v + 1]; ++c) sum += cornerNormals[vertexCorners[c]];
+
+                        // Vertices with no usable triangle get the same default as glTF primitives without normals
+                        const float length          = glm::length(sum);
+                        geometry.Vertices[v].Normal = length > 0.0f ? sum / length : glm::vec3(0.0f, 1.0f, 0.0f);
+                    }
+                },
+                kGrainSize);
     }
 }  // namespace Vlkrt
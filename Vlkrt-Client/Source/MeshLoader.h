@@ -9,10 +9,16 @@ namespace Vlkrt
     {
         std::vector<Mesh> Meshes;
         std::vector<Material> Materials;
+
+        // Cost of the load that produced this import: tinygltf parse, and conversion of the primitives it decoded
+        float ParseMillis{ 0.0f };
+        float DecodeMillis{ 0.0f };
+        uint64_t DecodedVertexCount{ 0 };
     };
 
     /// <summary>
     /// Class used to load meshes (from OBJ files) and generate procedural meshes.
+    /// Every call produces fresh geometry; go through GeometryRegistry to share geometry between instances.
     /// </summary>
     class MeshLoader
     {
@@ -24,6 +30,6 @@ namespace Vlkrt
         static auto GenerateQuad(float size, const glm::mat4& transform = glm::mat4(1.0f)) -> Mesh;
 
     private:
-        static void CalculateNormals(Mesh& mesh);
+        static void CalculateNormals(MeshGeometry& geometry);
     };
 }  // namespace Vlkrt
@@ -0,0 +1,252 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <unordered_set>
+
+namespace Vlkrt
+{
+    namespace
+    {
+        constexpr int32_t kOptimizerCacheSize = 32;  // Modelled LRU size while reordering
+
+        // Forsyth's vertex score: recently used vertices and vertices with few remaining triangles score highest
+        static auto VertexScore(int32_t cachePosition, uint32_t remainingTriangles) -> float
+        {
+            if (remainingTriangles == 0) return -1.0f;
+
+            float score = 0.0f;
+            if (cachePosition >= 0) {
+                if (cachePosition < 3) {
+                    score = 0.75f;  // Last triangle's vertices: fixed score so its neighbours are not preferred blindly
+                }
+                else {
+                    const float scale = 1.0f / static_cast<float>(kOptimizerCacheSize - 3);
+                    score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scale, 1.5f);
+                }
+            }
+            return score + 2.0f / std::sqrt(static_cast<float>(remainingTriangles));
+        }
+
+        static auto ComputeVertexCacheOrder(const std::vector<uint32_t>& indices, size_t vertexCount)
+                -> std::vector<uint32_t>
+        {
+            const size_t triangleCount = indices.size() / 3;
+
+            // Triangles adjacent to each vertex, as compact per-vertex ranges; a range shrinks as triangles are emitted
+            std::vector<uint32_t> remaining(vertexCount, 0);
+            for (uint32_t index : indices) ++remaining[index];
+            std::vector<uint32_t> offsets(vertexCount + 1, 0);
+            for (size_t v = 0; v < vertexCount; ++v) offsets[v + 1] = offsets[v] + remaining[v];
+            std::vector<uint32_t> adjacency(indices.size());
+            std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+            for (uint32_t t = 0; t < triangleCount; ++t) {
+                for (int k = 0; k < 3; ++k) adjacency[fill[indices[3 * t + k]]++] = t;
+            }
+
+            std::vector<int32_t> cachePosition(vertexCount, -1);
+            std::vector<float> vertexScores(vertexCount);
+            for (size_t v = 0; v < vertexCount; ++v) vertexScores[v] = VertexScore(-1, remaining[v]);
+
+            std::vector<float> triangleScores(triangleCount);
+            for (size_t t = 0; t < triangleCount; ++t) {
+                triangleScores[t] = vertexScores[indices[3 * t]] + vertexScores[indices[3 * t + 1]]
+                                    + vertexScores[indices[3 * t + 2]];
+            }
+
+            std::vector<uint32_t> order;
+            order.reserve(triangleCount);
+            std::vector<uint8_t> emitted(triangleCount, 0);
+            std::array<uint32_t, kOptimizerCacheSize + 3> cache{};
+            std::array<uint32_t, kOptimizerCacheSize + 3> nextCache{};
+            size_t cacheCount = 0;
+            size_t cursor     = 0;
+
+            int64_t best = std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin();
+            while (order.size() < triangleCount) {
+                // Nothing adjacent to the cache is left: continue from the next unemitted triangle in input order
+                if (best < 0) {
+                    while (emitted[cursor]) ++cursor;
+                    best = static_cast<int64_t>(cursor);
+                }
+
+                const uint32_t triangle = static_cast<uint32_t>(best);
+                const uint32_t* corners = &indices[3 * triangle];
+                emitted[triangle]       = 1;
+                order.push_back(triangle);
+
+                // The triangle's vertices move to the front of the cache, the rest shift back
+                size_t nextCount = 0;
+                for (int k = 0; k < 3; ++k) {
+                    if (std::find(nextCache.begin(), nextCache.begin() + nextCount, corners[k])
+                            == nextCache.begin() + nextCount) {
+                        nextCache[nextCount++] = corners[k];
+                    }
+
+                    // Remove the triangle from the vertex's adjacency range
+                    uint32_t* begin = &adjacency[offsets[corners[k]]];
+                    uint32_t* end   = begin + remaining[corners[k]];
+                    if (uint32_t* it = std::find(begin, end, triangle); it != end) {
+                        *it = end[-1];
+                        --remaining[corners[k]];
+                    }
+                }
+                const size_t frontCount = nextCount;
+                for (size_t i = 0; i < cacheCount; ++i) {
+                    if (std::find(nextCache.begin(), nextCache.begin() + frontCount, cache[i])
+                            == nextCache.begin() + frontCount) {
+                        nextCache[nextCount++] = cache[i];
+                    }
+                }
+
+                // Rescore everything that entered, moved in or fell out of the cache, then their triangles
+                for (size_t i = 0; i < nextCount; ++i) {
+                    const uint32_t v = nextCache[i];
+                    cachePosition[v] = i < kOptimizerCacheSize ? static_cast<int32_t>(i) : -1;
+                    vertexScores[v]  = VertexScore(cachePosition[v], remaining[v]);
+                }
+
+                best            = -1;
+                float bestScore = -1.0f;
+                for (size_t i = 0; i < nextCount; ++i) {
+                    const uint32_t v = nextCache[i];
+                    for (uint32_t a = offsets[v]; a < offsets[v] + remaining[v]; ++a) {
+                        const uint32_t t  = adjacency[a];
+                        triangleScores[t] = vertexScores[indices[3 * t]] + vertexScores[indices[3 * t + 1]]
+                                            + vertexScores[indices[3 * t + 2]];
+                        if (triangleScores[t] > bestScore) {
+                            bestScore = triangleScores[t];
+                            best      = t;
+                        }
+                    }
+                }
+
+                cacheCount = std::min<size_t>(nextCount, kOptimizerCacheSize);
+                std::copy(nextCache.begin(), nextCache.begin() + cacheCount, cache.begin());
+            }
+            return order;
+        }
+
+        // Spreads the low 10 bits of v so that two zero bits separate each
+        static auto ExpandBits(uint32_t v) -> uint32_t
+        {
+            v = (v * 0x00010001u) & 0xFF0000FFu;
+            v = (v * 0x00000101u) & 0x0F00F00Fu;
+            v = (v * 0x00000011u) & 0xC30C30C3u;
+            v = (v * 0x00000005u) & 0x49249249u;
+            return v;
+        }
+
+        static auto ComputeSpatialOrder(const MeshGeometry& geometry) -> std::vector<uint32_t>
+        {
+            const size_t triangleCount = geometry.Indices.size() / 3;
+            const AABB& bounds         = geometry.LocalBounds;
+            const glm::vec3 extent     = glm::max(bounds.Max - bounds.Min, glm::vec3(1e-20f));
+            const glm::vec3 scale      = 1023.0f / extent;
+
+            std::vector<uint32_t> codes(triangleCount);
+            for (size_t t = 0; t < triangleCount; ++t) {
+                const glm::vec3 centroid = (geometry.Vertices[geometry.Indices[3 * t]].Position
+                                                   + geometry.Vertices[geometry.Indices[3 * t + 1]].Position
+                                                   + geometry.Vertices[geometry.Indices[3 * t + 2]].Position)
+                                           / 3.0f;
+                const glm::uvec3 cell = glm::uvec3(glm::clamp((centroid - bounds.Min) * scale, 0.0f, 1023.0f));
+                codes[t]              = (ExpandBits(cell.x) << 2) | (ExpandBits(cell.y) << 1) | ExpandBits(cell.z);
+            }
+
+            std::vector<uint32_t> order(triangleCount);
+            std::iota(order.begin(), order.end(), 0u);
+            std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return codes[a] < codes[b]; });
+            return order;
+        }
+
+        static void ApplyTriangleOrder(MeshGeometry& geometry, const std::vector<uint32_t>& order)
+        {
+            std::vector<uint32_t> indices(order.size() * 3);
+            for (size_t i = 0; i < order.size(); ++i) {
+                std::copy_n(&geometry.Indices[3 * order[i]], 3, &indices[3 * i]);
+            }
+            geometry.Indices = std::move(indices);
+
+            if (!geometry.TriangleMaterials.empty()) {
+                std::vector<uint32_t> materials(order.size());
+                for (size_t i = 0; i < order.size(); ++i) materials[i] = geometry.TriangleMaterials[order[i]];
+                geometry.TriangleMaterials = std::move(materials);
+            }
+        }
+
+        // Renumbers vertices in the order the index buffer first references them; unreferenced vertices are dropped
+        static void OptimizeVertexFetch(MeshGeometry& geometry)
+        {
+            constexpr uint32_t kUnassigned = UINT32_MAX;
+            std::vector<uint32_t> remap(geometry.Vertices.size(), kUnassigned);
+            std::vector<Vertex> vertices;
+            vertices.reserve(geometry.Vertices.size());
+
+            for (uint32_t& index : geometry.Indices) {
+                if (remap[index] == kUnassigned) {
+                    remap[index] = static_cast<uint32_t>(vertices.size());
+                    vertices.push_back(geometry.Vertices[index]);
+                }
+                index = remap[index];
+            }
+            geometry.Vertices = std::move(vertices);
+        }
+    }  // namespace
+
+    auto MeshOptimizer::Optimize(const MeshGeometry& source, bool spatialSort) -> MeshGeometry
+    {
+        MeshGeometry geometry;
+        geometry.Vertices          = source.Vertices;
+        geometry.Indices           = source.Indices;
+        geometry.TriangleMaterials = source.TriangleMaterials;
+        geometry.MaterialNames     = source.MaterialNames;
+        geometry.LocalBounds       = source.LocalBounds;
+        if (geometry.Indices.size() < 3 || geometry.Vertices.empty()) return geometry;
+
+        geometry.Indices.resize(geometry.Indices.size() - geometry.Indices.size() % 3);
+        if (spatialSort) ApplyTriangleOrder(geometry, ComputeSpatialOrder(geometry));
+        ApplyTriangleOrder(geometry, ComputeVertexCacheOrder(geometry.Indices, geometry.Vertices.size()));
+        OptimizeVertexFetch(geometry);
+        geometry.ComputeBounds();
+        return geometry;
+    }
+
+    auto MeshOptimizer::Analyze(const MeshGeometry& geometry) -> MeshLocalityMetrics
+    {
+        MeshLocalityMetrics metrics;
+        const size_t triangleCount = geometry.Indices.size() / 3;
+        if (triangleCount == 0 || geometry.Vertices.empty()) return metrics;
+
+        // FIFO post-transform cache
+        std::vector<uint64_t> cachedAt(geometry.Vertices.size(), 0);
+        uint64_t misses = 0;
+        for (uint32_t index : geometry.Indices) {
+            if (cachedAt[index] == 0 || misses - cachedAt[index] + 1 > kSimulatedCacheSize) cachedAt[index] = ++misses;
+        }
+
+        // Vertex fetch through a small FIFO cache of lines
+        constexpr size_t kFetchCacheLines = 64;
+        std::vector<uint64_t> lineCachedAt(
+                (geometry.Vertices.size() * sizeof(Vertex) + kFetchLineBytes - 1) / kFetchLineBytes + 1, 0);
+        uint64_t linesFetched = 0;
+        for (uint32_t index : geometry.Indices) {
+            const size_t first = index * sizeof(Vertex) / kFetchLineBytes;
+            const size_t last  = (index * sizeof(Vertex) + sizeof(Vertex) - 1) / kFetchLineBytes;
+            for (size_t line = first; line <= last; ++line) {
+                if (lineCachedAt[line] == 0 || linesFetched - lineCachedAt[line] + 1 > kFetchCacheLines) {
+                    lineCachedAt[line] = ++linesFetched;
+                }
+            }
+        }
+
+        std::unordered_set<uint32_t> referenced(geometry.Indices.begin(), geometry.Indices.end());
+        metrics.ACMR            = static_cast<float>(misses) / static_cast<float>(triangleCount);
+        metrics.ATVR            = static_cast<float>(misses) / static_cast<float>(referenced.size());
+        metrics.FetchEfficiency = static_cast<float>(referenced.size() * sizeof(Vertex))
+                                  / static_cast<float>(linesFetched * kFetchLineBytes);
+        return metrics;
+    }
+}  // namespace Vlkrt
@@ -0,0 +1,268 @@
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace Vlkrt
+{
+    namespace
+    {
+        // Symmetric 4x4 sum of squared plane distances: xx xy xz xw yy yz yw zz zw ww
+        struct Quadric
+        {
+            double A[10]{};
+
+            void AddPlane(const glm::dvec3& n, double d)
+            {
+                const double plane[4] = { n.x, n.y, n.z, d };
+                for (int row = 0, i = 0; row < 4; ++row) {
+                    for (int col = row; col < 4; ++col) A[i++] += plane[row] * plane[col];
+                }
+            }
+
+            auto operator+=(const Quadric& other) -> Quadric&
+            {
+                for (int i = 0; i < 10; ++i) A[i] += other.A[i];
+                return *this;
+            }
+
+            auto Evaluate(const glm::dvec3& p) const -> double
+            {
+                const double x = p.x, y = p.y, z = p.z;
+                const double error = A[0] * x * x + 2.0 * (A[1] * x * y + A[2] * x * z + A[3] * x) + A[4] * y * y
+                                     + 2.0 * (A[5] * y * z + A[6] * y) + A[7] * z * z + 2.0 * A[8] * z + A[9];
+                return std::max(error, 0.0);
+            }
+        };
+
+        struct Collapse
+        {
+            float Cost;
+            uint32_t From;
+            uint32_t To;
+        };
+
+        // Simplifies towards each target triangle count in turn (decreasing), snapshotting a LOD as each is reached, so
+        // the whole chain costs one run. Stops early, with a last snapshot, when no collapse within maxError is left.
+        static auto SimplifyToTargets(const MeshGeometry& geometry, const std::vector<size_t>& targets, float maxError)
+                -> std::vector<GeometryLOD>
+        {
+            std::vector<GeometryLOD> lods;
+            GeometryLOD lod;
+            lod.Indices.assign(geometry.Indices.begin(), geometry.Indices.end() - geometry.Indices.size() % 3);
+            lod.TriangleMaterials = geometry.TriangleMaterials;
+
+            const size_t vertexCount = geometry.Vertices.size();
+            size_t triangleCount     = lod.Indices.size() / 3;
+            const float diagonal     = glm::length(geometry.LocalBounds.GetExtent());
+            if (targets.empty() || vertexCount == 0 || !(diagonal > 0.0f)) {
+                lods.push_back(std::move(lod));
+                return lods;
+            }
+            const bool hasMaterials = lod.TriangleMaterials.size() == triangleCount;
+
+            // Positions relative to the bounds, so that costs are squared relative errors
+            std::vector<glm::dvec3> positions(vertexCount);
+            for (size_t v = 0; v < vertexCount; ++v) {
+                positions[v] = glm::dvec3(geometry.Vertices[v].Position - geometry.LocalBounds.Min) / (double) diagonal;
+            }
+
+            // Lock vertices on edges used by a single triangle, and vertices shared by triangles of different materials
+            std::vector<uint8_t> locked(vertexCount, 0);
+            {
+                std::vector<uint64_t> edges;
+                edges.reserve(triangleCount * 3);
+                for (size_t t = 0; t < triangleCount; ++t) {
+                    for (int k = 0; k < 3; ++k) {
+                        const uint64_t a = lod.Indices[3 * t + k], b = lod.Indices[3 * t + (k + 1) % 3];
+                        edges.push_back(std::min(a, b) << 32 | std::max(a, b));
+                    }
+                }
+                std::sort(edges.begin(), edges.end());
+                for (size_t i = 0; i < edges.size();) {
+                    size_t run = 1;
+                    while (i + run < edges.size() && edges[i + run] == edges[i]) ++run;
+                    if (run == 1) locked[edges[i] >> 32] = locked[edges[i] & 0xFFFF'FFFFu] = 1;
+                    i += run;
+                }
+
+                if (hasMaterials) {
+                    std::vector<uint32_t> vertexMaterial(vertexCount, UINT32_MAX);
+                    for (size_t t = 0; t < triangleCount; ++t) {
+                        for (int k = 0; k < 3; ++k) {
+                            uint32_t& material = vertexMaterial[lod.Indices[3 * t + k]];
+                            if (material == UINT32_MAX) material = lod.TriangleMaterials[t];
+                            if (material != lod.TriangleMaterials[t]) locked[lod.Indices[3 * t + k]] = 1;
+                        }
+                    }
+                }
+            }
+
+            std::vector<Quadric> quadrics(vertexCount);
+            for (size_t t = 0; t < triangleCount; ++t) {
+                const uint32_t* corners = &lod.Indices[3 * t];
+                const glm::dvec3 normal = glm::cross(
+                        positions[corners[1]] - positions[corners[0]], positions[corners[2]] - positions[corners[0]]);
+                const double length = glm::length(normal);
+                if (!(length > 0.0)) continue;
+                const glm::dvec3 n = normal / length;
+                const double d     = -glm::dot(n, positions[corners[0]]);
+                for (int k = 0; k < 3; ++k) quadrics[corners[k]].AddPlane(n, d);
+            }
+
+            const double maxCost = static_cast<double>(maxError) * maxError;
+            double worstCost     = 0.0;
+            std::vector<uint32_t> remap(vertexCount);
+            std::vector<uint8_t> touched(vertexCount);
+            std::vector<Collapse> candidates;
+            std::vector<uint32_t> offsets(vertexCount + 1), adjacency;
+
+            // Each pass collapses the cheapest edges that do not share a vertex, then compacts the index buffer
+            for (size_t target = 0; target < targets.size();) {
+                const size_t targetTriangles = targets[target];
+                if (triangleCount <= targetTriangles) {
+                    lod.Error = static_cast<float>(std::sqrt(worstCost));
+                    lods.push_back(lod);
+                    ++target;
+                    continue;
+                }
+
+                candidates.clear();
+                for (size_t t = 0; t < triangleCount; ++t) {
+                    for (int k = 0; k < 3; ++k) {
+                        const uint32_t a = lod.Indices[3 * t + k], b = lod.Indices[3 * t + (k + 1) % 3];
+                        if (a >= b) continue;  // Interior edges appear once in each direction
+                        Quadric sum = quadrics[a];
+                        sum += quadrics[b];
+                        if (!locked[a]) candidates.push_back({ (float) sum.Evaluate(positions[b]), a, b });
+                        if (!locked[b]) candidates.push_back({ (float) sum.Evaluate(positions[a]), b, a });
+                    }
+                }
+                std::sort(candidates.begin(), candidates.end(),
+                        [](const Collapse& lhs, const Collapse& rhs) { return lhs.Cost < rhs.Cost; });
+
+                std::fill(offsets.begin(), offsets.end(), 0u);
+                for (size_t i = 0; i < triangleCount * 3; ++i) ++offsets[lod.Indices[i] + 1];
+                for (size_t v = 0; v < vertexCount; ++v) offsets[v + 1] += offsets[v];
+                adjacency.resize(triangleCount * 3);
+                std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+                for (uint32_t i = 0; i < triangleCount * 3; ++i) adjacency[fill[lod.Indices[i]]++] = i / 3;
+
+                std::iota(remap.begin(), remap.end(), 0u);
+                std::fill(touched.begin(), touched.end(), 0);
+                const size_t needed = triangleCount - targetTriangles;
+                size_t removed      = 0;
+                for (const Collapse& collapse : candidates) {
+                    if (collapse.Cost > maxCost || removed >= needed) break;
+                    if (touched[collapse.From] || touched[collapse.To]) continue;
+
+                    // Reject collapses that flip or fold a surviving triangle around From
+                    bool flips        = false;
+                    size_t collapsing = 0;
+                    for (uint32_t a = offsets[collapse.From]; a < offsets[collapse.From + 1] && !flips; ++a) {
+                        uint32_t corners[3];
+                        for (int k = 0; k < 3; ++k) corners[k] = remap[lod.Indices[3 * adjacency[a] + k]];
+                        if (corners[0] == collapse.To || corners[1] == collapse.To || corners[2] == collapse.To) {
+                            ++collapsing;
+                            continue;
+                        }
+
+                        const glm::dvec3 before = glm::cross(positions[corners[1]] - positions[corners[0]],
+                                positions[corners[2]] - positions[corners[0]]);
+                        for (uint32_t& corner : corners) {
+                            if (corner == collapse.From) corner = collapse.To;
+                        }
+                        const glm::dvec3 after = glm::cross(positions[corners[1]] - positions[corners[0]],
+                                positions[corners[2]] - positions[corners[0]]);
+                        // Turning by more than ~75 degrees folds the triangle into a sliver even when it does not flip.
+                        // A degenerate triangle has no orientation to keep, so it must not gain area either.
+                        const double lengths = glm::length(before) * glm::length(after);
+                        flips = glm::dot(before, before) > 0.0 ? glm::dot(before, after) <= 0.25 * lengths
+                                                               : glm::dot(after, after) > 0.0;
+                    }
+                    if (flips) continue;
+
+                    remap[collapse.From] = collapse.To;
+                    quadrics[collapse.To] += quadrics[collapse.From];
+                    touched[collapse.From] = touched[collapse.To] = 1;
+                    worstCost                                      = std::max(worstCost, (double) collapse.Cost);
+                    removed += collapsing;
+                }
+                if (removed == 0) {
+                    lod.Error = static_cast<float>(std::sqrt(worstCost));
+                    lods.push_back(std::move(lod));
+                    break;
+                }
+
+                size_t kept = 0;
+                for (size_t t = 0; t < triangleCount; ++t) {
+                    const uint32_t a = remap[lod.Indices[3 * t]];
+                    const uint32_t b = remap[lod.Indices[3 * t + 1]];
+                    const uint32_t c = remap[lod.Indices[3 * t + 2]];
+                    if (a == b || b == c || a == c) continue;
+                    lod.Indices[3 * kept]     = a;
+                    lod.Indices[3 * kept + 1] = b;
+                    lod.Indices[3 * kept + 2] = c;
+                    if (hasMaterials) lod.TriangleMaterials[kept] = lod.TriangleMaterials[t];
+                    ++kept;
+                }
+                triangleCount = kept;
+                lod.Indices.resize(kept * 3);
+                if (hasMaterials) lod.TriangleMaterials.resize(kept);
+            }
+
+            return lods;
+        }
+    }  // namespace
+
+    auto MeshSimplifier::Simplify(const MeshGeometry& geometry, size_t targetTriangles, float maxError) -> GeometryLOD
+    {
+        return std::move(SimplifyToTargets(geometry, { targetTriangles }, maxError).back());
+    }
+
+    auto MeshSimplifier::GenerateLODs(const MeshGeometry& geometry, uint32_t levels) -> std::vector<GeometryLOD>
+    {
+        std::vector<GeometryLOD> lods;
+        const size_t triangleCount = geometry.Indices.size() / 3;
+        if (triangleCount < kMinTriangles) return lods;
+
+        std::vector<size_t> targets;
+        for (uint32_t level = 1; level <= levels && level < 32; ++level) targets.push_back(triangleCount >> level);
+        std::vector<GeometryLOD> chain = SimplifyToTargets(geometry, targets, kMaxError);
+
+        // Keep levels that remove a meaningful share of the previous one's triangles
+        size_t previous = triangleCount;
+        for (auto& lod : chain) {
+            if (lod.Indices.size() / 3 * 10 > previous * 9) continue;
+            previous = lod.Indices.size() / 3;
+            lods.push_back(std::move(lod));
+        }
+        return lods;
+    }
+
+    auto MeshSimplifier::SelectLOD(const Mesh& mesh, const glm::vec3& viewPosition, float pixelsPerUnit,
+            float pixelErrorLimit) -> uint32_t
+    {
+        if (mesh.GetLODCount() == 1) return 0;
+        const AABB& bounds = mesh.GetWorldBounds();
+        if (!bounds.IsValid()) return 0;
+
+        // LOD errors are relative to the diagonal, which scales with the instance's transform
+        const float diagonal = glm::length(bounds.GetExtent());
+        const float distance = glm::length(viewPosition - bounds.GetCenter()) - 0.5f * diagonal;
+        if (distance <= 0.0f) return 0;
+        const float pixelsPerError = diagonal * pixelsPerUnit / distance;
+
+        // Switching to a coarser level than the current one needs some margin, so that LODs do not flicker at the
+        // threshold
+        uint32_t selected = 0;
+        const auto& lods  = mesh.Geometry->LODs;
+        for (uint32_t i = 0; i < lods.size(); ++i) {
+            const float limit = i + 1 > mesh.LODIndex ? pixelErrorLimit * kLODHysteresis : pixelErrorLimit;
+            if (lods[i].Error * pixelsPerError > limit) break;
+            selected = i + 1;
+        }
+        return selected;
+    }
+}  // namespace Vlkrt
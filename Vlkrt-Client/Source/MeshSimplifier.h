@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Scene.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Vlkrt
+{
+    /// <summary>
+    /// Quadric error metric simplification by vertex-to-vertex edge collapse. Vertices never move and only the index
+    /// buffer shrinks, so every LOD shares the full vertex buffer and keeps its attributes exactly. Open borders
+    /// (including UV and normal seams, which welding leaves as split vertices) and material boundaries are locked so
+    /// that simplification cannot open cracks or move material edges.
+    /// </summary>
+    class MeshSimplifier
+    {
+    public:
+        static constexpr uint32_t kMinTriangles = 256;      // Smaller geometry gets no LODs
+        static constexpr float kMaxError        = 0.05f;    // Relative to the bounds' diagonal
+        static constexpr float kLODHysteresis   = 0.75f;    // Share of the pixel error needed to switch to coarser
+
+        // Collapses edges, cheapest first, until at most targetTriangles remain or the next collapse would exceed
+        // maxError. Returns the result even if the target was not reached.
+        static auto Simplify(const MeshGeometry& geometry, size_t targetTriangles, float maxError = kMaxError)
+                -> GeometryLOD;
+        // Up to levels LODs, each targeting half the triangles of the previous one. The chain stops early once a
+        // level no longer removes a meaningful share of triangles.
+        static auto GenerateLODs(const MeshGeometry& geometry, uint32_t levels) -> std::vector<GeometryLOD>;
+
+        // Coarsest LOD of mesh whose error, projected from viewPosition, stays under pixelErrorLimit pixels.
+        // pixelsPerUnit is the size in pixels of one world unit at distance 1.
+        static auto SelectLOD(const Mesh& mesh, const glm::vec3& viewPosition, float pixelsPerUnit,
+                float pixelErrorLimit) -> uint32_t;
+    };
+}  // namespace Vlkrt
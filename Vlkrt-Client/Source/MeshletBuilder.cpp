@@ -0,0 +1,160 @@
+#include "MeshletBuilder.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Vlkrt
+{
+    namespace
+    {
+        constexpr uint32_t kNoLocalIndex = UINT32_MAX;
+
+        // normals is scratch space, reused across meshlets
+        static void ComputeMeshletBounds(const MeshGeometry& geometry, const MeshletData& data, Meshlet& meshlet,
+                std::vector<glm::vec3>& normals)
+        {
+            for (uint32_t i = 0; i < meshlet.VertexCount; ++i) {
+                meshlet.Bounds.Expand(geometry.Vertices[data.VertexIndices[meshlet.VertexOffset + i]].Position);
+            }
+
+            // Unit face normals; degenerate triangles face nowhere, keep a zero normal and are left out of the cone
+            normals.assign(meshlet.TriangleCount, glm::vec3(0.0f));
+            glm::vec3 axis(0.0f);
+            for (uint32_t t = 0; t < meshlet.TriangleCount; ++t) {
+                const glm::vec3& p0 = geometry.Vertices[data.GetTriangleIndex(meshlet, t, 0)].Position;
+                const glm::vec3& p1 = geometry.Vertices[data.GetTriangleIndex(meshlet, t, 1)].Position;
+                const glm::vec3& p2 = geometry.Vertices[data.GetTriangleIndex(meshlet, t, 2)].Position;
+                const glm::vec3 n   = glm::cross(p1 - p0, p2 - p0);
+                const float length  = glm::length(n);
+                if (length <= 1e-12f) continue;
+                normals[t] = n / length;
+                axis += normals[t];
+            }
+            const float axisLength = glm::length(axis);
+            if (axisLength <= 1e-6f) return;
+
+            axis /= axisLength;
+            float cutoff = 1.0f;
+            for (const glm::vec3& n : normals) {
+                if (n != glm::vec3(0.0f)) cutoff = std::min(cutoff, glm::dot(axis, n));
+            }
+            meshlet.ConeAxis   = axis;
+            meshlet.ConeCutoff = cutoff;
+            if (cutoff <= 0.0f) return;
+
+            // Move back from the center along the axis until behind every triangle's plane
+            const glm::vec3 center = meshlet.Bounds.GetCenter();
+            float distance         = 0.0f;
+            for (uint32_t t = 0; t < meshlet.TriangleCount; ++t) {
+                if (normals[t] == glm::vec3(0.0f)) continue;
+                const glm::vec3& p0 = geometry.Vertices[data.GetTriangleIndex(meshlet, t, 0)].Position;
+                distance = std::max(distance, glm::dot(center - p0, normals[t]) / glm::dot(axis, normals[t]));
+            }
+            meshlet.ConeApex = center - axis * distance;
+        }
+    }  // namespace
+
+    auto Meshlet::IsBackfacing(const glm::vec3& viewPosition) const -> bool
+    {
+        if (ConeCutoff <= 0.0f) return false;
+
+        // The view must lie in the mirrored cone behind the apex, narrowed by the normals' spread
+        const glm::vec3 toApex = ConeApex - viewPosition;
+        return glm::dot(toApex, ConeAxis) >= glm::length(toApex) * std::sqrt(1.0f - ConeCutoff * ConeCutoff);
+    }
+
+    auto MeshletBuilder::Build(const MeshGeometry& geometry, uint32_t maxVertices, uint32_t maxTriangles)
+            -> MeshletData
+    {
+        MeshletData data;
+        const size_t triangleCount = geometry.Indices.size() / 3;
+        const size_t vertexCount   = geometry.Vertices.size();
+        if (triangleCount == 0 || vertexCount == 0) return data;
+
+        maxVertices  = std::clamp<uint32_t>(maxVertices, 3, 256);
+        maxTriangles = std::max<uint32_t>(maxTriangles, 1);
+        data.Meshlets.reserve(triangleCount / maxTriangles + 1);
+        data.TriangleIndices.reserve(triangleCount * 3);
+
+        // Triangles adjacent to each vertex
+        std::vector<uint32_t> offsets(vertexCount + 1, 0);
+        for (size_t i = 0; i < triangleCount * 3; ++i) ++offsets[geometry.Indices[i] + 1];
+        for (size_t v = 0; v < vertexCount; ++v) offsets[v + 1] += offsets[v];
+        std::vector<uint32_t> adjacency(triangleCount * 3);
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (uint32_t t = 0; t < triangleCount; ++t) {
+            for (int k = 0; k < 3; ++k) adjacency[fill[geometry.Indices[3 * t + k]]++] = t;
+        }
+
+        std::vector<uint32_t> localIndex(vertexCount, kNoLocalIndex);
+        std::vector<uint8_t> assigned(triangleCount, 0);
+        std::vector<glm::vec3> normals;
+        Meshlet current;
+
+        const auto countNewVertices = [&](uint32_t triangle) {
+            const uint32_t* corners = &geometry.Indices[3 * triangle];
+            uint32_t count          = 0;
+            for (int k = 0; k < 3; ++k) {
+                const bool repeated = (k > 0 && corners[k] == corners[0]) || (k > 1 && corners[k] == corners[1]);
+                if (localIndex[corners[k]] == kNoLocalIndex && !repeated) ++count;
+            }
+            return count;
+        };
+
+        const auto finishMeshlet = [&] {
+            if (current.TriangleCount == 0) return;
+            ComputeMeshletBounds(geometry, data, current, normals);
+            for (uint32_t i = 0; i < current.VertexCount; ++i) {
+                localIndex[data.VertexIndices[current.VertexOffset + i]] = kNoLocalIndex;
+            }
+            data.Meshlets.push_back(current);
+            current                = Meshlet{};
+            current.VertexOffset   = static_cast<uint32_t>(data.VertexIndices.size());
+            current.TriangleOffset = static_cast<uint32_t>(data.TriangleIndices.size());
+        };
+
+        size_t cursor = 0;
+        for (size_t emitted = 0; emitted < triangleCount;) {
+            // Prefer the unassigned neighbour that adds the fewest vertices
+            int64_t best     = -1;
+            uint32_t bestNew = 4;
+            for (uint32_t i = 0; i < current.VertexCount && bestNew > 0; ++i) {
+                const uint32_t v = data.VertexIndices[current.VertexOffset + i];
+                for (uint32_t a = offsets[v]; a < offsets[v + 1]; ++a) {
+                    if (assigned[adjacency[a]]) continue;
+                    const uint32_t added = countNewVertices(adjacency[a]);
+                    if (added < bestNew) {
+                        best    = adjacency[a];
+                        bestNew = added;
+                        if (added == 0) break;
+                    }
+                }
+            }
+            if (best < 0) {
+                while (assigned[cursor]) ++cursor;
+                best    = static_cast<int64_t>(cursor);
+                bestNew = countNewVertices(static_cast<uint32_t>(cursor));
+            }
+
+            if (current.VertexCount + bestNew > maxVertices || current.TriangleCount + 1 > maxTriangles) {
+                finishMeshlet();
+                continue;
+            }
+
+            const uint32_t triangle = static_cast<uint32_t>(best);
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t v = geometry.Indices[3 * triangle + k];
+                if (localIndex[v] == kNoLocalIndex) {
+                    localIndex[v] = current.VertexCount++;
+                    data.VertexIndices.push_back(v);
+                }
+                data.TriangleIndices.push_back(static_cast<uint8_t>(localIndex[v]));
+            }
+            assigned[triangle] = 1;
+            ++current.TriangleCount;
+            ++emitted;
+        }
+        finishMeshlet();
+        return data;
+    }
+}  // namespace Vlkrt
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Scene.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Vlkrt
+{
+    /// <summary>
+    /// A cluster of up to MeshletBuilder::kMaxVertices vertices and kMaxTriangles triangles of one geometry, with
+    /// object-space bounds and a normal cone for coarse culling.
+    /// </summary>
+    struct Meshlet
+    {
+        uint32_t VertexOffset{ 0 };    // Into MeshletData::VertexIndices
+        uint32_t TriangleOffset{ 0 };  // Into MeshletData::TriangleIndices, in indices (3 per triangle)
+        uint32_t VertexCount{ 0 };
+        uint32_t TriangleCount{ 0 };
+        AABB Bounds;
+
+        // Every triangle normal lies within acos(ConeCutoff) of ConeAxis. A cutoff <= 0 means the normals spread too
+        // far for the cone to reject anything.
+        glm::vec3 ConeAxis{ 0.0f, 0.0f, 1.0f };
+        float ConeCutoff{ -1.0f };
+        glm::vec3 ConeApex{ 0.0f };  // Every triangle's plane faces away from points behind the apex along the axis
+
+        // True if every triangle is back-facing from viewPosition (object space)
+        auto IsBackfacing(const glm::vec3& viewPosition) const -> bool;
+    };
+
+    /// <summary>
+    /// Meshlets of one geometry. A meshlet's triangles index its vertex range with 8-bit local indices, which map
+    /// back to geometry vertices through VertexIndices.
+    /// </summary>
+    struct MeshletData
+    {
+        std::vector<Meshlet> Meshlets;
+        std::vector<uint32_t> VertexIndices;
+        std::vector<uint8_t> TriangleIndices;
+
+        // Geometry vertex index of a meshlet triangle's corner
+        auto GetTriangleIndex(const Meshlet& meshlet, uint32_t triangle, uint32_t corner) const -> uint32_t
+        {
+            const uint8_t local = TriangleIndices[meshlet.TriangleOffset + 3 * triangle + corner];
+            return VertexIndices[meshlet.VertexOffset + local];
+        }
+    };
+
+    /// <summary>
+    /// Splits geometry into meshlets. Triangles are taken greedily: each meshlet grows by the adjacent triangle that
+    /// adds the fewest new vertices, and a new meshlet starts from the next unassigned triangle in index order, so the
+    /// result is best on geometry already in vertex cache order (see MeshOptimizer).
+    /// </summary>
+    class MeshletBuilder
+    {
+    public:
+        static constexpr uint32_t kMaxVertices  = 64;
+        static constexpr uint32_t kMaxTriangles = 124;
+
+        // maxVertices is capped at 256 by the 8-bit local indices
+        static auto Build(const MeshGeometry& geometry, uint32_t maxVertices = kMaxVertices,
+                uint32_t maxTriangles = kMaxTriangles) -> MeshletData;
+    };
+}  // namespace Vlkrt
@@ -0,0 +1,293 @@
+#include "ObjParser.h"
+#include "MappedFile.h"
+#include "ThreadPool.h"
+
+#include "Walnut/Core/Log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+
+namespace Vlkrt
+{
+    namespace
+    {
+        // Negative (relative) indices can only be resolved once the attribute counts of earlier chunks are known, so
+        // chunks store them as kRelativeBase + chunk-local index. Absolute indices are stored 0-based, absent as -1.
+        constexpr int32_t kRelativeBase = INT32_MIN / 2;
+
+        struct ObjChunk
+        {
+            std::vector<glm::vec3> Positions;
+            std::vector<glm::vec3> Normals;
+            std::vector<glm::vec2> TexCoords;
+            std::vector<ObjData::Corner> Corners;
+            std::vector<int32_t> TriangleMaterials;  // Into MaterialUses; -1 before this chunk's first usemtl
+            std::vector<std::string> MaterialUses;
+            bool HasFacesBeforeUse{ false };  // Faces that take their material from an earlier chunk
+            uint32_t MalformedLines{ 0 };
+        };
+
+        static auto IsSpace(char c) -> bool { return c == ' ' || c == '\t' || c == '\r'; }
+
+        // Cursor over a single line, without the trailing newline
+        struct LineCursor
+        {
+            const char* Ptr;
+            const char* End;
+
+            void SkipSpaces()
+            {
+                while (Ptr < End && IsSpace(*Ptr)) ++Ptr;
+            }
+
+            auto AtEnd() -> bool
+            {
+                SkipSpaces();
+                return Ptr >= End;
+            }
+
+            auto ReadFloat(float& out) -> bool
+            {
+                SkipSpaces();
+                if (Ptr < End && *Ptr == '+') ++Ptr;  // from_chars rejects an explicit plus sign
+                auto [next, ec] = std::from_chars(Ptr, End, out);
+                if (ec != std::errc()) return false;
+                Ptr = next;
+                return true;
+            }
+
+            auto ReadToken() -> std::string_view
+            {
+                SkipSpaces();
+                const char* begin = Ptr;
+                while (Ptr < End && !IsSpace(*Ptr)) ++Ptr;
+                return { begin, static_cast<size_t>(Ptr - begin) };
+            }
+
+            auto ReadRest() -> std::string_view
+            {
+                SkipSpaces();
+                const char* end = End;
+                while (end > Ptr && IsSpace(end[-1])) --end;
+                return { Ptr, static_cast<size_t>(end - Ptr) };
+            }
+        };
+
+        // One index of a face corner: 1-based absolute, or negative relative to the current attribute count
+        static auto ParseIndex(const char*& ptr, const char* end, size_t localCount, int32_t& out) -> bool
+        {
+            int32_t value = 0;
+            auto [next, ec] = std::from_chars(ptr, end, value);
+            if (ec != std::errc() || value == 0) return false;
+            ptr = next;
+            out = value > 0 ? value - 1 : kRelativeBase + static_cast<int32_t>(localCount) + value;
+            return true;
+        }
+
+        // v, v/t, v//n, v/t/n, or v/t/ (an empty trailing normal, as some exporters write)
+        static auto ParseCorner(std::string_view token, const ObjChunk& chunk, ObjData::Corner& out) -> bool
+        {
+            const char* ptr = token.data();
+            const char* end = token.data() + token.size();
+            if (!ParseIndex(ptr, end, chunk.Positions.size(), out.Position)) return false;
+            if (ptr == end) return true;
+            if (*ptr++ != '/') return false;
+            if (ptr < end && *ptr != '/' && !ParseIndex(ptr, end, chunk.TexCoords.size(), out.TexCoord)) return false;
+            if (ptr == end) return true;
+            if (*ptr++ != '/') return false;
+            if (ptr == end) return true;
+            return ParseIndex(ptr, end, chunk.Normals.size(), out.Normal) && ptr == end;
+        }
+
+        static void ParseChunk(const char* begin, const char* end, ObjChunk& chunk)
+        {
+            std::vector<ObjData::Corner> polygon;
+            int32_t currentMaterial = -1;
+
+            for (const char* line = begin; line < end;) {
+                const char* newline = static_cast<const char*>(std::memchr(line, '\n', end - line));
+                const char* lineEnd = newline ? newline : end;
+                LineCursor cursor{ line, lineEnd };
+                line = newline ? newline + 1 : end;
+
+                const std::string_view keyword = cursor.ReadToken();
+                if (keyword.empty() || keyword[0] == '#') continue;
+
+                if (keyword == "v") {
+                    // Malformed entries are kept (as zero) so that later indices still line up
+                    glm::vec3& p = chunk.Positions.emplace_back(0.0f);
+                    if (!cursor.ReadFloat(p.x) || !cursor.ReadFloat(p.y) || !cursor.ReadFloat(p.z))
+                        ++chunk.MalformedLines;
+                }
+                else if (keyword == "vn") {
+                    glm::vec3& n = chunk.Normals.emplace_back(0.0f);
+                    if (!cursor.ReadFloat(n.x) || !cursor.ReadFloat(n.y) || !cursor.ReadFloat(n.z))
+                        ++chunk.MalformedLines;
+                }
+                else if (keyword == "vt") {
+                    glm::vec2& t = chunk.TexCoords.emplace_back(0.0f);
+                    if (!cursor.ReadFloat(t.x)) ++chunk.MalformedLines;
+                    if (!cursor.AtEnd()) cursor.ReadFloat(t.y);  // v is optional
+                }
+                else if (keyword == "f") {
+                    polygon.clear();
+                    bool valid = true;
+                    while (valid && !cursor.AtEnd()) {
+                        valid = ParseCorner(cursor.ReadToken(), chunk, polygon.emplace_back());
+                    }
+                    if (!valid || polygon.size() < 3) {
+                        ++chunk.MalformedLines;
+                        continue;
+                    }
+
+                    chunk.HasFacesBeforeUse |= currentMaterial < 0;
+                    for (size_t i = 1; i + 1 < polygon.size(); ++i) {
+                        chunk.Corners.push_back(polygon[0]);
+                        chunk.Corners.push_back(polygon[i]);
+                        chunk.Corners.push_back(polygon[i + 1]);
+                        chunk.TriangleMaterials.push_back(currentMaterial);
+                    }
+                }
+                else if (keyword == "usemtl") {
+                    currentMaterial = static_cast<int32_t>(chunk.MaterialUses.size());
+                    chunk.MaterialUses.emplace_back(cursor.ReadRest());
+                }
+            }
+        }
+
+        // Turns a chunk-relative index into a file-wide one; out-of-range references become absent
+        static auto ResolveIndex(int32_t index, size_t chunkFirst, size_t total, uint32_t& outOfRange) -> int32_t
+        {
+            if (index == -1) return -1;
+            const int64_t resolved = index < -1 ? static_cast<int64_t>(chunkFirst) + (index - kRelativeBase) : index;
+            if (resolved < 0 || resolved >= static_cast<int64_t>(total)) {
+                ++outOfRange;
+                return -1;
+            }
+            return static_cast<int32_t>(resolved);
+        }
+    }  // namespace
+
+    auto ObjParser::Parse(const std::filesystem::path& path, ObjData& outData) -> bool
+    {
+        outData = ObjData{};
+
+        MappedFile file;
+        if (!file.Open(path)) {
+            WL_ERROR_TAG("ObjParser", "Failed to open OBJ file '{}'", path.string());
+            return false;
+        }
+
+        // Split into line-aligned chunks, a few per thread so that uneven chunks still balance
+        const char* data      = reinterpret_cast<const char*>(file.GetData());
+        const size_t size     = file.GetSize();
+        const size_t maxCount = (ThreadPool::Get().GetThreadCount() + 1) * 4;
+        const size_t target   = std::clamp<size_t>(size / kMinChunkBytes, 1, maxCount);
+
+        std::vector<std::pair<size_t, size_t>> ranges;
+        for (size_t begin = 0; begin < size;) {
+            size_t end = std::min(size, begin + size / target);
+            if (end < size) {
+                const void* newline = std::memchr(data + end, '\n', size - end);
+                end = newline ? static_cast<size_t>(static_cast<const char*>(newline) - data) + 1 : size;
+            }
+            ranges.emplace_back(begin, end);
+            begin = end;
+        }
+
+        std::vector<ObjChunk> chunks(ranges.size());
+        ThreadPool::Get().ParallelFor(chunks.size(), [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                ParseChunk(data + ranges[i].first, data + ranges[i].second, chunks[i]);
+            }
+        });
+
+        // File-wide offset of every chunk's attributes, corners and triangles
+        struct ChunkOffsets
+        {
+            size_t Position{ 0 }, Normal{ 0 }, TexCoord{ 0 }, Corner{ 0 };
+        };
+        std::vector<ChunkOffsets> offsets(chunks.size() + 1);
+        uint32_t malformedLines = 0;
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            offsets[i + 1].Position = offsets[i].Position + chunks[i].Positions.size();
+            offsets[i + 1].Normal   = offsets[i].Normal + chunks[i].Normals.size();
+            offsets[i + 1].TexCoord = offsets[i].TexCoord + chunks[i].TexCoords.size();
+            offsets[i + 1].Corner   = offsets[i].Corner + chunks[i].Corners.size();
+            malformedLines += chunks[i].MalformedLines;
+        }
+
+        const ChunkOffsets& totals = offsets.back();
+        outData.Positions.resize(totals.Position);
+        outData.Normals.resize(totals.Normal);
+        outData.TexCoords.resize(totals.TexCoord);
+        outData.Corners.resize(totals.Corner);
+        outData.TriangleMaterials.resize(totals.Corner / 3);
+
+        // Materials: chunks only know their own usemtl names, and faces before a chunk's first usemtl continue the
+        // previous chunk's material. Cheap, so resolved serially.
+        bool hasUnnamedFaces = false;
+        for (const auto& chunk : chunks) {
+            hasUnnamedFaces |= chunk.HasFacesBeforeUse;
+            if (!chunk.MaterialUses.empty()) break;
+        }
+
+        std::unordered_map<std::string, uint32_t> materialSlots;
+        if (hasUnnamedFaces) {
+            outData.MaterialNames.emplace_back();
+            materialSlots.emplace("", 0);
+        }
+        std::vector<std::vector<uint32_t>> chunkSlots(chunks.size());
+        std::vector<uint32_t> inheritedSlot(chunks.size(), 0);
+        uint32_t currentSlot = 0;
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            inheritedSlot[i] = currentSlot;
+            for (const auto& name : chunks[i].MaterialUses) {
+                const auto nextSlot = static_cast<uint32_t>(outData.MaterialNames.size());
+                auto [it, inserted] = materialSlots.try_emplace(name, nextSlot);
+                if (inserted) outData.MaterialNames.push_back(name);
+                chunkSlots[i].push_back(it->second);
+            }
+            if (!chunkSlots[i].empty()) currentSlot = chunkSlots[i].back();
+        }
+
+        std::atomic<uint32_t> outOfRange{ 0 };
+        ThreadPool::Get().ParallelFor(chunks.size(), [&](size_t first, size_t last) {
+            uint32_t localOutOfRange = 0;
+            for (size_t i = first; i < last; ++i) {
+                ObjChunk& chunk            = chunks[i];
+                const ChunkOffsets& offset = offsets[i];
+                std::copy(chunk.Positions.begin(), chunk.Positions.end(), outData.Positions.begin() + offset.Position);
+                std::copy(chunk.Normals.begin(), chunk.Normals.end(), outData.Normals.begin() + offset.Normal);
+                std::copy(chunk.TexCoords.begin(), chunk.TexCoords.end(), outData.TexCoords.begin() + offset.TexCoord);
+
+                ObjData::Corner* corners = outData.Corners.data() + offset.Corner;
+                for (size_t c = 0; c < chunk.Corners.size(); ++c) {
+                    const ObjData::Corner& in = chunk.Corners[c];
+                    corners[c].Position = ResolveIndex(in.Position, offset.Position, totals.Position, localOutOfRange);
+                    corners[c].Normal   = ResolveIndex(in.Normal, offset.Normal, totals.Normal, localOutOfRange);
+                    corners[c].TexCoord = ResolveIndex(in.TexCoord, offset.TexCoord, totals.TexCoord, localOutOfRange);
+                }
+
+                uint32_t* triangleMaterials = outData.TriangleMaterials.data() + offset.Corner / 3;
+                for (size_t t = 0; t < chunk.TriangleMaterials.size(); ++t) {
+                    const int32_t use    = chunk.TriangleMaterials[t];
+                    triangleMaterials[t] = use >= 0 ? chunkSlots[i][use] : inheritedSlot[i];
+                }
+
+                chunk = ObjChunk{};
+            }
+            outOfRange += localOutOfRange;
+        });
+
+        if (malformedLines > 0 || outOfRange > 0) {
+            WL_WARN_TAG("ObjParser", "OBJ file '{}': skipped {} malformed lines, {} out-of-range indices",
+                    path.string(), malformedLines, outOfRange.load());
+        }
+        return true;
+    }
+}  // namespace Vlkrt
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Vlkrt
+{
+    /// <summary>
+    /// Raw contents of an OBJ file: the attribute arrays, and three corners per triangle indexing into them.
+    /// </summary>
+    struct ObjData
+    {
+        // 0-based attribute indices, -1 when the corner does not reference that attribute
+        struct Corner
+        {
+            int32_t Position{ -1 };
+            int32_t Normal{ -1 };
+            int32_t TexCoord{ -1 };
+        };
+
+        std::vector<glm::vec3> Positions;
+        std::vector<glm::vec3> Normals;
+        std::vector<glm::vec2> TexCoords;
+        std::vector<Corner> Corners;              // Polygons are fan-triangulated
+        std::vector<uint32_t> TriangleMaterials;  // Slot into MaterialNames per triangle
+        // usemtl names in order of first use. Faces before the first usemtl get a leading unnamed slot, so a file that
+        // uses a single material always maps every triangle to slot 0.
+        std::vector<std::string> MaterialNames;
+    };
+
+    /// <summary>
+    /// OBJ reader. Memory-maps the file, splits it into line-aligned chunks, parses those in parallel on the
+    /// ThreadPool (numbers via std::from_chars, no per-token allocation) and stitches them back together in file
+    /// order, resolving negative (relative) indices and usemtl state across chunk boundaries.
+    /// Reads v, vt, vn, f and usemtl; other statements (o, g, s, mtllib, lines, points) are skipped.
+    /// </summary>
+    class ObjParser
+    {
+    public:
+        // Files smaller than this are parsed as a single chunk
+        static constexpr size_t kMinChunkBytes = 1 << 20;
+
+        // Returns false and logs the reason if the file cannot be read.
+        static auto Parse(const std::filesystem::path& path, ObjData& outData) -> bool;
+    };
+}  // namespace Vlkrt
@@ -4,6 +4,9 @@
 #include "ShaderLoader.h"
 #include "Utils.h"
 #include "FSRUpscaler.h"
+#include "TextureLoader.h"
+#include "TextureStreamer.h"
+#include "VertexPacking.h"
 
 #include "Walnut/Application.h"
 #include "Walnut/VulkanRayTracing.h"
@@ -14,16 +17,25 @@
 #include <cstring>
 #include <chrono>
 #include <filesystem>
+#include <map>
+#include <unordered_set>
 #include <glm/gtc/type_ptr.hpp>
 #include <stdexcept>
 
-#include <stb_image.h>
-
 namespace Vlkrt
 {
     namespace
     {
         static constexpr uint32_t kMaxSceneTextures = 256;
+        // Textures a scene needs that are not resident are first loaded with mips up to this size only, and textures
+        // the view stops sampling are paged back out to them
+        static constexpr uint32_t kPartialTextureDimension = 128;
+        // Textures whose finer mips are requested per frame from mip feedback
+        static constexpr size_t kMaxTexturePageInsPerFrame = 4;
+        // Geometry staging larger than this is released after the upload that needed it, e.g. a scene's first one
+        static constexpr VkDeviceSize kRetainedGeometryStagingBytes = 16ull * 1024 * 1024;
+        // Vertex size before the compact GPUVertex: float3 position and normal and float2 UV, each padded to 16 bytes
+        static constexpr uint64_t kPaddedVertexBytes = 48;
 
         static auto BytesPerPixel(Walnut::ImageFormat format) -> uint64_t
         {
@@ -51,6 +63,7 @@ namespace Vlkrt
         m_Device                = Walnut::Application::GetDevice();
         m_RTPipelineProperties  = Walnut::Application::GetRayTracingPipelineProperties();
         m_AccelerationStructure = std::make_unique<AccelerationStructure>();
+        m_TextureStreamer       = std::make_unique<TextureStreamer>();
         m_NRDDenoiser.Initialize(m_Device);
 
         m_FSRUpscaler = std::make_unique<FSRUpscaler>();
@@ -86,9 +99,9 @@ namespace Vlkrt
             vkFreeMemory(m_Device, m_VertexMemory, nullptr);
         }
 
-        if (m_PrevVertexBuffer != VK_NULL_HANDLE) {
-            vkDestroyBuffer(m_Device, m_PrevVertexBuffer, nullptr);
-            vkFreeMemory(m_Device, m_PrevVertexMemory, nullptr);
+        if (m_InstanceBuffer != VK_NULL_HANDLE) {
+            vkDestroyBuffer(m_Device, m_InstanceBuffer, nullptr);
+            vkFreeMemory(m_Device, m_InstanceMemory, nullptr);
         }
 
         if (m_IndexBuffer != VK_NULL_HANDLE) {
@@ -111,14 +124,10 @@ namespace Vlkrt
             vkFreeMemory(m_Device, m_LightMemory, nullptr);
         }
 
-        if (m_AABBTransformBuffer != VK_NULL_HANDLE) {
-            vkDestroyBuffer(m_Device, m_AABBTransformBuffer, nullptr);
-            vkFreeMemory(m_Device, m_AABBTransformMemory, nullptr);
-        }
-
-        if (m_PrevAABBTransformBuffer != VK_NULL_HANDLE) {
-            vkDestroyBuffer(m_Device, m_PrevAABBTransformBuffer, nullptr);
-            vkFreeMemory(m_Device, m_PrevAABBTransformMemory, nullptr);
+        for (uint32_t i = 0; i < 2; ++i) {
+            if (m_AABBTransformBuffers[i] == VK_NULL_HANDLE) continue;
+            vkDestroyBuffer(m_Device, m_AABBTransformBuffers[i], nullptr);
+            vkFreeMemory(m_Device, m_AABBTransformMemory[i], nullptr);
         }
 
         if (m_AABBMaterialBuffer != VK_NULL_HANDLE) {
@@ -136,6 +145,11 @@ namespace Vlkrt
             vkFreeMemory(m_Device, m_QualityMetricsMemory, nullptr);
         }
 
+        if (m_TextureFeedbackBuffer != VK_NULL_HANDLE) {
+            vkDestroyBuffer(m_Device, m_TextureFeedbackBuffer, nullptr);
+            vkFreeMemory(m_Device, m_TextureFeedbackMemory, nullptr);
+        }
+
         if (m_DescriptorPool != VK_NULL_HANDLE) vkDestroyDescriptorPool(m_Device, m_DescriptorPool, nullptr);
 
         if (m_DescriptorSetLayout != VK_NULL_HANDLE)
@@ -160,8 +174,7 @@ namespace Vlkrt
         if (m_ComposeDenoisedShader != VK_NULL_HANDLE)
             vkDestroyShaderModule(m_Device, m_ComposeDenoisedShader, nullptr);
 
-        m_PreviousFrameVertices.clear();
-        m_PreviousFrameAABBTransforms.clear();
+        DestroyGeometryStaging();
     }
 
     void Renderer::OnFSRSettingsChanged(bool enabled, uint32_t qualityMode, float sharpness)
@@ -237,6 +250,13 @@ namespace Vlkrt
                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_QualityMetricsMemory);
         }
 
+        if (m_TextureFeedbackBuffer == VK_NULL_HANDLE) {
+            m_TextureFeedbackBuffer = CreateBuffer(sizeof(uint32_t) * kMaxSceneTextures,
+                    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                    m_TextureFeedbackMemory);
+        }
+
         // Update output image bindings
         if (m_DescriptorSet != VK_NULL_HANDLE) {
             VkDescriptorImageInfo outputInfo{};
@@ -247,7 +267,7 @@ namespace Vlkrt
             accumInfo.imageView   = m_AccumImage->GetVkImageView();
             accumInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
 
-            VkWriteDescriptorSet writes[13] = {};
+            VkWriteDescriptorSet writes[14] = {};
             writes[0].sType                 = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
             writes[0].dstSet                = m_DescriptorSet;
             writes[0].dstBinding            = 1;
@@ -362,7 +382,20 @@ namespace Vlkrt
             writes[12].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
             writes[12].pImageInfo      = &referenceInfo;
 
-            vkUpdateDescriptorSets(m_Device, 13, writes, 0, nullptr);
+            // Texture mip feedback buffer (binding 25)
+            VkDescriptorBufferInfo feedbackInfo{};
+            feedbackInfo.buffer = m_TextureFeedbackBuffer;
+            feedbackInfo.offset = 0;
+            feedbackInfo.range  = sizeof(uint32_t) * kMaxSceneTextures;
+
+            writes[13].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[13].dstSet          = m_DescriptorSet;
+            writes[13].dstBinding      = 25;
+            writes[13].descriptorCount = 1;
+            writes[13].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[13].pBufferInfo     = &feedbackInfo;
+
+            vkUpdateDescriptorSets(m_Device, 14, writes, 0, nullptr);
         }
 
         // Update NRD denoiser with the new guide buffers
@@ -422,85 +455,59 @@ namespace Vlkrt
             CreateRayTracingPipeline();
             CreateShaderBindingTable(scene);
             m_LastProceduralCount = proceduralCount;
-        }
 
-        // Recalculate scene metrics each frame (cheap) to robustly detect structural changes.
-        {
-            size_t totalMeshCount = scene.StaticMeshes.size() + scene.DynamicMeshes.size();
-            size_t totalVertices  = 0;
-            size_t totalIndices   = 0;
-            for (const auto& mesh : scene.StaticMeshes) {
-                totalVertices += mesh.Vertices.size();
-                totalIndices += mesh.Indices.size();
+            // The scene buffers are created below the first time; after that, only the procedural ones need to grow
+            if (m_SceneUBOBuffer != VK_NULL_HANDLE
+                    && sizeof(AABBTransform) * proceduralCount > m_AABBTransformBufferSize) {
+                CreateProceduralBuffers(scene);
+                m_SceneDataDirty = true;
             }
-            for (const auto& mesh : scene.DynamicMeshes) {
-                totalVertices += mesh.Vertices.size();
-                totalIndices += mesh.Indices.size();
-            }
-            m_CachedTotalMeshCount = totalMeshCount;
-            m_CachedTotalVertices  = totalVertices;
-            m_CachedTotalIndices   = totalIndices;
         }
 
-        // Rebuild scene buffers if the scene structure has changed
-        bool sizeChanged = (m_CachedTotalMeshCount != m_LastMeshCount) || (m_CachedTotalVertices != m_LastVertexCount)
-                           || (m_CachedTotalIndices != m_LastIndexCount)
-                           || (scene.Materials.size() != m_LastMaterialCount);
+        // Recount the scene metrics when the meshes changed, to detect structural changes. The geometry is keyed by
+        // the set of unique geometries, so that more or fewer instances of it (a player joining or leaving) or a mesh
+        // switching LOD do not count as a geometry change.
+        if (!m_HasCachedMeshMetrics || scene.MeshesGeneration != m_CachedMeshMetricsGeneration) {
+            std::unordered_set<const MeshGeometry*> geometries;
+            for (const auto& mesh : scene.StaticMeshes) geometries.insert(mesh.Geometry.get());
+            for (const auto& mesh : scene.DynamicMeshes) geometries.insert(mesh.Geometry.get());
+
+            // Summed, so that the key does not depend on the set's order
+            uint64_t geometrySetKey = geometries.size();
+            for (const MeshGeometry* geometry : geometries) {
+                geometrySetKey += HashBytes(kFNVOffsetBasis, &geometry, sizeof(geometry));
+            }
+            m_CachedTotalMeshCount        = scene.StaticMeshes.size() + scene.DynamicMeshes.size();
+            m_CachedGeometrySetKey        = geometrySetKey;
+            m_CachedMeshMetricsGeneration = scene.MeshesGeneration;
+            m_HasCachedMeshMetrics        = true;
+        }
+
+        // Refresh the scene data if the scene structure has changed. The geometry and instance buffers are not
+        // recreated here: UpdateSceneData appends what is new to them.
+        bool sizeChanged = (m_CachedTotalMeshCount != m_LastMeshCount)
+                           || (m_CachedGeometrySetKey != m_LastGeometrySetKey)
+                           || (scene.Materials.size() != m_LastMaterialCount)
+                           || (scene.Lights.size() != m_LastLightCount);
         bool resetBySceneChange = false;
         bool needsRebuild       = !m_SceneValid || sizeChanged;
-        if (m_VertexBuffer == VK_NULL_HANDLE || needsRebuild) {
-            if (needsRebuild && m_VertexBuffer != VK_NULL_HANDLE) {
-                if (m_CachedTotalMeshCount != m_LastMeshCount || m_CachedTotalVertices != m_LastVertexCount
-                        || m_CachedTotalIndices != m_LastIndexCount) {
-                    Walnut::Application::SubmitResourceFree(
-                            [device = m_Device, vbuf = m_VertexBuffer, vmem = m_VertexMemory, ibuf = m_IndexBuffer,
-                                    imem = m_IndexMemory, mibuf = m_MaterialIndexBuffer,
-                                    mimem = m_MaterialIndexMemory]() {
-                                if (vbuf) vkDestroyBuffer(device, vbuf, nullptr);
-                                if (vmem) vkFreeMemory(device, vmem, nullptr);
-                                if (ibuf) vkDestroyBuffer(device, ibuf, nullptr);
-                                if (imem) vkFreeMemory(device, imem, nullptr);
-                                if (mibuf) vkDestroyBuffer(device, mibuf, nullptr);
-                                if (mimem) vkFreeMemory(device, mimem, nullptr);
-                            });
-                    m_VertexBuffer        = VK_NULL_HANDLE;
-                    m_IndexBuffer         = VK_NULL_HANDLE;
-                    m_MaterialIndexBuffer = VK_NULL_HANDLE;
-                }
-                if (scene.Materials.size() != m_LastMaterialCount) {
-                    Walnut::Application::SubmitResourceFree(
-                            [device = m_Device, buf = m_MaterialBuffer, mem = m_MaterialMemory]() {
-                                if (buf) vkDestroyBuffer(device, buf, nullptr);
-                                if (mem) vkFreeMemory(device, mem, nullptr);
-                            });
-                    m_MaterialBuffer = VK_NULL_HANDLE;
-                }
-                if (scene.Lights.size() != m_LastLightCount) {
-                    Walnut::Application::SubmitResourceFree(
-                            [device = m_Device, buf = m_LightBuffer, mem = m_LightMemory]() {
-                                if (buf) vkDestroyBuffer(device, buf, nullptr);
-                                if (mem) vkFreeMemory(device, mem, nullptr);
-                            });
-                    m_LightBuffer     = VK_NULL_HANDLE;
-                    m_LightMemory     = VK_NULL_HANDLE;
-                    size_t lightCount = std::max(scene.Lights.size(), (size_t) 1);
-                    m_LightBufferSize = sizeof(GPULight) * lightCount;
-                    m_LightBuffer     = CreateBuffer(m_LightBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-                            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_LightMemory);
-                }
+        if (m_SceneUBOBuffer == VK_NULL_HANDLE || needsRebuild) {
+            if (m_SceneUBOBuffer == VK_NULL_HANDLE) {
+                CreateSceneBuffers(scene);
+            }
+            else {
+                if (scene.Materials.size() != m_LastMaterialCount) CreateMaterialBuffer(scene);
+                if (scene.Lights.size() != m_LastLightCount) CreateLightBuffer(scene);
             }
-
-            if (m_VertexBuffer == VK_NULL_HANDLE) CreateSceneBuffers(scene);
 
             // Structural rebuild requires scene data upload and AS/descriptor refresh.
             m_SceneDataDirty = true;
 
-            m_LastMeshCount     = m_CachedTotalMeshCount;
-            m_LastVertexCount   = m_CachedTotalVertices;
-            m_LastIndexCount    = m_CachedTotalIndices;
-            m_LastMaterialCount = scene.Materials.size();
-            m_LastLightCount    = scene.Lights.size();
-            m_SceneValid        = true;
+            m_LastMeshCount      = m_CachedTotalMeshCount;
+            m_LastGeometrySetKey = m_CachedGeometrySetKey;
+            m_LastMaterialCount  = scene.Materials.size();
+            m_LastLightCount     = scene.Lights.size();
+            m_SceneValid         = true;
 
             if (sizeChanged) {
                 m_AccumFirstFrame  = true;
@@ -509,87 +516,48 @@ namespace Vlkrt
             }
         }
 
-        auto hashCombine = [](uint64_t& seed, uint64_t value) {
-            seed ^= value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
-        };
-        auto quantize = [](float v) -> int32_t { return static_cast<int32_t>(std::round(v * 10000.0f)); };
-        auto hashVec3 = [&](uint64_t& seed, const glm::vec3& v) {
-            hashCombine(seed, static_cast<uint64_t>(quantize(v.x)));
-            hashCombine(seed, static_cast<uint64_t>(quantize(v.y)));
-            hashCombine(seed, static_cast<uint64_t>(quantize(v.z)));
-        };
-        auto hashMat4 = [&](uint64_t& seed, const glm::mat4& m) {
-            for (int c = 0; c < 4; ++c) {
-                for (int r = 0; r < 4; ++r) { hashCombine(seed, static_cast<uint64_t>(quantize(m[c][r]))); }
-            }
+        // Content changes are detected by the scene's generations, so an unchanged frame does no per-object work
+        const SceneGenerations generations = {
+            scene.MeshesGeneration, scene.MaterialsGeneration, scene.LightsGeneration, scene.ProceduralsGeneration
         };
-
-        uint64_t sceneSignature = 1469598103934665603ull;
-        hashCombine(sceneSignature, static_cast<uint64_t>(scene.StaticMeshes.size()));
-        hashCombine(sceneSignature, static_cast<uint64_t>(scene.DynamicMeshes.size()));
-        hashCombine(sceneSignature, static_cast<uint64_t>(scene.ProceduralEntities.size()));
-        hashCombine(sceneSignature, static_cast<uint64_t>(scene.Materials.size()));
-        hashCombine(sceneSignature, static_cast<uint64_t>(scene.Lights.size()));
-
-        // Hash material properties to detect when materials change (not just count)
-        for (const auto& mat : scene.Materials) {
-            hashVec3(sceneSignature, mat.Albedo);
-            hashVec3(sceneSignature, mat.Emission);
-            hashCombine(sceneSignature, static_cast<uint64_t>(quantize(mat.Roughness)));
-            hashCombine(sceneSignature, static_cast<uint64_t>(quantize(mat.Metallic)));
-            hashCombine(sceneSignature, static_cast<uint64_t>(quantize(mat.Subsurface)));
-            hashCombine(sceneSignature, static_cast<uint64_t>(quantize(mat.Anisotropic)));
-            hashCombine(sceneSignature, static_cast<uint64_t>(quantize(mat.SpecularTint)));
-            hashCombine(sceneSignature, static_cast<uint64_t>(quantize(mat.SpecularTransmission)));
-            hashCombine(sceneSignature, static_cast<uint64_t>(quantize(mat.ClearcoatGloss)));
-            hashCombine(sceneSignature, static_cast<uint64_t>(quantize(mat.Clearcoat)));
-            hashCombine(sceneSignature, static_cast<uint64_t>(quantize(mat.Sheen)));
-            hashCombine(sceneSignature, static_cast<uint64_t>(quantize(mat.SheenTint)));
-            hashCombine(sceneSignature, static_cast<uint64_t>(quantize(mat.Eta)));
-        }
-
-        for (const auto& mesh : scene.StaticMeshes) {
-            hashMat4(sceneSignature, mesh.Transform);
-            hashCombine(sceneSignature, static_cast<uint64_t>(mesh.MaterialIndex));
-        }
-        for (const auto& mesh : scene.DynamicMeshes) {
-            hashMat4(sceneSignature, mesh.Transform);
-            hashCombine(sceneSignature, static_cast<uint64_t>(mesh.MaterialIndex));
-        }
-        for (const auto& pe : scene.ProceduralEntities) {
-            hashMat4(sceneSignature, pe.Transform);
-            hashCombine(sceneSignature, static_cast<uint64_t>(pe.MaterialIndex));
-            hashCombine(sceneSignature, static_cast<uint64_t>(pe.IsAnalytic));
-            hashCombine(sceneSignature, static_cast<uint64_t>(pe.PrimitiveType));
-        }
-        for (const auto& light : scene.Lights) {
-            hashVec3(sceneSignature, light.Position);
-            hashVec3(sceneSignature, light.Direction);
-            hashVec3(sceneSignature, light.Emission);
-            hashCombine(sceneSignature, static_cast<uint64_t>(quantize(light.Intensity)));
-            hashCombine(sceneSignature, static_cast<uint64_t>(quantize(light.Size)));
-            hashCombine(sceneSignature, static_cast<uint64_t>(light.Type));
-        }
+        const bool contentChanged = !m_HasUploadedGenerations || generations != m_UploadedGenerations;
 
         // Keep scene-data update separate from structural rebuilds.
         // This allows cheap accumulation resets without forcing full GPU scene rebuild work.
         bool sceneDataUploadedThisFrame = false;
-        if (m_LastUpdatedScene == nullptr || m_LastUpdatedScene != &scene || m_SceneDataDirty) {
-            const bool lightOnlyDirty
-                    = m_SceneDataDirty && !needsRebuild && m_DirtyMeshIndices.empty() && !m_DirtyLightIndices.empty();
+        if (m_LastUpdatedScene == nullptr || m_LastUpdatedScene != &scene || m_SceneDataDirty || contentChanged) {
+            const bool onlyLightsChanged = m_HasUploadedGenerations
+                                           && generations.Meshes == m_UploadedGenerations.Meshes
+                                           && generations.Materials == m_UploadedGenerations.Materials
+                                           && generations.Procedurals == m_UploadedGenerations.Procedurals;
+            const bool lightOnlyDirty = m_SceneDataDirty && !needsRebuild && m_DirtyMeshIndices.empty()
+                                        && !m_DirtyLightIndices.empty() && onlyLightsChanged;
+            // Meshes that moved, switched LOD or changed material over the geometry already uploaded only need their
+            // instance records and the TLAS
+            const bool onlyMeshesChanged = m_HasUploadedGenerations && m_LastUpdatedScene == &scene
+                                           && generations.Meshes != m_UploadedGenerations.Meshes
+                                           && generations.Materials == m_UploadedGenerations.Materials
+                                           && generations.Lights == m_UploadedGenerations.Lights
+                                           && generations.Procedurals == m_UploadedGenerations.Procedurals;
+            const bool instancesOnly = !lightOnlyDirty && !needsRebuild && onlyMeshesChanged
+                                       && m_AccelerationStructure->IsBuilt() && IsGeometryLaidOut(scene);
 
             if (lightOnlyDirty) {
                 UpdateLightBuffer(scene);
-                m_LastSceneSignature = sceneSignature;
-                m_HasSceneSignature  = true;
+                m_UploadedGenerations = generations;
+            }
+
+            if (instancesOnly) {
+                UpdateSceneInstances(scene);
+                sceneDataUploadedThisFrame = true;
+                m_UploadedGenerations      = generations;
             }
 
-            const bool contentChanged = !m_HasSceneSignature || (sceneSignature != m_LastSceneSignature);
-            if (!lightOnlyDirty && (contentChanged || needsRebuild)) {
+            if (!lightOnlyDirty && !instancesOnly && (contentChanged || needsRebuild)) {
                 UpdateSceneData(scene);
                 sceneDataUploadedThisFrame = true;
-                m_LastSceneSignature       = sceneSignature;
-                m_HasSceneSignature        = true;
+                m_UploadedGenerations      = generations;
+                m_HasUploadedGenerations   = true;
             }
             m_LastUpdatedScene = &scene;
             m_SceneDataDirty   = false;
@@ -655,6 +623,24 @@ namespace Vlkrt
                     nullptr, 1, &metricsResetBarrier, 0, nullptr);
         }
 
+        // The hit shaders keep the finest mip level sampled per texture with an atomic min
+        if (m_TextureFeedbackBuffer != VK_NULL_HANDLE) {
+            vkCmdFillBuffer(cmd, m_TextureFeedbackBuffer, 0, sizeof(uint32_t) * kMaxSceneTextures,
+                    TextureFeedback::kNoFeedback);
+
+            VkBufferMemoryBarrier feedbackResetBarrier = { VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER };
+            feedbackResetBarrier.srcAccessMask         = VK_ACCESS_TRANSFER_WRITE_BIT;
+            feedbackResetBarrier.dstAccessMask         = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+            feedbackResetBarrier.srcQueueFamilyIndex   = VK_QUEUE_FAMILY_IGNORED;
+            feedbackResetBarrier.dstQueueFamilyIndex   = VK_QUEUE_FAMILY_IGNORED;
+            feedbackResetBarrier.buffer                = m_TextureFeedbackBuffer;
+            feedbackResetBarrier.offset                = 0;
+            feedbackResetBarrier.size                  = sizeof(uint32_t) * kMaxSceneTextures;
+
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR, 0,
+                    0, nullptr, 1, &feedbackResetBarrier, 0, nullptr);
+        }
+
         // Transition final image to GENERAL layout for shader write
         {
             VkImageMemoryBarrier barrier = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
@@ -791,6 +777,20 @@ namespace Vlkrt
             vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_TimestampQueryPool, 1);
         const auto rtRecordEnd = Clock::now();
 
+        if (m_TextureFeedbackBuffer != VK_NULL_HANDLE) {
+            VkBufferMemoryBarrier feedbackReadbackBarrier = { VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER };
+            feedbackReadbackBarrier.srcAccessMask         = VK_ACCESS_SHADER_WRITE_BIT;
+            feedbackReadbackBarrier.dstAccessMask         = VK_ACCESS_HOST_READ_BIT;
+            feedbackReadbackBarrier.srcQueueFamilyIndex   = VK_QUEUE_FAMILY_IGNORED;
+            feedbackReadbackBarrier.dstQueueFamilyIndex   = VK_QUEUE_FAMILY_IGNORED;
+            feedbackReadbackBarrier.buffer                = m_TextureFeedbackBuffer;
+            feedbackReadbackBarrier.offset                = 0;
+            feedbackReadbackBarrier.size                  = sizeof(uint32_t) * kMaxSceneTextures;
+
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR, VK_PIPELINE_STAGE_HOST_BIT, 0, 0,
+                    nullptr, 1, &feedbackReadbackBarrier, 0, nullptr);
+        }
+
         const bool enableNRDThisFrame = scene.EnableNRDDenoiser && !forceTemporalReferenceCapture;
         m_NRDDenoiser.SetEnabled(enableNRDThisFrame);
         float nrdRecordMs = 0.0f;
@@ -1100,6 +1100,8 @@ namespace Vlkrt
         Walnut::Application::FlushCommandBuffer(cmd);
         const auto submitEnd = Clock::now();
 
+        ReadTextureFeedback();
+
         // Read back GPU timestamps - don't block waiting for results, just skip if not ready yet
         // Only compute deltas for passes that actually wrote their timestamp pair this frame.
         if (m_TimestampQueryPool != VK_NULL_HANDLE) {
@@ -1207,17 +1209,17 @@ namespace Vlkrt
 
         uint64_t estimatedBytes = 0;
         estimatedBytes += static_cast<uint64_t>(m_VertexBufferSize);
-        estimatedBytes += static_cast<uint64_t>(m_PrevVertexBufferSize);
+        estimatedBytes += static_cast<uint64_t>(m_InstanceBufferSize);
         estimatedBytes += static_cast<uint64_t>(m_IndexBufferSize);
         estimatedBytes += static_cast<uint64_t>(m_MaterialBufferSize);
         estimatedBytes += static_cast<uint64_t>(m_MaterialIndexBufferSize);
         estimatedBytes += static_cast<uint64_t>(m_LightBufferSize);
-        estimatedBytes += static_cast<uint64_t>(m_AABBTransformBufferSize);
-        estimatedBytes += static_cast<uint64_t>(m_PrevAABBTransformBufferSize);
+        estimatedBytes += static_cast<uint64_t>(m_AABBTransformBufferSize) * 2;
         estimatedBytes += static_cast<uint64_t>(m_AABBMaterialBufferSize);
         estimatedBytes += static_cast<uint64_t>(sizeof(SceneUBOData));
         estimatedBytes += static_cast<uint64_t>(sizeof(uint32_t) * 6);  // quality metrics buffer
         estimatedBytes += static_cast<uint64_t>(m_SBTBufferSize);
+        estimatedBytes += static_cast<uint64_t>(m_GeometryStagingSize);
 
         estimatedBytes += EstimateImageBytes(m_FinalImage);
         estimatedBytes += EstimateImageBytes(m_AccumImage);
@@ -1232,9 +1234,27 @@ namespace Vlkrt
         estimatedBytes += EstimateImageBytes(m_NRDDenoiser.GetOutDiffRadianceHitDist());
         estimatedBytes += EstimateImageBytes(m_NRDDenoiser.GetOutSpecRadianceHitDist());
 
-        for (const auto& [_, tex] : m_TextureCache) { estimatedBytes += EstimateImageBytes(tex); }
+        estimatedBytes += m_Textures.GetResidentBytes();
 
         m_LastPassStats.EstimatedGraphicsMemoryMB = static_cast<float>(estimatedBytes / (1024.0 * 1024.0));
+        const uint64_t vertexBytesSaved     = (kPaddedVertexBytes - sizeof(GPUVertex)) * m_GeometryVertexCount;
+        m_LastPassStats.VertexBufferMB      = static_cast<float>(m_VertexBufferSize / (1024.0 * 1024.0));
+        m_LastPassStats.VertexBufferSavedMB = static_cast<float>(vertexBytesSaved / (1024.0 * 1024.0));
+        // Only the meshes' previous transforms; previous vertices and procedural transforms stay on the GPU
+        m_LastPassStats.MotionHistoryCpuKB = static_cast<float>(sizeof(glm::mat4) * m_MeshInstances.size() / 1024.0);
+
+        for (const SceneTexture& sceneTexture : m_SceneTextures) m_Textures.MarkUsed(sceneTexture.Handle, m_GlobalTick);
+        const TextureResidency::Stats textureStats = m_Textures.GetStats();
+        m_LastPassStats.TextureResidentMB          = static_cast<float>(textureStats.ResidentBytes / (1024.0 * 1024.0));
+        m_LastPassStats.TextureBudgetMB            = static_cast<float>(textureStats.BudgetBytes / (1024.0 * 1024.0));
+        m_LastPassStats.TexturesResident           = textureStats.ResidentCount;
+        m_LastPassStats.TexturesBound              = textureStats.ReferencedCount;
+        m_LastPassStats.TexturesPartial            = textureStats.PartialCount;
+        m_LastPassStats.TexturesSkipped            = m_SkippedSceneTextures;
+        m_LastPassStats.TexturesEvicted            = textureStats.EvictedCount;
+        m_LastPassStats.TexturesRejected           = textureStats.RejectedCount;
+        m_LastPassStats.TextureMipPageIns          = m_TextureMipPageIns;
+        m_LastPassStats.TextureMipPageOuts         = m_TextureMipPageOuts;
 
         m_FirstFrame = false;
         ++m_FrameIndex;
@@ -1355,6 +1375,8 @@ namespace Vlkrt
         ubo.enableDenoiseMetrics = scene.EnableDenoiseMetrics ? 1u : 0u;
         ubo.fsrEnabled           = m_FSREnabled ? 1u : 0u;
         ubo.useReferenceMetrics  = m_HasDenoiseReference ? 1u : 0u;
+        // Vertical angle one pixel subtends: 2 * tan(fovY / 2) / height
+        ubo.pixelSpreadAngle = 2.0f / (std::abs(camera.GetProjection()[1][1]) * static_cast<float>(m_RenderHeight));
 
         void* data;
         vkMapMemory(m_Device, m_SceneUBOMemory, 0, sizeof(SceneUBOData), 0, &data);
@@ -1631,7 +1653,7 @@ namespace Vlkrt
                                                  | VK_SHADER_STAGE_MISS_BIT_KHR | VK_SHADER_STAGE_INTERSECTION_BIT_KHR;
         const VkShaderStageFlags kAllRTCompute = kAllRT | VK_SHADER_STAGE_COMPUTE_BIT;
 
-        VkDescriptorSetLayoutBinding bindings[25] = {};
+        VkDescriptorSetLayoutBinding bindings[26] = {};
 
         // 0: TLAS
         bindings[0] = { 0, VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, 1, kAllRTCompute, nullptr };
@@ -1667,7 +1689,7 @@ namespace Vlkrt
         bindings[15] = { 15, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, kAllRTCompute, nullptr };
         // 16: spec
         bindings[16] = { 16, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, kAllRTCompute, nullptr };
-        // 17: previous-frame vertex buffer
+        // 17: mesh instance records
         bindings[17] = { 17, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, kAllRTCompute, nullptr };
         // 18: previous-frame AABB transforms
         bindings[18] = { 18, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, kAllRTCompute, nullptr };
@@ -1683,9 +1705,11 @@ namespace Vlkrt
         bindings[23] = { 23, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, kAllRTCompute, nullptr };
         // 24: denoise reference image
         bindings[24] = { 24, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, kAllRTCompute, nullptr };
+        // 25: texture mip feedback
+        bindings[25] = { 25, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, kAllRTCompute, nullptr };
 
         VkDescriptorSetLayoutCreateInfo layoutInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
-        layoutInfo.bindingCount                    = 25;
+        layoutInfo.bindingCount                    = 26;
         layoutInfo.pBindings                       = bindings;
         vkCreateDescriptorSetLayout(m_Device, &layoutInfo, nullptr, &m_DescriptorSetLayout);
 
@@ -1694,7 +1718,7 @@ namespace Vlkrt
         poolSizes[0]                      = { VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, 1 };
         poolSizes[1] = { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 12 };  // binding 1,10,12-16,19,20,21,22,24
         poolSizes[2] = { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-            10 };  // vtx,idx,mat,matIdx,lights,aabbT,aabbM,prevVtx,prevAabbT,qualityMetrics
+            11 };  // vtx,idx,mat,matIdx,lights,aabbT,aabbM,prevVtx,prevAabbT,qualityMetrics,textureFeedback
         poolSizes[3] = { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, kMaxSceneTextures };
         poolSizes[4] = { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1 };
 
@@ -1713,164 +1737,100 @@ namespace Vlkrt
 
     void Renderer::CreateSceneBuffers(const Scene& scene)
     {
-        // Calculate total vertices and indices across all meshes (static + dynamic)
-        size_t totalVertices = 0;
-        size_t totalIndices  = 0;
-        for (const auto& mesh : scene.StaticMeshes) {
-            totalVertices += mesh.Vertices.size();
-            totalIndices += mesh.Indices.size();
-        }
-        for (const auto& mesh : scene.DynamicMeshes) {
-            totalVertices += mesh.Vertices.size();
-            totalIndices += mesh.Indices.size();
-        }
-
-        // Create vertex buffer
-        size_t vertexCount = std::max(totalVertices, (size_t) 1);
-        m_VertexBufferSize = sizeof(GPUVertex) * vertexCount;
-        m_VertexBuffer     = CreateBuffer(m_VertexBufferSize,
-                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
-                        | VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_VertexMemory);
-
-        m_PrevVertexBufferSize = m_VertexBufferSize;
-        m_PrevVertexBuffer     = CreateBuffer(m_PrevVertexBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_PrevVertexMemory);
-
-        // Create index buffer
-        size_t indexCount = std::max(totalIndices, (size_t) 1);
-        m_IndexBufferSize = sizeof(uint32_t) * indexCount;
-        m_IndexBuffer     = CreateBuffer(m_IndexBufferSize,
-                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
-                        | VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_IndexMemory);
-
-        // Create material buffer
-        size_t materialCount = std::max(scene.Materials.size(), (size_t) 1);
-        m_MaterialBufferSize = sizeof(GPUPBRMaterial) * materialCount;
-        m_MaterialBuffer     = CreateBuffer(m_MaterialBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_MaterialMemory);
+        CreateMaterialBuffer(scene);
+        CreateLightBuffer(scene);
+        CreateProceduralBuffers(scene);
 
-        // Create material index buffer (one uint32 per triangle)
-        size_t triangleCount      = std::max(totalIndices / 3, (size_t) 1);
-        m_MaterialIndexBufferSize = sizeof(uint32_t) * triangleCount;
-        m_MaterialIndexBuffer     = CreateBuffer(m_MaterialIndexBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_MaterialIndexMemory);
+        // Create Scene UBO buffer
+        FreeBuffer(m_SceneUBOBuffer, m_SceneUBOMemory);
+        m_SceneUBOBuffer = CreateBuffer(sizeof(SceneUBOData), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_SceneUBOMemory);
+    }
 
-        // Create AABB transform buffer
+    void Renderer::CreateProceduralBuffers(const Scene& scene)
+    {
+        // Create the AABB transform buffer pair
         size_t aabbCount          = std::max(scene.ProceduralEntities.size(), (size_t) 1);
         m_AABBTransformBufferSize = sizeof(AABBTransform) * aabbCount;
-        m_AABBTransformBuffer     = CreateBuffer(m_AABBTransformBufferSize,
-                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_AABBTransformMemory);
-
-        m_PrevAABBTransformBufferSize = m_AABBTransformBufferSize;
-        m_PrevAABBTransformBuffer     = CreateBuffer(m_PrevAABBTransformBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_PrevAABBTransformMemory);
+        for (uint32_t i = 0; i < 2; ++i) {
+            FreeBuffer(m_AABBTransformBuffers[i], m_AABBTransformMemory[i]);
+            m_AABBTransformBuffers[i] = CreateBuffer(m_AABBTransformBufferSize,
+                    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                    m_AABBTransformMemory[i]);
+        }
+        m_CurrentAABBTransforms = m_PreviousAABBTransforms = 0;
+        m_AABBTransformHash                                = 0;
+        m_AABBTransformCount                               = 0;
 
         // Create AABB material buffer (one GPUPBRMaterial per procedural entity)
+        FreeBuffer(m_AABBMaterialBuffer, m_AABBMaterialMemory);
         m_AABBMaterialBufferSize = sizeof(GPUPBRMaterial) * aabbCount;
         m_AABBMaterialBuffer     = CreateBuffer(m_AABBMaterialBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_AABBMaterialMemory);
+    }
 
-        // Create light buffer
+    void Renderer::CreateMaterialBuffer(const Scene& scene)
+    {
+        FreeBuffer(m_MaterialBuffer, m_MaterialMemory);
+        size_t materialCount = std::max(scene.Materials.size(), (size_t) 1);
+        m_MaterialBufferSize = sizeof(GPUPBRMaterial) * materialCount;
+        m_MaterialBuffer     = CreateBuffer(m_MaterialBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_MaterialMemory);
+    }
+
+    void Renderer::CreateLightBuffer(const Scene& scene)
+    {
+        FreeBuffer(m_LightBuffer, m_LightMemory);
         size_t lightCount = std::max(scene.Lights.size(), (size_t) 1);
         m_LightBufferSize = sizeof(GPULight) * lightCount;
         m_LightBuffer     = CreateBuffer(m_LightBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_LightMemory);
-
-        // Create Scene UBO buffer
-        m_SceneUBOBuffer = CreateBuffer(sizeof(SceneUBOData), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_SceneUBOMemory);
     }
 
-    void Renderer::UpdateSceneData(const Scene& scene)
+    void Renderer::FreeBuffer(VkBuffer& buffer, VkDeviceMemory& memory)
     {
-        // Flatten all meshes (static + dynamic) into single vertex/index buffers
-        std::vector<GPUVertex> gpuVertices;
-        std::vector<uint32_t> gpuIndices;
-        std::vector<uint32_t> materialIndices;  // Material index per triangle
-        uint32_t vertexOffset = 0;
-
-        // Process static meshes
-        for (const auto& mesh : scene.StaticMeshes) {
-            // Compute normal matrix once per mesh (avoid per-vertex inverse/transpose)
-            const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(mesh.Transform)));
-
-            for (const auto& vertex : mesh.Vertices) {
-                GPUVertex gpuVert{};
-                gpuVert.position = glm::vec3(mesh.Transform * glm::vec4(vertex.Position, 1.0f));
-                gpuVert.normal   = glm::normalize(normalMatrix * vertex.Normal);
-                gpuVert.texCoord = vertex.TexCoord;
-                gpuVertices.push_back(gpuVert);
-            }
-
-            // Copy indices with offset
-            for (const auto& index : mesh.Indices) { gpuIndices.push_back(index + vertexOffset); }
-
-            // Store material index for each triangle in this mesh
-            const uint32_t triangleCount = static_cast<uint32_t>(mesh.Indices.size() / 3);
-            for (uint32_t i = 0; i < triangleCount; i++) {
-                materialIndices.push_back(static_cast<uint32_t>(mesh.MaterialIndex));
-            }
+        if (buffer != VK_NULL_HANDLE || memory != VK_NULL_HANDLE) {
+            Walnut::Application::SubmitResourceFree([device = m_Device, buffer, memory]() {
+                if (buffer) vkDestroyBuffer(device, buffer, nullptr);
+                if (memory) vkFreeMemory(device, memory, nullptr);
+            });
+        }
+        buffer = VK_NULL_HANDLE;
+        memory = VK_NULL_HANDLE;
+    }
 
-            vertexOffset += static_cast<uint32_t>(mesh.Vertices.size());
+    void Renderer::UpdateSceneInstances(const Scene& scene)
+    {
+        using Clock                    = std::chrono::high_resolution_clock;
+        const auto geometryUpdateStart = Clock::now();
+        if (UpdateMeshInstances(scene)) {
+            m_AccelerationStructure->UpdateInstances(GetTriangleInstances());
+            WriteTLASDescriptor();
         }
+        m_LastPassStats.SceneGeometryUpdateMs
+                = std::chrono::duration<float, std::milli>(Clock::now() - geometryUpdateStart).count();
 
-        // Process dynamic meshes
-        for (const auto& mesh : scene.DynamicMeshes) {
-            // Compute normal matrix once per mesh (avoid per-vertex inverse/transpose)
-            const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(mesh.Transform)));
-
-            for (const auto& vertex : mesh.Vertices) {
-                GPUVertex gpuVert{};
-                gpuVert.position = glm::vec3(mesh.Transform * glm::vec4(vertex.Position, 1.0f));
-                gpuVert.normal   = glm::normalize(normalMatrix * vertex.Normal);
-                gpuVert.texCoord = vertex.TexCoord;
-                gpuVertices.push_back(gpuVert);
-            }
-
-            // Copy indices with offset
-            for (const auto& index : mesh.Indices) { gpuIndices.push_back(index + vertexOffset); }
-
-            // Store material index for each triangle in this mesh
-            const uint32_t triangleCount = static_cast<uint32_t>(mesh.Indices.size() / 3);
-            for (uint32_t i = 0; i < triangleCount; i++) {
-                materialIndices.push_back(static_cast<uint32_t>(mesh.MaterialIndex));
-            }
-
-            vertexOffset += static_cast<uint32_t>(mesh.Vertices.size());
+        // The procedurals did not change, so their previous transforms catch up as UpdateSceneData would have
+        if (m_PreviousAABBTransforms != m_CurrentAABBTransforms) {
+            m_PreviousAABBTransforms = m_CurrentAABBTransforms;
+            WritePreviousAABBTransformDescriptor();
         }
+    }
 
-        std::vector<GPUVertex> prevGpuVertices
-                = (m_PreviousFrameVertices.size() == gpuVertices.size()) ? m_PreviousFrameVertices : gpuVertices;
+    void Renderer::UpdateSceneData(const Scene& scene)
+    {
+        // Geometry is uploaded only when a mesh first uses it; moved meshes only rewrite their instance
+        using Clock                             = std::chrono::high_resolution_clock;
+        const auto geometryUpdateStart          = Clock::now();
+        const size_t previousInstanceCount      = m_MeshInstances.size();
+        const GeometryLayoutChange layoutChange = UploadMeshGeometry(scene);
+        // Meshes that went away leave nothing to rewrite, but the TLAS still has to drop them
+        const bool instancesMoved = UpdateMeshInstances(scene) || m_MeshInstances.size() != previousInstanceCount;
+        m_LastPassStats.SceneGeometryUpdateMs
+                = std::chrono::duration<float, std::milli>(Clock::now() - geometryUpdateStart).count();
 
-        // Upload vertex data to GPU
         void* data;
-        if (!gpuVertices.empty()) {
-            vkMapMemory(m_Device, m_VertexMemory, 0, sizeof(GPUVertex) * gpuVertices.size(), 0, &data);
-            memcpy(data, gpuVertices.data(), sizeof(GPUVertex) * gpuVertices.size());
-            vkUnmapMemory(m_Device, m_VertexMemory);
-
-            vkMapMemory(m_Device, m_PrevVertexMemory, 0, sizeof(GPUVertex) * prevGpuVertices.size(), 0, &data);
-            memcpy(data, prevGpuVertices.data(), sizeof(GPUVertex) * prevGpuVertices.size());
-            vkUnmapMemory(m_Device, m_PrevVertexMemory);
-        }
-
-        // Upload index data to GPU
-        if (!gpuIndices.empty()) {
-            vkMapMemory(m_Device, m_IndexMemory, 0, sizeof(uint32_t) * gpuIndices.size(), 0, &data);
-            memcpy(data, gpuIndices.data(), sizeof(uint32_t) * gpuIndices.size());
-            vkUnmapMemory(m_Device, m_IndexMemory);
-        }
-
-        // Upload material index data (one per triangle)
-        if (!materialIndices.empty()) {
-            vkMapMemory(m_Device, m_MaterialIndexMemory, 0, sizeof(uint32_t) * materialIndices.size(), 0, &data);
-            memcpy(data, materialIndices.data(), sizeof(uint32_t) * materialIndices.size());
-            vkUnmapMemory(m_Device, m_MaterialIndexMemory);
-        }
-
         // Upload light data
         if (!scene.Lights.empty()) {
             std::vector<GPULight> gpuLights(scene.Lights.size());
@@ -1889,6 +1849,7 @@ namespace Vlkrt
         }
 
         // Upload AABB transforms and materials for procedural entities
+        bool proceduralsChanged = false;
         if (!scene.ProceduralEntities.empty()) {
             std::vector<AABBTransform> aabbTransforms(scene.ProceduralEntities.size());
             std::vector<GPUPBRMaterial> aabbMaterials(scene.ProceduralEntities.size());
@@ -1928,38 +1889,61 @@ namespace Vlkrt
                 }
             }
 
-            std::vector<AABBTransform> prevAabbTransforms
-                    = (m_PreviousFrameAABBTransforms.size() == aabbTransforms.size()) ? m_PreviousFrameAABBTransforms
-                                                                                      : aabbTransforms;
+            const size_t transformBytes  = sizeof(AABBTransform) * aabbTransforms.size();
+            const uint64_t transformHash = HashBytes(kFNVOffsetBasis, aabbTransforms.data(), transformBytes);
+            const bool countChanged      = aabbTransforms.size() != m_AABBTransformCount;
+            proceduralsChanged           = countChanged || transformHash != m_AABBTransformHash;
 
             void* aabbData;
-            vkMapMemory(
-                    m_Device, m_AABBTransformMemory, 0, sizeof(AABBTransform) * aabbTransforms.size(), 0, &aabbData);
-            memcpy(aabbData, aabbTransforms.data(), sizeof(AABBTransform) * aabbTransforms.size());
-            vkUnmapMemory(m_Device, m_AABBTransformMemory);
-
-            vkMapMemory(m_Device, m_PrevAABBTransformMemory, 0, sizeof(AABBTransform) * prevAabbTransforms.size(), 0,
-                    &aabbData);
-            memcpy(aabbData, prevAabbTransforms.data(), sizeof(AABBTransform) * prevAabbTransforms.size());
-            vkUnmapMemory(m_Device, m_PrevAABBTransformMemory);
+            if (proceduralsChanged) {
+                // The buffer not bound as current becomes current; the old current stays bound as the previous
+                // frame's, unless the procedurals themselves changed and there is no previous frame to keep
+                const uint32_t target = 1 - m_CurrentAABBTransforms;
+                vkMapMemory(m_Device, m_AABBTransformMemory[target], 0, transformBytes, 0, &aabbData);
+                memcpy(aabbData, aabbTransforms.data(), transformBytes);
+                vkUnmapMemory(m_Device, m_AABBTransformMemory[target]);
+
+                m_PreviousAABBTransforms = countChanged ? target : m_CurrentAABBTransforms;
+                m_CurrentAABBTransforms  = target;
+                m_AABBTransformHash      = transformHash;
+                m_AABBTransformCount     = aabbTransforms.size();
+            }
+            else {
+                m_PreviousAABBTransforms = m_CurrentAABBTransforms;
+            }
 
             vkMapMemory(m_Device, m_AABBMaterialMemory, 0, sizeof(GPUPBRMaterial) * aabbMaterials.size(), 0, &aabbData);
             memcpy(aabbData, aabbMaterials.data(), sizeof(GPUPBRMaterial) * aabbMaterials.size());
             vkUnmapMemory(m_Device, m_AABBMaterialMemory);
-
-            m_PreviousFrameAABBTransforms = std::move(aabbTransforms);
         }
         else {
-            m_PreviousFrameAABBTransforms.clear();
+            proceduralsChanged       = m_AABBTransformCount != 0;
+            m_PreviousAABBTransforms = m_CurrentAABBTransforms;
+            m_AABBTransformHash      = 0;
+            m_AABBTransformCount     = 0;
+        }
+
+        // A triangle BLAS depends on its geometry range alone: they are all rebuilt only when the ranges were laid out
+        // afresh, and otherwise built for the ranges appended. Changed procedurals only need a new AABB BLAS, and
+        // moved meshes only a new TLAS.
+        std::vector<AccelerationStructure::TriangleGeometry> geometries;
+        geometries.reserve(m_GeometryRanges.size());
+        for (const GeometryRange& range : m_GeometryRanges) geometries.push_back(range.Range);
+        if (layoutChange == GeometryLayoutChange::Relaid || !m_AccelerationStructure->IsBuilt()) {
+            m_AccelerationStructure->Rebuild(
+                    geometries, GetTriangleInstances(), m_VertexBuffer, m_IndexBuffer, scene.ProceduralEntities);
+        }
+        else {
+            if (layoutChange == GeometryLayoutChange::Appended) {
+                m_AccelerationStructure->AddGeometries(geometries, m_VertexBuffer, m_IndexBuffer);
+            }
+            if (proceduralsChanged) {
+                m_AccelerationStructure->RebuildProcedurals(scene.ProceduralEntities, GetTriangleInstances());
+            }
+            else if (instancesMoved) {
+                m_AccelerationStructure->UpdateInstances(GetTriangleInstances());
+            }
         }
-
-        m_PreviousFrameVertices = std::move(gpuVertices);
-
-        // Rebuild acceleration structure with all meshes (static + dynamic) and procedural entities
-        std::vector<Mesh> allMeshes;
-        allMeshes.insert(allMeshes.end(), scene.StaticMeshes.begin(), scene.StaticMeshes.end());
-        allMeshes.insert(allMeshes.end(), scene.DynamicMeshes.begin(), scene.DynamicMeshes.end());
-        m_AccelerationStructure->Rebuild(allMeshes, m_VertexBuffer, m_IndexBuffer, scene.ProceduralEntities);
 
         // Update descriptor sets
         VkWriteDescriptorSetAccelerationStructureKHR asInfo
@@ -1998,33 +1982,49 @@ namespace Vlkrt
         lightBufferInfo.range                  = m_LightBufferSize > 0 ? m_LightBufferSize : 16;
 
         // Collect all textures from the scene materials
-        std::vector<std::shared_ptr<Walnut::Image>> allTextures;
-        std::unordered_map<std::string, int> textureToIndex;
+        std::vector<SceneTexture> sceneTextures;
+        std::unordered_map<std::string, int> textureToIndex;  // By TextureLoader::MakeKey
+        m_SkippedSceneTextures = 0;
 
-        auto registerTexture = [&](const std::string& texturePath) {
+        auto registerTexture = [&](const std::string& texturePath, TextureUsage usage) {
             if (texturePath.empty()) return;
-            if (textureToIndex.find(texturePath) != textureToIndex.end()) return;
-            if (allTextures.size() >= kMaxSceneTextures) {
+            const std::string key = TextureLoader::MakeKey(texturePath, usage);
+            if (textureToIndex.find(key) != textureToIndex.end()) return;
+            if (sceneTextures.size() >= kMaxSceneTextures) {
                 WL_WARN_TAG("Renderer", "Texture limit reached ({}). Skipping '{}'", kMaxSceneTextures, texturePath);
+                ++m_SkippedSceneTextures;
                 return;
             }
 
-            auto tex = LoadOrGetTexture(texturePath);
-            if (tex) {
-                textureToIndex[texturePath] = static_cast<int>(allTextures.size());
-                allTextures.push_back(tex);
+            TextureHandle handle = LoadOrGetTexture(texturePath, usage);
+            if (m_Textures.Get(handle)) {
+                textureToIndex[key] = static_cast<int>(sceneTextures.size());
+                m_Textures.AddRef(handle);
+                sceneTextures.push_back({ handle, texturePath, usage });
             }
         };
 
         for (const auto& mat : scene.Materials) {
-            registerTexture(mat.TextureAlbedoFilename);
-            registerTexture(mat.TextureFilename);
-            registerTexture(mat.TextureNormalFilename);
-            registerTexture(mat.TextureMetallicRoughnessFilename);
-            registerTexture(mat.TextureEmissiveFilename);
+            registerTexture(mat.TextureAlbedoFilename, TextureUsage::Color);
+            registerTexture(mat.TextureFilename, TextureUsage::Color);
+            registerTexture(mat.TextureNormalFilename, TextureUsage::Normal);
+            registerTexture(mat.TextureMetallicRoughnessFilename, TextureUsage::Color);
+            registerTexture(mat.TextureEmissiveFilename, TextureUsage::Color);
             // Skip occlusion—not sampled in shader
         }
 
+        // Drop the previous scene's references; textures it no longer shares with this one become evictable. Content
+        // changes that keep the same textures in the same slots keep the mip feedback history.
+        const bool textureSetChanged = !std::equal(sceneTextures.begin(), sceneTextures.end(),
+                m_SceneTextures.begin(), m_SceneTextures.end(),
+                [](const SceneTexture& a, const SceneTexture& b) { return a.Handle == b.Handle; });
+        for (const SceneTexture& sceneTexture : m_SceneTextures) m_Textures.Release(sceneTexture.Handle);
+        m_SceneTextures = std::move(sceneTextures);
+        if (textureSetChanged) {
+            m_TextureFeedback.Reset(m_SceneTextures.size(), m_GlobalTick);
+            m_Textures.Trim();
+        }
+
         // Update material buffer again with the correct texture indices
         if (!scene.Materials.empty()) {
             std::vector<GPUPBRMaterial> gpuMaterials(scene.Materials.size());
@@ -2060,14 +2060,14 @@ namespace Vlkrt
                 const std::string& albedoPath
                         = !mat.TextureAlbedoFilename.empty() ? mat.TextureAlbedoFilename : mat.TextureFilename;
 
-                auto lookupTextureIndex = [&](const std::string& path) -> int32_t {
+                auto lookupTextureIndex = [&](const std::string& path, TextureUsage usage = TextureUsage::Color) {
                     if (path.empty()) return -1;
-                    auto it = textureToIndex.find(path);
+                    auto it = textureToIndex.find(TextureLoader::MakeKey(path, usage));
                     return (it != textureToIndex.end()) ? it->second : -1;
                 };
 
                 gm.albedoTextureIndex            = lookupTextureIndex(albedoPath);
-                gm.normalTextureIndex            = lookupTextureIndex(mat.TextureNormalFilename);
+                gm.normalTextureIndex            = lookupTextureIndex(mat.TextureNormalFilename, TextureUsage::Normal);
                 gm.metallicRoughnessTextureIndex = lookupTextureIndex(mat.TextureMetallicRoughnessFilename);
                 gm.emissiveTextureIndex          = lookupTextureIndex(mat.TextureEmissiveFilename);
                 gm.occlusionTextureIndex         = lookupTextureIndex(mat.TextureOcclusionFilename);
@@ -2078,22 +2078,7 @@ namespace Vlkrt
             vkUnmapMemory(m_Device, m_MaterialMemory);
         }
 
-        std::vector<VkDescriptorImageInfo> textureInfos(kMaxSceneTextures);
-        for (size_t i = 0; i < kMaxSceneTextures; i++) {
-            if (i < allTextures.size()) {
-                textureInfos[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-                textureInfos[i].imageView   = allTextures[i]->GetVkImageView();
-                textureInfos[i].sampler     = allTextures[i]->GetVkSampler();
-            }
-            else {
-                // Point to final image as a fallback (valid object for Vulkan)
-                textureInfos[i].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
-                textureInfos[i].imageView   = m_FinalImage->GetVkImageView();
-                textureInfos[i].sampler     = m_FinalImage->GetVkSampler();
-            }
-        }
-
-        VkWriteDescriptorSet writes[8] = {};
+        VkWriteDescriptorSet writes[7] = {};
 
         // Acceleration structure
         writes[0].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
@@ -2151,19 +2136,12 @@ namespace Vlkrt
         writes[6].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
         writes[6].pBufferInfo     = &lightBufferInfo;
 
-        // Textures
-        writes[7].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        writes[7].dstSet          = m_DescriptorSet;
-        writes[7].dstBinding      = 7;
-        writes[7].descriptorCount = kMaxSceneTextures;
-        writes[7].descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        writes[7].pImageInfo      = textureInfos.data();
-
-        vkUpdateDescriptorSets(m_Device, 8, writes, 0, nullptr);
+        vkUpdateDescriptorSets(m_Device, 7, writes, 0, nullptr);
+        WriteTextureDescriptors();
 
         // Bindings 8–11: AABB transforms, AABB materials, accum image, scene UBO
         VkDescriptorBufferInfo aabbTransformInfo = {};
-        aabbTransformInfo.buffer                 = m_AABBTransformBuffer;
+        aabbTransformInfo.buffer                 = m_AABBTransformBuffers[m_CurrentAABBTransforms];
         aabbTransformInfo.offset                 = 0;
         aabbTransformInfo.range                  = m_AABBTransformBufferSize > 0 ? m_AABBTransformBufferSize : 16;
 
@@ -2181,15 +2159,15 @@ namespace Vlkrt
         sceneUBOInfo.offset                 = 0;
         sceneUBOInfo.range                  = sizeof(SceneUBOData);
 
-        VkDescriptorBufferInfo prevVertexBufferInfo = {};
-        prevVertexBufferInfo.buffer                 = m_PrevVertexBuffer;
-        prevVertexBufferInfo.offset                 = 0;
-        prevVertexBufferInfo.range                  = m_PrevVertexBufferSize > 0 ? m_PrevVertexBufferSize : 16;
+        VkDescriptorBufferInfo instanceBufferInfo = {};
+        instanceBufferInfo.buffer                 = m_InstanceBuffer;
+        instanceBufferInfo.offset                 = 0;
+        instanceBufferInfo.range                  = m_InstanceBufferSize > 0 ? m_InstanceBufferSize : 16;
 
         VkDescriptorBufferInfo prevAabbTransformInfo = {};
-        prevAabbTransformInfo.buffer                 = m_PrevAABBTransformBuffer;
+        prevAabbTransformInfo.buffer                 = m_AABBTransformBuffers[m_PreviousAABBTransforms];
         prevAabbTransformInfo.offset                 = 0;
-        prevAabbTransformInfo.range = m_PrevAABBTransformBufferSize > 0 ? m_PrevAABBTransformBufferSize : 16;
+        prevAabbTransformInfo.range                  = m_AABBTransformBufferSize > 0 ? m_AABBTransformBufferSize : 16;
 
         VkWriteDescriptorSet extraWrites[6] = {};
 
@@ -2226,7 +2204,7 @@ namespace Vlkrt
         extraWrites[4].dstBinding      = 17;
         extraWrites[4].descriptorCount = 1;
         extraWrites[4].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-        extraWrites[4].pBufferInfo     = &prevVertexBufferInfo;
+        extraWrites[4].pBufferInfo     = &instanceBufferInfo;
 
         extraWrites[5].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
         extraWrites[5].dstSet          = m_DescriptorSet;
@@ -2238,25 +2216,389 @@ namespace Vlkrt
         vkUpdateDescriptorSets(m_Device, 6, extraWrites, 0, nullptr);
     }
 
+    auto Renderer::LayoutSceneGeometry(const Scene& scene) -> GeometryLayoutChange
+    {
+        const size_t staticCount = scene.StaticMeshes.size();
+        const size_t meshCount   = staticCount + scene.DynamicMeshes.size();
+        auto meshAt              = [&](size_t i) -> const Mesh& {
+            return i < staticCount ? scene.StaticMeshes[i] : scene.DynamicMeshes[i - staticCount];
+        };
+
+        // The ranges of geometry no mesh uses anymore stay laid out, so that a mesh coming back to it needs no upload,
+        // until they outweigh the ones still used
+        std::unordered_set<const MeshGeometry*> used;
+        for (size_t i = 0; i < meshCount; ++i) used.insert(meshAt(i).Geometry.get());
+        VkDeviceSize liveBytes = 0;
+        VkDeviceSize deadBytes = 0;
+        for (const GeometryRange& range : m_GeometryRanges) {
+            const VkDeviceSize bytes = (range.LODIndex == 0 ? sizeof(GPUVertex) * range.Range.VertexCount : 0)
+                                       + sizeof(uint32_t) * range.Range.IndexCount;
+            (used.count(range.Geometry.get()) ? liveBytes : deadBytes) += bytes;
+        }
+        const bool relayout = deadBytes > liveBytes;
+        if (relayout) {
+            m_GeometryRanges.clear();
+            m_GeometryVertexCount = 0;
+            m_GeometryIndexCount  = 0;
+            m_UploadedRangeCount  = 0;
+        }
+
+        std::map<const MeshGeometry*, uint32_t> firstRangeOf;
+        for (size_t i = 0; i < m_GeometryRanges.size(); ++i) {
+            const GeometryRange& range = m_GeometryRanges[i];
+            if (range.LODIndex == 0) firstRangeOf[range.Geometry.get()] = static_cast<uint32_t>(i);
+        }
+
+        // Instance records follow the order of the meshes, which shifts when meshes come or go, so they are all
+        // rewritten then, as they are when their ranges moved
+        if (relayout || m_MeshInstances.size() != meshCount) {
+            m_MeshInstances.assign(meshCount, MeshInstance{});
+            m_StalePrevTransformMeshes.clear();
+        }
+
+        // Every LOD of a geometry shares its vertices; each has its own indices and material slots. All of them are
+        // laid out, so that switching a mesh's LOD only repoints its instance (see UpdateMeshInstances).
+        const size_t firstNewRange = m_GeometryRanges.size();
+        for (size_t i = 0; i < meshCount; ++i) {
+            const Mesh& mesh              = meshAt(i);
+            const auto nextRange          = static_cast<uint32_t>(m_GeometryRanges.size());
+            auto [it, isNewRange]         = firstRangeOf.try_emplace(mesh.Geometry.get(), nextRange);
+            m_MeshInstances[i].FirstRange = it->second;
+            if (!isNewRange) continue;
+
+            const uint32_t firstVertex = m_GeometryVertexCount;
+            m_GeometryVertexCount += static_cast<uint32_t>(mesh.GetVertices().size());
+            for (uint32_t lod = 0; lod < mesh.GetLODCount(); ++lod) {
+                Mesh view;
+                view.Geometry = mesh.Geometry;
+                view.LODIndex = lod;
+
+                GeometryRange range;
+                range.Geometry          = mesh.Geometry;
+                range.LODIndex          = lod;
+                range.Range.FirstVertex = firstVertex;
+                range.Range.VertexCount = static_cast<uint32_t>(mesh.GetVertices().size());
+                range.Range.FirstIndex  = m_GeometryIndexCount;
+                range.Range.IndexCount  = static_cast<uint32_t>(view.GetIndices().size());
+                m_GeometryIndexCount += range.Range.IndexCount;
+                m_GeometryRanges.push_back(std::move(range));
+            }
+        }
+
+        if (relayout) return GeometryLayoutChange::Relaid;
+        return m_GeometryRanges.size() > firstNewRange ? GeometryLayoutChange::Appended : GeometryLayoutChange::None;
+    }
+
+    void Renderer::GrowGeometryBuffers(VkCommandBuffer cmd)
+    {
+        // Geometry is appended as meshes first use it, so the buffers grow by half again, and the ranges already
+        // uploaded are copied over on the device rather than staged again. With none uploaded (a fresh layout), they
+        // are sized to fit, unless they fit already without being more than twice as large as needed.
+        const bool keepContents = m_UploadedRangeCount > 0;
+        auto grow = [&](VkBuffer& buffer, VkDeviceMemory& memory, VkDeviceSize& size, VkDeviceSize needed,
+                            VkBufferUsageFlags usage) {
+            if (buffer != VK_NULL_HANDLE && needed <= size && (keepContents || size <= 2 * needed)) return;
+
+            VkBuffer oldBuffer         = buffer;
+            VkDeviceMemory oldMemory   = memory;
+            const VkDeviceSize oldSize = size;
+            size                       = keepContents ? std::max(needed, oldSize + oldSize / 2) : needed;
+            buffer = CreateBuffer(size, usage | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, memory);
+            if (keepContents && oldBuffer != VK_NULL_HANDLE) {
+                const VkBufferCopy copy = { 0, 0, oldSize };
+                vkCmdCopyBuffer(cmd, oldBuffer, buffer, 1, &copy);
+            }
+            // Uploads wait for their command buffer, so the copy is done before the old buffer can be freed
+            FreeBuffer(oldBuffer, oldMemory);
+        };
+
+        // Vertices in object space; indices relative to each geometry's first vertex
+        const VkBufferUsageFlags geometryUsage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+                                                 | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+                                                 | VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR;
+        grow(m_VertexBuffer, m_VertexMemory, m_VertexBufferSize,
+                sizeof(GPUVertex) * std::max(m_GeometryVertexCount, 1u), geometryUsage);
+        grow(m_IndexBuffer, m_IndexMemory, m_IndexBufferSize, sizeof(uint32_t) * std::max(m_GeometryIndexCount, 1u),
+                geometryUsage);
+
+        // One material slot per triangle, added to the instance's material
+        grow(m_MaterialIndexBuffer, m_MaterialIndexMemory, m_MaterialIndexBufferSize,
+                sizeof(uint32_t) * std::max(m_GeometryIndexCount / 3, 1u), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    }
+
+    void Renderer::CreateInstanceBuffer()
+    {
+        // Host-visible: a moved mesh rewrites its record in place. Grows by half again, as meshes (players) tend to
+        // come one at a time.
+        const VkDeviceSize needed = sizeof(GPUMeshInstance) * std::max(m_MeshInstances.size(), (size_t) 1);
+        const VkDeviceSize size   = std::max(needed, m_InstanceBufferSize + m_InstanceBufferSize / 2);
+        FreeBuffer(m_InstanceBuffer, m_InstanceMemory);
+        m_InstanceBufferSize = size;
+        m_InstanceBuffer     = CreateBuffer(m_InstanceBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_InstanceMemory);
+
+        for (MeshInstance& instance : m_MeshInstances) instance.Uploaded = false;
+    }
+
+    auto Renderer::UploadMeshGeometry(const Scene& scene) -> GeometryLayoutChange
+    {
+        const GeometryLayoutChange change = LayoutSceneGeometry(scene);
+        const VkDeviceSize instanceBytes  = sizeof(GPUMeshInstance) * m_MeshInstances.size();
+        if (m_InstanceBuffer == VK_NULL_HANDLE || instanceBytes > m_InstanceBufferSize) CreateInstanceBuffer();
+        if (m_VertexBuffer != VK_NULL_HANDLE && m_UploadedRangeCount == m_GeometryRanges.size()) return change;
+
+        // Only the ranges laid out since the last upload are staged
+        VkDeviceSize stagingBytes = 0;
+        for (size_t i = m_UploadedRangeCount; i < m_GeometryRanges.size(); ++i) {
+            const AccelerationStructure::TriangleGeometry& r = m_GeometryRanges[i].Range;
+            if (m_GeometryRanges[i].LODIndex == 0) stagingBytes += sizeof(GPUVertex) * r.VertexCount;
+            stagingBytes += sizeof(uint32_t) * (r.IndexCount + r.IndexCount / 3);
+        }
+
+        uint8_t* staging           = AcquireGeometryStaging(stagingBytes);
+        VkDeviceSize stagingOffset = 0;
+        std::vector<VkBufferCopy> vertexCopies;
+        std::vector<VkBufferCopy> indexCopies;
+        std::vector<VkBufferCopy> materialIndexCopies;
+
+        for (size_t i = m_UploadedRangeCount; i < m_GeometryRanges.size(); ++i) {
+            // Reads the range through a mesh view, for its LOD's indices and material slots
+            const GeometryRange& range = m_GeometryRanges[i];
+            Mesh view;
+            view.Geometry                                    = range.Geometry;
+            view.LODIndex                                    = range.LODIndex;
+            const AccelerationStructure::TriangleGeometry& r = range.Range;
+
+            // The LODs follow the full geometry and share its vertices
+            if (range.LODIndex == 0 && r.VertexCount > 0) {
+                // Packed straight into the mapped staging buffer; large geometries are split across the thread pool
+                VertexPacking::PackParallel(view.GetVertices().data(), r.VertexCount,
+                        reinterpret_cast<GPUVertex*>(staging + stagingOffset));
+
+                const VkDeviceSize vertexBytes = sizeof(GPUVertex) * r.VertexCount;
+                vertexCopies.push_back({ stagingOffset, sizeof(GPUVertex) * r.FirstVertex, vertexBytes });
+                stagingOffset += vertexBytes;
+            }
+
+            if (r.IndexCount == 0) continue;
+
+            const auto& indices = view.GetIndices();
+            memcpy(staging + stagingOffset, indices.data(), sizeof(uint32_t) * r.IndexCount);
+            const VkDeviceSize indexBytes = sizeof(uint32_t) * r.IndexCount;
+            indexCopies.push_back({ stagingOffset, sizeof(uint32_t) * r.FirstIndex, indexBytes });
+            stagingOffset += indexBytes;
+
+            // The view's MaterialIndex is 0, so these are the slots the hit shader adds to the instance's material
+            const uint32_t triangleCount = r.IndexCount / 3;
+            auto* materialSlots          = reinterpret_cast<uint32_t*>(staging + stagingOffset);
+            for (uint32_t t = 0; t < triangleCount; ++t) materialSlots[t] = view.GetTriangleMaterial(t);
+
+            const VkDeviceSize materialBytes = sizeof(uint32_t) * triangleCount;
+            if (materialBytes > 0) {
+                materialIndexCopies.push_back({ stagingOffset, sizeof(uint32_t) * (r.FirstIndex / 3), materialBytes });
+                stagingOffset += materialBytes;
+            }
+        }
+
+        // The new ranges land after the ones copied over by a growth; neither overlaps the other
+        VkCommandBuffer cmd = Walnut::Application::GetCommandBuffer(true);
+        GrowGeometryBuffers(cmd);
+        if (!vertexCopies.empty()) {
+            vkCmdCopyBuffer(cmd, m_GeometryStagingBuffer, m_VertexBuffer, static_cast<uint32_t>(vertexCopies.size()),
+                    vertexCopies.data());
+        }
+        if (!indexCopies.empty()) {
+            vkCmdCopyBuffer(cmd, m_GeometryStagingBuffer, m_IndexBuffer, static_cast<uint32_t>(indexCopies.size()),
+                    indexCopies.data());
+        }
+        if (!materialIndexCopies.empty()) {
+            vkCmdCopyBuffer(cmd, m_GeometryStagingBuffer, m_MaterialIndexBuffer,
+                    static_cast<uint32_t>(materialIndexCopies.size()), materialIndexCopies.data());
+        }
+
+        VkMemoryBarrier barrier              = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+        barrier.srcAccessMask                = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask                = VK_ACCESS_SHADER_READ_BIT;
+        const VkPipelineStageFlags dstStages = VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR
+                                               | VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, dstStages, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+        Walnut::Application::FlushCommandBuffer(cmd);
+        m_UploadedRangeCount = static_cast<uint32_t>(m_GeometryRanges.size());
+
+        // A scene's upload needs staging for all of its geometry, which is not needed again until the next one
+        if (m_GeometryStagingSize > kRetainedGeometryStagingBytes) DestroyGeometryStaging();
+        return change;
+    }
+
+    auto Renderer::IsGeometryLaidOut(const Scene& scene) const -> bool
+    {
+        const size_t staticCount = scene.StaticMeshes.size();
+        if (m_MeshInstances.size() != staticCount + scene.DynamicMeshes.size()) return false;
+        for (size_t i = 0; i < m_MeshInstances.size(); ++i) {
+            const Mesh& mesh          = i < staticCount ? scene.StaticMeshes[i] : scene.DynamicMeshes[i - staticCount];
+            const uint32_t firstRange = m_MeshInstances[i].FirstRange;
+            if (firstRange >= m_GeometryRanges.size() || m_GeometryRanges[firstRange].Geometry != mesh.Geometry) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    auto Renderer::UpdateMeshInstances(const Scene& scene) -> bool
+    {
+        const size_t staticCount = scene.StaticMeshes.size();
+        auto meshAt              = [&](size_t i) -> const Mesh& {
+            return i < staticCount ? scene.StaticMeshes[i] : scene.DynamicMeshes[i - staticCount];
+        };
+
+        // A record's previous transform is what the last frame rendered with, so a mesh that moved in the last update
+        // and not since is rewritten too, to stop reporting motion
+        std::vector<uint32_t> dirty;
+        bool moved = false;
+        m_StalePrevTransformMeshes.clear();
+        for (size_t i = 0; i < m_MeshInstances.size(); ++i) {
+            const Mesh& mesh       = meshAt(i);
+            MeshInstance& instance = m_MeshInstances[i];
+            const glm::mat4& prev  = instance.Uploaded ? instance.Transform : mesh.Transform;
+            // LOD indices past the geometry's levels select the full geometry
+            const uint32_t geometry = instance.FirstRange + (mesh.LODIndex < mesh.GetLODCount() ? mesh.LODIndex : 0);
+            if (instance.Uploaded && instance.PrevTransform == prev && instance.Transform == mesh.Transform
+                    && instance.MaterialIndex == mesh.MaterialIndex && instance.Geometry == geometry) {
+                continue;
+            }
+
+            moved |= !instance.Uploaded || instance.Transform != mesh.Transform || instance.Geometry != geometry;
+            instance.Geometry      = geometry;
+            instance.PrevTransform = prev;
+            instance.Transform     = mesh.Transform;
+            instance.MaterialIndex = mesh.MaterialIndex;
+            instance.Uploaded      = true;
+            dirty.push_back(static_cast<uint32_t>(i));
+            if (instance.PrevTransform != instance.Transform) m_StalePrevTransformMeshes.push_back(dirty.back());
+        }
+
+        if (!dirty.empty()) WriteMeshInstances(dirty);
+        return moved;
+    }
+
+    void Renderer::WriteMeshInstances(const std::vector<uint32_t>& meshIndices)
+    {
+        if (m_InstanceMemory == VK_NULL_HANDLE || meshIndices.empty()) return;
+
+        void* data = nullptr;
+        vkMapMemory(m_Device, m_InstanceMemory, 0, VK_WHOLE_SIZE, 0, &data);
+        auto* records = static_cast<GPUMeshInstance*>(data);
+        for (uint32_t meshIndex : meshIndices) {
+            const MeshInstance& instance                     = m_MeshInstances[meshIndex];
+            const AccelerationStructure::TriangleGeometry& r = m_GeometryRanges[instance.Geometry].Range;
+
+            // The normal matrix is computed once per instance, not per hit in the shader
+            GPUMeshInstance record{};
+            record.objectToWorld     = instance.Transform;
+            record.prevObjectToWorld = instance.PrevTransform;
+            record.normalMatrix      = glm::mat4(glm::transpose(glm::inverse(glm::mat3(instance.Transform))));
+            record.firstVertex       = r.FirstVertex;
+            record.firstIndex        = r.FirstIndex;
+            record.materialIndex     = instance.MaterialIndex;
+            record.indexCount        = r.IndexCount;
+            records[meshIndex]       = record;
+        }
+        vkUnmapMemory(m_Device, m_InstanceMemory);
+    }
+
+    auto Renderer::GetTriangleInstances() const -> std::vector<AccelerationStructure::TriangleInstance>
+    {
+        std::vector<AccelerationStructure::TriangleInstance> instances(m_MeshInstances.size());
+        for (size_t i = 0; i < m_MeshInstances.size(); ++i) {
+            instances[i].Transform   = m_MeshInstances[i].Transform;
+            instances[i].Geometry    = m_MeshInstances[i].Geometry;
+            instances[i].CustomIndex = static_cast<uint32_t>(i);
+        }
+        return instances;
+    }
+
+    auto Renderer::AcquireGeometryStaging(VkDeviceSize size) -> uint8_t*
+    {
+        if (m_GeometryStagingBuffer != VK_NULL_HANDLE && size <= m_GeometryStagingSize) return m_GeometryStagingMapped;
+
+        DestroyGeometryStaging();
+        m_GeometryStagingSize   = std::max(size, static_cast<VkDeviceSize>(16));
+        m_GeometryStagingBuffer = CreateBuffer(m_GeometryStagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_GeometryStagingMemory);
+
+        void* data = nullptr;
+        vkMapMemory(m_Device, m_GeometryStagingMemory, 0, VK_WHOLE_SIZE, 0, &data);
+        m_GeometryStagingMapped = static_cast<uint8_t*>(data);
+        return m_GeometryStagingMapped;
+    }
+
+    void Renderer::DestroyGeometryStaging()
+    {
+        // Uploads wait for their copies to complete, so the staging buffer is never in use here
+        if (m_GeometryStagingBuffer == VK_NULL_HANDLE) return;
+
+        vkUnmapMemory(m_Device, m_GeometryStagingMemory);
+        vkDestroyBuffer(m_Device, m_GeometryStagingBuffer, nullptr);
+        vkFreeMemory(m_Device, m_GeometryStagingMemory, nullptr);
+        m_GeometryStagingBuffer = VK_NULL_HANDLE;
+        m_GeometryStagingMemory = VK_NULL_HANDLE;
+        m_GeometryStagingSize   = 0;
+        m_GeometryStagingMapped = nullptr;
+    }
+
     void Renderer::SyncPreviousFrameGeometryBuffers()
     {
-        if (m_PrevVertexMemory != VK_NULL_HANDLE && !m_PreviousFrameVertices.empty()) {
-            void* data = nullptr;
-            vkMapMemory(m_Device, m_PrevVertexMemory, 0, sizeof(GPUVertex) * m_PreviousFrameVertices.size(), 0, &data);
-            memcpy(data, m_PreviousFrameVertices.data(), sizeof(GPUVertex) * m_PreviousFrameVertices.size());
-            vkUnmapMemory(m_Device, m_PrevVertexMemory);
+        // Meshes moved by the last update and not since have their previous-frame transform catch up with the
+        // current one
+        if (!m_StalePrevTransformMeshes.empty()) {
+            for (uint32_t meshIndex : m_StalePrevTransformMeshes) {
+                m_MeshInstances[meshIndex].PrevTransform = m_MeshInstances[meshIndex].Transform;
+            }
+            WriteMeshInstances(m_StalePrevTransformMeshes);
+            m_StalePrevTransformMeshes.clear();
         }
 
-        if (m_PrevAABBTransformMemory != VK_NULL_HANDLE && !m_PreviousFrameAABBTransforms.empty()) {
-            void* aabbData = nullptr;
-            vkMapMemory(m_Device, m_PrevAABBTransformMemory, 0,
-                    sizeof(AABBTransform) * m_PreviousFrameAABBTransforms.size(), 0, &aabbData);
-            memcpy(aabbData, m_PreviousFrameAABBTransforms.data(),
-                    sizeof(AABBTransform) * m_PreviousFrameAABBTransforms.size());
-            vkUnmapMemory(m_Device, m_PrevAABBTransformMemory);
+        // Likewise procedurals: their current transforms are bound as the previous ones too, nothing is copied
+        if (m_PreviousAABBTransforms != m_CurrentAABBTransforms) {
+            m_PreviousAABBTransforms = m_CurrentAABBTransforms;
+            WritePreviousAABBTransformDescriptor();
         }
     }
 
+    void Renderer::WriteTLASDescriptor()
+    {
+        VkWriteDescriptorSetAccelerationStructureKHR asInfo
+                = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_KHR };
+        asInfo.accelerationStructureCount = 1;
+        VkAccelerationStructureKHR tlas   = m_AccelerationStructure->GetTLAS();
+        asInfo.pAccelerationStructures    = &tlas;
+
+        VkWriteDescriptorSet write = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+        write.pNext                = &asInfo;
+        write.dstSet               = m_DescriptorSet;
+        write.dstBinding           = 0;
+        write.descriptorCount      = 1;
+        write.descriptorType       = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+        vkUpdateDescriptorSets(m_Device, 1, &write, 0, nullptr);
+    }
+
+    void Renderer::WritePreviousAABBTransformDescriptor()
+    {
+        VkDescriptorBufferInfo prevAabbTransformInfo = {};
+        prevAabbTransformInfo.buffer                 = m_AABBTransformBuffers[m_PreviousAABBTransforms];
+        prevAabbTransformInfo.offset                 = 0;
+        prevAabbTransformInfo.range                  = m_AABBTransformBufferSize > 0 ? m_AABBTransformBufferSize : 16;
+
+        VkWriteDescriptorSet write = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+        write.dstSet               = m_DescriptorSet;
+        write.dstBinding           = 18;
+        write.descriptorCount      = 1;
+        write.descriptorType       = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        write.pBufferInfo          = &prevAabbTransformInfo;
+        vkUpdateDescriptorSets(m_Device, 1, &write, 0, nullptr);
+    }
+
     void Renderer::UpdateLightBuffer(const Scene& scene)
     {
         if (scene.Lights.empty() || m_LightMemory == VK_NULL_HANDLE) return;
@@ -2334,102 +2676,157 @@ namespace Vlkrt
 
     void Renderer::PreloadTextures(const std::vector<std::string>& textureFilenames)
     {
-        for (const auto& textureFilename : textureFilenames) { LoadOrGetTexture(textureFilename); }
+        // Preloads only fill the budget left over by the scene; once it is full they would just evict each other
+        if (!m_Textures.HasRoomFor(0)) return;
+
+        std::vector<std::string> missing;
+        for (const auto& textureFilename : textureFilenames) {
+            const std::string key = TextureLoader::MakeKey(textureFilename, TextureLoader::GuessUsage(textureFilename));
+            if (!m_Textures.Find(key).IsValid()) missing.push_back(textureFilename);
+        }
+        m_TextureStreamer->Request(missing);
     }
 
-    auto Renderer::LoadOrGetTexture(const std::string& filename) -> std::shared_ptr<Walnut::Image>
+    void Renderer::UpdateTextureStreaming()
     {
-        // Check if texture already cached
-        auto it = m_TextureCache.find(filename);
-        if (it != m_TextureCache.end()) { return it->second; }
-
-        // Try to load texture from disk
-        std::shared_ptr<Walnut::Image> texture;
-        constexpr int TEXTURE_SCALE = 1;  // Full resolution textures
-
-        auto tryLoadPath = [&](const std::filesystem::path& path) -> bool {
-            try {
-                // Load image
-                int width, height, channels;
-                unsigned char* data = stbi_load(path.string().c_str(), &width, &height, &channels, 4);
-                if (!data || width <= 0 || height <= 0) {
-                    stbi_image_free(data);
-                    return false;
-                }
-
-                int scaledW           = width;
-                int scaledH           = height;
-                unsigned char* scaled = nullptr;
-
-                if (TEXTURE_SCALE > 1) {
-                    // Downscale by averaging blocks when explicitly enabled.
-                    scaledW = (width + TEXTURE_SCALE - 1) / TEXTURE_SCALE;
-                    scaledH = (height + TEXTURE_SCALE - 1) / TEXTURE_SCALE;
-                    scaled  = new unsigned char[scaledW * scaledH * 4];
-
-                    for (int y = 0; y < scaledH; y++) {
-                        for (int x = 0; x < scaledW; x++) {
-                            uint32_t r = 0, g = 0, b = 0, a = 0, count = 0;
-                            for (int dy = 0; dy < TEXTURE_SCALE; dy++) {
-                                for (int dx = 0; dx < TEXTURE_SCALE; dx++) {
-                                    int sx  = std::min(x * TEXTURE_SCALE + dx, width - 1);
-                                    int sy  = std::min(y * TEXTURE_SCALE + dy, height - 1);
-                                    int idx = (sy * width + sx) * 4;
-                                    r += data[idx + 0];
-                                    g += data[idx + 1];
-                                    b += data[idx + 2];
-                                    a += data[idx + 3];
-                                    count++;
-                                }
-                            }
-                            int outIdx         = (y * scaledW + x) * 4;
-                            scaled[outIdx + 0] = r / count;
-                            scaled[outIdx + 1] = g / count;
-                            scaled[outIdx + 2] = b / count;
-                            scaled[outIdx + 3] = a / count;
-                        }
-                    }
-                }
-                else {
-                    scaled = new unsigned char[scaledW * scaledH * 4];
-                    memcpy(scaled, data, static_cast<size_t>(scaledW) * static_cast<size_t>(scaledH) * 4);
-                }
-                stbi_image_free(data);
+        // Page in the finer mips the last frames sampled, and page out the ones they stopped sampling. RequestUrgent
+        // queues at the front, so page-ins are issued in reverse to keep the most wanted first.
+        const std::vector<TextureFeedback::Slot> slots = GetTextureFeedbackSlots();
+        const std::vector<TextureFeedback::Request> requests
+                = m_TextureFeedback.Prioritize(slots, m_GlobalTick, kMaxTexturePageInsPerFrame);
+        for (auto request = requests.rbegin(); request != requests.rend(); ++request) {
+            const SceneTexture& sceneTexture = m_SceneTextures[request->Slot];
+            const uint32_t residentFirstMip  = slots[request->Slot].ResidentFirstMip;
+            if (request->FirstMip >= residentFirstMip) {
+                m_TextureStreamer->RequestMips(sceneTexture.Filename, sceneTexture.Usage, request->FirstMip);
+                continue;
+            }
 
-                // Create image from scaled data (Image class will upload to GPU)
-                auto newImg = std::make_shared<Walnut::Image>(scaledW, scaledH, Walnut::ImageFormat::RGBA, scaled);
-                delete[] scaled;
+            // Each finer level is about four times the bytes of the one below; ask only for what the budget allows
+            const auto texture   = m_Textures.Get(sceneTexture.Handle);
+            const uint64_t bytes = texture ? texture->GetSizeBytes() : 0;
+            uint32_t firstMip    = request->FirstMip;
+            while (firstMip < residentFirstMip
+                    && !m_Textures.HasRoomFor((bytes << (2 * (residentFirstMip - firstMip))) - bytes)) {
+                ++firstMip;
+            }
+            if (firstMip < residentFirstMip) {
+                m_TextureStreamer->RequestUrgent(sceneTexture.Filename, sceneTexture.Usage, firstMip);
+            }
+        }
 
-                if (newImg->GetWidth() > 0) {
-                    texture                  = newImg;
-                    m_TextureCache[filename] = texture;
-                    WL_INFO_TAG("Renderer", "Loaded texture: {} ({}x{})", path.string(), width, height);
-                    return true;
-                }
+        bool sceneTexturesChanged = false;
+        for (auto& upload : m_TextureStreamer->Update()) {
+            const std::string key = TextureLoader::MakeKey(upload.Filename, upload.Usage);
+            TextureHandle handle  = m_Textures.Find(key);
+            if (!handle.IsValid()) {
+                m_Textures.InsertIfRoom(key, std::move(upload.Texture), upload.FirstMip, upload.MipCount);
+                continue;
             }
-            catch (const std::exception& e) {
-                WL_WARN_TAG("Renderer", "Failed to load texture '{}': {}", path.string(), e.what());
+
+            const uint32_t residentFirstMip = m_Textures.GetFirstMip(handle);
+            if (m_Textures.Remap(handle, std::move(upload.Texture), upload.FirstMip)) {
+                if (upload.FirstMip < residentFirstMip) ++m_TextureMipPageIns;
+                else ++m_TextureMipPageOuts;
+                sceneTexturesChanged = true;
             }
-            return false;
-        };
+        }
 
-        std::filesystem::path inputPath(filename);
-        std::vector<std::filesystem::path> candidates;
-        if (inputPath.is_absolute()) { candidates.push_back(inputPath); }
-        else {
-            candidates.push_back(inputPath);
-            candidates.emplace_back(std::filesystem::path(Vlkrt::TEXTURES_DIR) / inputPath);
-            candidates.emplace_back(std::filesystem::path(Vlkrt::MODELS_DIR) / inputPath);
+        // Bound textures were replaced by other ranges of their mips; the old images are freed once no frame uses them
+        if (sceneTexturesChanged && m_DescriptorSet != VK_NULL_HANDLE) WriteTextureDescriptors();
+        m_Textures.Trim();
+    }
+
+    void Renderer::AddDecodedTextures(std::vector<DecodedTexture>& textures)
+    {
+        std::erase_if(textures,
+                [&](const DecodedTexture& texture) { return m_Textures.Find(texture.GetKey()).IsValid(); });
+        // The scene being loaded needs these, so they are inserted regardless of the budget
+        for (auto& upload : m_TextureStreamer->UploadDecoded(textures)) {
+            m_Textures.Insert(TextureLoader::MakeKey(upload.Filename, upload.Usage), std::move(upload.Texture),
+                    upload.FirstMip, upload.MipCount);
+        }
+    }
+
+    void Renderer::SetTextureBudget(uint64_t budgetBytes)
+    {
+        m_Textures.SetBudget(budgetBytes);
+        m_Textures.Trim();
+    }
+
+    auto Renderer::GetPendingTextureCount() const -> size_t { return m_TextureStreamer->GetPendingCount(); }
+
+    auto Renderer::LoadOrGetTexture(const std::string& filename, TextureUsage usage) -> TextureHandle
+    {
+        // Check if texture already resident
+        const std::string key = TextureLoader::MakeKey(filename, usage);
+        if (TextureHandle cached = m_Textures.Find(key); cached.IsValid()) return cached;
+
+        // Bind the smallest mips right away; mip feedback streams in the finer ones the view turns out to need
+        TextureStreamer::Upload upload = m_TextureStreamer->LoadNow(filename, usage, kPartialTextureDimension);
+        return m_Textures.Insert(key, std::move(upload.Texture), upload.FirstMip, upload.MipCount);
+    }
+
+    void Renderer::WriteTextureDescriptors()
+    {
+        std::vector<VkDescriptorImageInfo> textureInfos(kMaxSceneTextures);
+        for (size_t i = 0; i < kMaxSceneTextures; i++) {
+            auto texture = i < m_SceneTextures.size() ? m_Textures.Get(m_SceneTextures[i].Handle) : nullptr;
+            if (texture) {
+                textureInfos[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+                textureInfos[i].imageView   = texture->GetVkImageView();
+                textureInfos[i].sampler     = texture->GetVkSampler();
+            }
+            else {
+                // Point to final image as a fallback (valid object for Vulkan)
+                textureInfos[i].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+                textureInfos[i].imageView   = m_FinalImage->GetVkImageView();
+                textureInfos[i].sampler     = m_FinalImage->GetVkSampler();
+            }
         }
 
-        for (const auto& candidate : candidates) {
-            std::error_code ec;
-            if (!candidate.is_absolute() && !std::filesystem::exists(candidate, ec)) continue;
-            if (tryLoadPath(candidate)) break;
+        VkWriteDescriptorSet write = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+        write.dstSet               = m_DescriptorSet;
+        write.dstBinding           = 7;
+        write.descriptorCount      = kMaxSceneTextures;
+        write.descriptorType       = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        write.pImageInfo           = textureInfos.data();
+        vkUpdateDescriptorSets(m_Device, 1, &write, 0, nullptr);
+    }
+
+    auto Renderer::GetTextureFeedbackSlots() const -> std::vector<TextureFeedback::Slot>
+    {
+        std::vector<TextureFeedback::Slot> slots(m_SceneTextures.size());
+        for (size_t i = 0; i < m_SceneTextures.size(); i++) {
+            const TextureHandle handle = m_SceneTextures[i].Handle;
+            const auto texture         = m_Textures.Get(handle);
+            if (!texture) continue;
+
+            TextureFeedback::Slot& slot = slots[i];
+            slot.ResidentFirstMip       = m_Textures.GetFirstMip(handle);
+            slot.MipCount               = m_Textures.GetMipCount(handle);
+
+            // The tail is the first source level no larger than a partial load would be
+            const uint64_t sourceDimension = static_cast<uint64_t>(std::max(texture->GetWidth(), texture->GetHeight()))
+                                             << slot.ResidentFirstMip;
+            while (slot.TailMip + 1 < slot.MipCount && (sourceDimension >> slot.TailMip) > kPartialTextureDimension) {
+                ++slot.TailMip;
+            }
         }
+        return slots;
+    }
+
+    void Renderer::ReadTextureFeedback()
+    {
+        if (m_TextureFeedbackMemory == VK_NULL_HANDLE || m_SceneTextures.empty()) return;
 
-        if (!texture) { WL_WARN_TAG("Renderer", "Failed to load texture '{}'.", filename); }
+        const size_t count = std::min<size_t>(m_SceneTextures.size(), kMaxSceneTextures);
+        uint32_t* feedback = nullptr;
+        vkMapMemory(m_Device, m_TextureFeedbackMemory, 0, sizeof(uint32_t) * count, 0, (void**) &feedback);
+        if (!feedback) return;
 
-        return texture;
+        const std::vector<TextureFeedback::Slot> slots = GetTextureFeedbackSlots();
+        m_TextureFeedback.Accumulate(std::span<const uint32_t>(feedback, count), slots, m_GlobalTick);
+        vkUnmapMemory(m_Device, m_TextureFeedbackMemory);
     }
 }  // namespace Vlkrt
\ No newline at end of file
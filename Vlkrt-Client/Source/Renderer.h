@@ -7,6 +7,8 @@
 #include "Walnut/Image.h"
 #include "AccelerationStructure.h"
 #include "NRDDenoiser.h"
+#include "TextureFeedback.h"
+#include "TextureResidency.h"
 
 #include <memory>
 #include <vector>
@@ -20,22 +22,21 @@ namespace Vlkrt
 {
     class Camera;
     struct Scene;
+    struct MeshGeometry;
     class FSRUpscaler;
+    class TextureStreamer;
 
     /// <summary>
-    /// GPU-aligned vertex structure.
+    /// Compact vertex structure (scalar-aligned, see VertexPacking for the encodings).
     /// </summary>
     struct GPUVertex
     {
-        glm::vec3 position;  // 0
-        float _pad1;         // 12
-        glm::vec3 normal;    // 16
-        float _pad2;         // 28
-        glm::vec2 texCoord;  // 32
-        glm::vec2 _pad3;     // 40
-        // 48
+        glm::vec3 position;  // 0: Full precision, read by the BLAS build
+        uint32_t normal;     // 12: Octahedral-encoded unit normal, two snorm16
+        uint32_t texCoord;   // 16: Two half floats
+        // 20
     };
-    static_assert(sizeof(GPUVertex) == 48, "GPUVertex size mismatch");
+    static_assert(sizeof(GPUVertex) == 20, "GPUVertex size mismatch");
 
     /// <summary>
     /// GPU-aligned light structure.
@@ -97,6 +98,23 @@ namespace Vlkrt
         // 128
     };
 
+    /// <summary>
+    /// Per-mesh instance record: where the mesh's object-space geometry lives in the scene buffers, and where the
+    /// mesh is placed in the world. Indexed by the TLAS instance's custom index.
+    /// </summary>
+    struct GPUMeshInstance
+    {
+        glm::mat4 objectToWorld;      // 0
+        glm::mat4 prevObjectToWorld;  // 64: Last frame's, for motion vectors
+        glm::mat4 normalMatrix;       // 128: Inverse transpose of objectToWorld's upper 3x3
+        uint32_t firstVertex;         // 192
+        uint32_t firstIndex;          // 196: The geometry's material slots start at firstIndex / 3
+        uint32_t materialIndex;       // 200: Added to the geometry's per-triangle material slots
+        uint32_t indexCount;          // 204: Of the selected LOD, which starts at firstIndex
+        // 208
+    };
+    static_assert(sizeof(GPUMeshInstance) == 208, "GPUMeshInstance size mismatch");
+
     /// <summary>
     /// Scene UBO sent to shaders every frame.
     /// </summary>
@@ -126,9 +144,10 @@ namespace Vlkrt
         uint32_t enableDenoiseMetrics;     // 296
         uint32_t fsrEnabled;               // 300
         uint32_t useReferenceMetrics;      // 304
-        // 308
+        float pixelSpreadAngle;            // 308: Ray cone spread per pixel, for texture LOD
+        // 312
     };
-    static_assert(sizeof(SceneUBOData) == 308, "SceneUBOData size mismatch");
+    static_assert(sizeof(SceneUBOData) == 312, "SceneUBOData size mismatch");
 
     /// <summary>
     /// Struct to hold render pass statistics for performance monitoring.
@@ -136,6 +155,7 @@ namespace Vlkrt
     struct RenderPassStats
     {
         float SceneSetupMs{ 0.0f };
+        float SceneGeometryUpdateMs{ 0.0f };  ///< CPU time of the last mesh geometry and instance update
         float UBOUploadMs{ 0.0f };
         float RayTraceGpuMs{ 0.0f };  ///< GPU execution time measured via Vulkan timestamps
         float NRDGpuMs{ 0.0f };       ///< GPU execution time measured via Vulkan timestamps
@@ -148,6 +168,19 @@ namespace Vlkrt
         uint32_t Width{ 0 };
         uint32_t Height{ 0 };
         float EstimatedGraphicsMemoryMB{ 0.0f };
+        float VertexBufferMB{ 0.0f };
+        float VertexBufferSavedMB{ 0.0f };  ///< VRAM and per-upload bytes saved against 48-byte padded vertices
+        float MotionHistoryCpuKB{ 0.0f };   ///< CPU memory kept for previous-frame (motion vector) data
+        float TextureResidentMB{ 0.0f };
+        float TextureBudgetMB{ 0.0f };
+        uint32_t TexturesResident{ 0 };
+        uint32_t TexturesBound{ 0 };       ///< Referenced by the current scene
+        uint32_t TexturesPartial{ 0 };     ///< Resident without their finest mips, which the view does not need (yet)
+        uint32_t TexturesSkipped{ 0 };     ///< Scene textures beyond the descriptor array size
+        uint64_t TexturesEvicted{ 0 };     ///< Since startup
+        uint64_t TexturesRejected{ 0 };    ///< Preloads and mip page-ins that did not fit the budget, since startup
+        uint64_t TextureMipPageIns{ 0 };   ///< Finer mips streamed in from feedback, since startup
+        uint64_t TextureMipPageOuts{ 0 };  ///< Mips dropped because they were no longer sampled, since startup
     };
 
     /// <summary>
@@ -189,10 +222,12 @@ namespace Vlkrt
         }
         void InvalidateSceneStructure()
         {
-            m_SceneValid          = false;
-            m_SceneDataDirty      = true;
-            m_LastUpdatedScene    = nullptr;
-            m_LastProceduralCount = UINT32_MAX;
+            m_SceneValid             = false;
+            m_SceneDataDirty         = true;
+            m_LastUpdatedScene       = nullptr;
+            m_LastProceduralCount    = UINT32_MAX;
+            m_HasUploadedGenerations = false;
+            m_HasCachedMeshMetrics   = false;
         }
         void ResetAccumulation()
         {
@@ -237,18 +272,77 @@ namespace Vlkrt
 
         void OnFSRSettingsChanged(bool enabled, uint32_t qualityMode, float sharpness);
 
+        // Queues textures for streaming; they become resident over the next frames (see UpdateTextureStreaming).
         void PreloadTextures(const std::vector<std::string>& textureFilenames);
+        // Requests the mips the last frames' feedback asked for and uploads streamed textures that finished decoding,
+        // within the per-frame upload budget. Call once per frame.
+        void UpdateTextureStreaming();
+        // Uploads textures decoded off the frame thread (see TextureLoader) and releases their CPU pixels.
+        void AddDecodedTextures(std::vector<DecodedTexture>& textures);
+        auto GetResidentTextureKeys() const -> std::vector<std::string> { return m_Textures.GetResidentKeys(); }
+        auto GetPendingTextureCount() const -> size_t;
+        // VRAM for textures; unused ones are evicted least recently used first to stay within it
+        void SetTextureBudget(uint64_t budgetBytes);
+        auto GetTextureBudget() const -> uint64_t { return m_Textures.GetBudget(); }
 
     private:
-        auto LoadOrGetTexture(const std::string& filename) -> std::shared_ptr<Walnut::Image>;
+        // How a geometry layout changed m_GeometryRanges
+        enum class GeometryLayoutChange
+        {
+            None,
+            Appended,  // Ranges were added after the ones already laid out, which are unchanged
+            Relaid,    // Every range was laid out afresh
+        };
+
+        auto LoadOrGetTexture(const std::string& filename, TextureUsage usage) -> TextureHandle;
+        // Binds m_SceneTextures to the texture array (binding 7)
+        void WriteTextureDescriptors();
+        // Resident mip ranges of m_SceneTextures, for TextureFeedback
+        auto GetTextureFeedbackSlots() const -> std::vector<TextureFeedback::Slot>;
+        // Folds the mip feedback of the frame just rendered into m_TextureFeedback. Maps the single feedback buffer
+        // directly rather than through a ring of readback buffers: FlushCommandBuffer waits for every frame, so there
+        // is never a frame in flight that a deferred readback could overlap with.
+        void ReadTextureFeedback();
 
         void CreateRayTracingPipeline();
         void DestroyPipelineObjects();
         void CreateShaderBindingTable(const Scene& scene);
         void CreateDescriptorSets();
+        // (Re)creates the scene buffers other than the geometry and instance ones, which UploadMeshGeometry grows as
+        // geometry is laid out; the ones replaced are freed once no frame uses them
         void CreateSceneBuffers(const Scene& scene);
+        void CreateMaterialBuffer(const Scene& scene);
+        void CreateLightBuffer(const Scene& scene);
+        void CreateProceduralBuffers(const Scene& scene);
+        // Frees buffer and memory once no frame uses them, and nulls both
+        void FreeBuffer(VkBuffer& buffer, VkDeviceMemory& memory);
         void UpdateSceneData(const Scene& scene);
+        // The fast path of UpdateSceneData for meshes that only moved, switched LOD or changed material: rewrites
+        // their instance records and updates the TLAS
+        void UpdateSceneInstances(const Scene& scene);
+        // Assigns every mesh the ranges of its geometry, appending ranges for the geometries not laid out yet. Every
+        // LOD of a geometry gets a range.
+        auto LayoutSceneGeometry(const Scene& scene) -> GeometryLayoutChange;
+        // Grows the vertex, index and material index buffers to hold the current layout, copying the uploaded ranges
+        // into the new ones on cmd
+        void GrowGeometryBuffers(VkCommandBuffer cmd);
+        // (Re)creates the instance buffer for the current instances, which are all rewritten by the next update
+        void CreateInstanceBuffer();
+        // Lays out the scene's geometry and uploads the ranges not uploaded yet
+        auto UploadMeshGeometry(const Scene& scene) -> GeometryLayoutChange;
+        // Whether every mesh's geometry is laid out where its instance expects it, so that no upload is needed
+        auto IsGeometryLaidOut(const Scene& scene) const -> bool;
+        // Rewrites the instance records of the meshes that moved, switched LOD or changed material; returns whether
+        // any moved or switched LOD, which the TLAS has to follow
+        auto UpdateMeshInstances(const Scene& scene) -> bool;
+        void WriteMeshInstances(const std::vector<uint32_t>& meshIndices);
+        auto GetTriangleInstances() const -> std::vector<AccelerationStructure::TriangleInstance>;
+        // Mapped staging memory for at least size bytes of geometry uploads
+        auto AcquireGeometryStaging(VkDeviceSize size) -> uint8_t*;
+        void DestroyGeometryStaging();
         void SyncPreviousFrameGeometryBuffers();
+        void WriteTLASDescriptor();
+        void WritePreviousAABBTransformDescriptor();
         void UpdateLightBuffer(const Scene& scene);
         void UpdateSceneUBO(const Scene& scene, const Camera& camera, bool forceTemporalMode);
         auto CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties,
@@ -297,10 +391,6 @@ namespace Vlkrt
         VkDeviceMemory m_VertexMemory{ VK_NULL_HANDLE };
         VkDeviceSize m_VertexBufferSize{ 0 };
 
-        VkBuffer m_PrevVertexBuffer{ VK_NULL_HANDLE };
-        VkDeviceMemory m_PrevVertexMemory{ VK_NULL_HANDLE };
-        VkDeviceSize m_PrevVertexBufferSize{ 0 };
-
         VkBuffer m_IndexBuffer{ VK_NULL_HANDLE };
         VkDeviceMemory m_IndexMemory{ VK_NULL_HANDLE };
         VkDeviceSize m_IndexBufferSize{ 0 };
@@ -314,19 +404,25 @@ namespace Vlkrt
         VkDeviceMemory m_MaterialIndexMemory{ VK_NULL_HANDLE };
         VkDeviceSize m_MaterialIndexBufferSize{ 0 };
 
+        // Mesh instance buffer (one GPUMeshInstance per mesh, with room for more)
+        VkBuffer m_InstanceBuffer{ VK_NULL_HANDLE };
+        VkDeviceMemory m_InstanceMemory{ VK_NULL_HANDLE };
+        VkDeviceSize m_InstanceBufferSize{ 0 };
+
         // Light buffer
         VkBuffer m_LightBuffer{ VK_NULL_HANDLE };
         VkDeviceMemory m_LightMemory{ VK_NULL_HANDLE };
         VkDeviceSize m_LightBufferSize{ 0 };
 
-        // AABB procedural geometry buffers
-        VkBuffer m_AABBTransformBuffer{ VK_NULL_HANDLE };
-        VkDeviceMemory m_AABBTransformMemory{ VK_NULL_HANDLE };
-        VkDeviceSize m_AABBTransformBufferSize{ 0 };
-
-        VkBuffer m_PrevAABBTransformBuffer{ VK_NULL_HANDLE };
-        VkDeviceMemory m_PrevAABBTransformMemory{ VK_NULL_HANDLE };
-        VkDeviceSize m_PrevAABBTransformBufferSize{ 0 };
+        // AABB procedural geometry buffers. The transforms ping-pong: an update that moves procedurals writes the
+        // buffer not bound as current and makes it current, leaving the old one bound as the previous frame's.
+        VkBuffer m_AABBTransformBuffers[2]{ VK_NULL_HANDLE, VK_NULL_HANDLE };
+        VkDeviceMemory m_AABBTransformMemory[2]{ VK_NULL_HANDLE, VK_NULL_HANDLE };
+        VkDeviceSize m_AABBTransformBufferSize{ 0 };  // Of each
+        uint32_t m_CurrentAABBTransforms{ 0 };         // Bound at 8
+        uint32_t m_PreviousAABBTransforms{ 0 };        // Bound at 18, the current one once it has caught up
+        uint64_t m_AABBTransformHash{ 0 };             // Of the transforms last written, to detect moves
+        size_t m_AABBTransformCount{ 0 };
 
         VkBuffer m_AABBMaterialBuffer{ VK_NULL_HANDLE };
         VkDeviceMemory m_AABBMaterialMemory{ VK_NULL_HANDLE };
@@ -340,6 +436,10 @@ namespace Vlkrt
         VkBuffer m_QualityMetricsBuffer{ VK_NULL_HANDLE };
         VkDeviceMemory m_QualityMetricsMemory{ VK_NULL_HANDLE };
 
+        // Texture mip feedback buffer (written by the closest-hit shader, one entry per texture array slot)
+        VkBuffer m_TextureFeedbackBuffer{ VK_NULL_HANDLE };
+        VkDeviceMemory m_TextureFeedbackMemory{ VK_NULL_HANDLE };
+
         // Temporal accumulation image
         std::shared_ptr<Walnut::Image> m_AccumImage;
         std::shared_ptr<Walnut::Image> m_DenoiseReferenceImage;
@@ -381,16 +481,16 @@ namespace Vlkrt
 
         // Track scene changes to avoid unnecessary AS rebuilds
         size_t m_LastMeshCount{ 0 };
-        size_t m_LastVertexCount{ 0 };
-        size_t m_LastIndexCount{ 0 };
+        uint64_t m_LastGeometrySetKey{ 0 };
         size_t m_LastMaterialCount{ 0 };
         size_t m_LastLightCount{ 0 };
         uint32_t m_LastProceduralCount{ UINT32_MAX };  // UINT32_MAX forces initial creation
 
-        // Cached scene metrics
+        // Cached scene metrics, recounted when the meshes' generation changes
         size_t m_CachedTotalMeshCount{ 0 };
-        size_t m_CachedTotalVertices{ 0 };
-        size_t m_CachedTotalIndices{ 0 };
+        uint64_t m_CachedGeometrySetKey{ 0 };  // Of the set of unique geometries, whatever the meshes using them
+        uint64_t m_CachedMeshMetricsGeneration{ 0 };
+        bool m_HasCachedMeshMetrics{ false };
         bool m_SceneValid{ false };
         bool m_FirstFrame{ true };
         bool m_AccumFirstFrame{ true };
@@ -409,16 +509,75 @@ namespace Vlkrt
         uint32_t m_ReferenceCaptureTargetFrames{ 0 };
         uint32_t m_ReferenceCaptureCapturedFrames{ 0 };
 
-        std::vector<GPUVertex> m_PreviousFrameVertices;
-        std::vector<AABBTransform> m_PreviousFrameAABBTransforms;
+        // The scene geometry buffers hold each unique mesh geometry once, with all of its LODs, in object space. A
+        // geometry is uploaded once, when a mesh first uses it, and its ranges stay where they are until the ranges
+        // no mesh uses anymore outweigh the ones still used (as after switching scenes), when the geometry is laid
+        // out afresh. Meshes (static ones first, then dynamic ones) are instances of them, so moving a mesh or
+        // switching its LOD only rewrites its instance record and the TLAS, and adding one only appends a record.
+        struct GeometryRange
+        {
+            std::shared_ptr<const MeshGeometry> Geometry;
+            uint32_t LODIndex{ 0 };
+            AccelerationStructure::TriangleGeometry Range;
+        };
 
-        std::unordered_map<std::string, std::shared_ptr<Walnut::Image>> m_TextureCache;
+        struct MeshInstance
+        {
+            uint32_t FirstRange{ 0 };  // Of the mesh's geometry in m_GeometryRanges; LOD n is n ranges on
+            // As in the instance record, once Uploaded
+            uint32_t Geometry{ 0 };  // Range of the selected LOD
+            glm::mat4 Transform{ 1.0f };
+            glm::mat4 PrevTransform{ 1.0f };
+            uint32_t MaterialIndex{ 0 };
+            bool Uploaded{ false };
+        };
+
+        std::vector<GeometryRange> m_GeometryRanges;
+        std::vector<MeshInstance> m_MeshInstances;
+        uint32_t m_GeometryVertexCount{ 0 };
+        uint32_t m_GeometryIndexCount{ 0 };
+        uint32_t m_UploadedRangeCount{ 0 };  // The ranges before it are in the geometry buffers
+        std::vector<uint32_t> m_StalePrevTransformMeshes;  // Meshes whose previous-frame transform lags one update
+
+        // Host-visible staging for uploads to the device-local geometry buffers; kept mapped between uploads
+        VkBuffer m_GeometryStagingBuffer{ VK_NULL_HANDLE };
+        VkDeviceMemory m_GeometryStagingMemory{ VK_NULL_HANDLE };
+        VkDeviceSize m_GeometryStagingSize{ 0 };
+        uint8_t* m_GeometryStagingMapped{ nullptr };
+
+        // Textures by filename; the ones bound for the current scene hold a reference so that unused ones can be
+        // evicted, least recently used first, while recently used ones stay resident across scene switches as long as
+        // they fit the texture budget
+        struct SceneTexture
+        {
+            TextureHandle Handle;
+            std::string Filename;
+            TextureUsage Usage{ TextureUsage::Color };
+        };
+
+        TextureResidency m_Textures;
+        std::vector<SceneTexture> m_SceneTextures;  // In texture array order
+        uint32_t m_SkippedSceneTextures{ 0 };
+        TextureFeedback m_TextureFeedback;  // Indexed like m_SceneTextures
+        uint64_t m_TextureMipPageIns{ 0 };
+        uint64_t m_TextureMipPageOuts{ 0 };
+        std::unique_ptr<TextureStreamer> m_TextureStreamer;
 
         // Scene update tracking
         const Scene* m_LastUpdatedScene{ nullptr };
         bool m_SceneDataDirty{ true };
-        uint64_t m_LastSceneSignature{ 0 };
-        bool m_HasSceneSignature{ false };
+        // Scene generations (see Scene::MeshesGeneration) the scene data was last uploaded for
+        struct SceneGenerations
+        {
+            uint64_t Meshes{ 0 };
+            uint64_t Materials{ 0 };
+            uint64_t Lights{ 0 };
+            uint64_t Procedurals{ 0 };
+
+            auto operator==(const SceneGenerations& other) const -> bool = default;
+        };
+        SceneGenerations m_UploadedGenerations{};
+        bool m_HasUploadedGenerations{ false };
 
         // GPU timestamp query pool (6 slots: RT begin/end, NRD begin/end, FSR begin/end)
         VkQueryPool m_TimestampQueryPool{ VK_NULL_HANDLE };
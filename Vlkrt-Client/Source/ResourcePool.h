@@ -0,0 +1,222 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Vlkrt
+{
+    /// <summary>
+    /// Typed reference to a slot in a ResourcePool. The generation is bumped whenever the slot's resource is evicted,
+    /// so a handle that outlives its resource resolves to nothing instead of to whatever reuses the slot.
+    /// </summary>
+    template <typename T>
+    struct ResourceHandle
+    {
+        static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+        uint32_t Index{ kInvalidIndex };
+        uint32_t Generation{ 0 };
+
+        auto IsValid() const -> bool { return Index != kInvalidIndex; }
+        auto operator==(const ResourceHandle& other) const -> bool = default;
+    };
+
+    /// <summary>
+    /// Keyed cache of shared resources addressed by generational handles.
+    /// A resource is referenced while any handle has been AddRef'd for it or anyone outside the pool still holds its
+    /// shared_ptr. Unreferenced resources stay resident so that they can be reused (e.g. across scene switches) until
+    /// EvictUnreferenced trims them, least recently used first. Not thread-safe; owners synchronize if needed.
+    /// </summary>
+    template <typename T>
+    class ResourcePool
+    {
+    public:
+        using Handle = ResourceHandle<T>;
+
+        auto Find(const std::string& key) -> Handle
+        {
+            auto it = m_Lookup.find(key);
+            if (it == m_Lookup.end()) return {};
+
+            Slot& slot   = m_Slots[it->second];
+            slot.LastUse = ++m_UseClock;
+            return { it->second, slot.Generation };
+        }
+
+        // Publishes a resource under key, replacing any previous entry with that key.
+        auto Insert(const std::string& key, std::shared_ptr<T> resource, uint64_t sizeBytes) -> Handle
+        {
+            if (auto existing = m_Lookup.find(key); existing != m_Lookup.end()) Evict(existing->second);
+
+            uint32_t index;
+            if (!m_FreeSlots.empty()) {
+                index = m_FreeSlots.back();
+                m_FreeSlots.pop_back();
+            }
+            else {
+                index = static_cast<uint32_t>(m_Slots.size());
+                m_Slots.emplace_back();
+            }
+
+            Slot& slot     = m_Slots[index];
+            slot.Key       = key;
+            slot.Resource  = std::move(resource);
+            slot.SizeBytes = sizeBytes;
+            slot.RefCount  = 0;
+            slot.LastUse   = ++m_UseClock;
+            m_Lookup[key]  = index;
+            m_ResidentBytes += sizeBytes;
+            return { index, slot.Generation };
+        }
+
+        // Swaps the resource behind a live handle, keeping its key, references and handles valid. Returns false if the
+        // handle has been evicted.
+        auto Replace(Handle handle, std::shared_ptr<T> resource, uint64_t sizeBytes) -> bool
+        {
+            Slot* slot = Resolve(handle);
+            if (!slot) return false;
+
+            m_ResidentBytes += sizeBytes - slot->SizeBytes;
+            slot->Resource  = std::move(resource);
+            slot->SizeBytes = sizeBytes;
+            slot->LastUse   = ++m_UseClock;
+            return true;
+        }
+
+        // Resolves a handle; empty if it is invalid or its resource has been evicted.
+        auto Get(Handle handle) const -> std::shared_ptr<T>
+        {
+            const Slot* slot = Resolve(handle);
+            return slot ? slot->Resource : nullptr;
+        }
+
+        // Marks the resource as just used, which moves it to the back of the eviction order
+        void Touch(Handle handle)
+        {
+            if (Slot* slot = Resolve(handle)) slot->LastUse = ++m_UseClock;
+        }
+
+        void AddRef(Handle handle)
+        {
+            if (Slot* slot = Resolve(handle)) ++slot->RefCount;
+        }
+
+        void Release(Handle handle)
+        {
+            Slot* slot = Resolve(handle);
+            if (slot && slot->RefCount > 0) {
+                --slot->RefCount;
+                slot->LastUse = ++m_UseClock;
+            }
+        }
+
+        // Evicts least recently used unreferenced resources until those left take at most retainBytes.
+        auto EvictUnreferenced(uint64_t retainBytes) -> size_t
+        {
+            std::vector<uint32_t> candidates;
+            uint64_t unreferencedBytes = 0;
+            for (uint32_t i = 0; i < static_cast<uint32_t>(m_Slots.size()); ++i) {
+                if (m_Slots[i].Resource && !IsReferenced(m_Slots[i])) {
+                    candidates.push_back(i);
+                    unreferencedBytes += m_Slots[i].SizeBytes;
+                }
+            }
+            std::sort(candidates.begin(), candidates.end(),
+                    [&](uint32_t a, uint32_t b) { return m_Slots[a].LastUse < m_Slots[b].LastUse; });
+
+            size_t evicted = 0;
+            for (uint32_t index : candidates) {
+                if (unreferencedBytes <= retainBytes) break;
+                unreferencedBytes -= m_Slots[index].SizeBytes;
+                Evict(index);
+                ++evicted;
+            }
+            return evicted;
+        }
+
+        void Clear()
+        {
+            for (uint32_t i = 0; i < static_cast<uint32_t>(m_Slots.size()); ++i) {
+                if (m_Slots[i].Resource) Evict(i);
+            }
+        }
+
+        auto GetResidentKeys() const -> std::vector<std::string>
+        {
+            std::vector<std::string> keys;
+            keys.reserve(m_Lookup.size());
+            for (const auto& [key, index] : m_Lookup) keys.push_back(key);
+            return keys;
+        }
+
+        auto GetResidentCount() const -> size_t { return m_Lookup.size(); }
+        auto GetResidentBytes() const -> uint64_t { return m_ResidentBytes; }
+
+        auto GetReferencedCount() const -> size_t
+        {
+            return static_cast<size_t>(std::count_if(m_Slots.begin(), m_Slots.end(),
+                    [&](const Slot& slot) { return slot.Resource && IsReferenced(slot); }));
+        }
+
+        auto GetReferencedBytes() const -> uint64_t
+        {
+            uint64_t bytes = 0;
+            for (const Slot& slot : m_Slots) {
+                if (slot.Resource && IsReferenced(slot)) bytes += slot.SizeBytes;
+            }
+            return bytes;
+        }
+
+    private:
+        struct Slot
+        {
+            std::string Key;
+            std::shared_ptr<T> Resource;
+            uint64_t SizeBytes{ 0 };
+            uint64_t LastUse{ 0 };
+            uint32_t Generation{ 1 };  // Starts at 1 so default-constructed handles never resolve
+            uint32_t RefCount{ 0 };
+        };
+
+        static auto IsReferenced(const Slot& slot) -> bool
+        {
+            return slot.RefCount > 0 || slot.Resource.use_count() > 1;
+        }
+
+        auto Resolve(Handle handle) const -> const Slot*
+        {
+            if (handle.Index >= m_Slots.size()) return nullptr;
+            const Slot& slot = m_Slots[handle.Index];
+            return (slot.Resource && slot.Generation == handle.Generation) ? &slot : nullptr;
+        }
+
+        auto Resolve(Handle handle) -> Slot*
+        {
+            return const_cast<Slot*>(static_cast<const ResourcePool*>(this)->Resolve(handle));
+        }
+
+        void Evict(uint32_t index)
+        {
+            Slot& slot = m_Slots[index];
+            m_Lookup.erase(slot.Key);
+            m_ResidentBytes -= slot.SizeBytes;
+            slot.Key.clear();
+            slot.Resource.reset();
+            slot.SizeBytes = 0;
+            slot.RefCount  = 0;
+            ++slot.Generation;
+            m_FreeSlots.push_back(index);
+        }
+
+    private:
+        std::vector<Slot> m_Slots;
+        std::vector<uint32_t> m_FreeSlots;
+        std::unordered_map<std::string, uint32_t> m_Lookup;
+        uint64_t m_UseClock{ 0 };
+        uint64_t m_ResidentBytes{ 0 };
+    };
+}  // namespace Vlkrt
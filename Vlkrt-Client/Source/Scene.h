@@ -7,6 +7,11 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <utility>
 #include <vector>
 #include <string>
 
@@ -99,6 +104,78 @@ namespace Vlkrt
         float Tiling{ 1.0f };
     };
 
+    /// <summary>
+    /// Axis-aligned bounding box. A default-constructed box is empty (Min > Max) and grows through Expand.
+    /// </summary>
+    struct AABB
+    {
+        glm::vec3 Min{ std::numeric_limits<float>::max() };
+        glm::vec3 Max{ std::numeric_limits<float>::lowest() };
+
+        auto IsValid() const -> bool { return Min.x <= Max.x && Min.y <= Max.y && Min.z <= Max.z; }
+        auto GetCenter() const -> glm::vec3 { return (Min + Max) * 0.5f; }
+        auto GetExtent() const -> glm::vec3 { return Max - Min; }
+
+        auto GetSurfaceArea() const -> float
+        {
+            if (!IsValid()) return 0.0f;
+            glm::vec3 e = GetExtent();
+            return 2.0f * (e.x * e.y + e.y * e.z + e.z * e.x);
+        }
+
+        void Expand(const glm::vec3& point)
+        {
+            Min = glm::min(Min, point);
+            Max = glm::max(Max, point);
+        }
+
+        void Expand(const AABB& other)
+        {
+            Min = glm::min(Min, other.Min);
+            Max = glm::max(Max, other.Max);
+        }
+
+        auto Overlaps(const AABB& other) const -> bool
+        {
+            return Min.x <= other.Max.x && Max.x >= other.Min.x && Min.y <= other.Max.y && Max.y >= other.Min.y
+                   && Min.z <= other.Max.z && Max.z >= other.Min.z;
+        }
+
+        // Squared distance from a point to the box (0 when inside)
+        auto DistanceSquared(const glm::vec3& point) const -> float
+        {
+            glm::vec3 d = glm::max(glm::max(Min - point, point - Max), glm::vec3(0.0f));
+            return glm::dot(d, d);
+        }
+
+        // Box enclosing this box after an affine transform (Arvo's method: transform center, project half-extents)
+        auto Transformed(const glm::mat4& transform) const -> AABB
+        {
+            if (!IsValid()) return {};
+            glm::vec3 center = glm::vec3(transform * glm::vec4(GetCenter(), 1.0f));
+            glm::vec3 half   = GetExtent() * 0.5f;
+            glm::vec3 newHalf(0.0f);
+            for (int c = 0; c < 3; ++c) {
+                for (int r = 0; r < 3; ++r) newHalf[r] += std::abs(transform[c][r]) * half[c];
+            }
+            return { center - newHalf, center + newHalf };
+        }
+
+        // Slab test; invDirection is 1 / ray direction. On hit, tEntry is clamped to 0 when the origin is inside.
+        auto IntersectRay(const glm::vec3& origin, const glm::vec3& invDirection, float tMax, float& tEntry) const
+                -> bool
+        {
+            glm::vec3 t0    = (Min - origin) * invDirection;
+            glm::vec3 t1    = (Max - origin) * invDirection;
+            glm::vec3 tNear = glm::min(t0, t1);
+            glm::vec3 tFar  = glm::max(t0, t1);
+            float enter     = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+            float exit      = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, tMax));
+            tEntry          = enter;
+            return enter <= exit;
+        }
+    };
+
     /// <summary>
     /// CPU vertex definition matching the GLSL GPUVertex layout.
     /// </summary>
@@ -110,16 +187,117 @@ namespace Vlkrt
     };
 
     /// <summary>
-    /// Mesh definition containing CPU vertex/index data and material reference.
+    /// Simplified level of detail of a MeshGeometry: a smaller index buffer over the same vertices.
+    /// </summary>
+    struct GeometryLOD
+    {
+        std::vector<uint32_t> Indices;
+        std::vector<uint32_t> TriangleMaterials;  // As MeshGeometry::TriangleMaterials
+        float Error{ 0.0f };                      // Deviation from the full mesh, relative to the bounds' diagonal
+    };
+
+    /// <summary>
+    /// Immutable vertex/index data of a mesh asset. Shared between every Mesh instance that references the same asset
+    /// (see GeometryRegistry), so it must not be modified once published.
+    /// </summary>
+    struct MeshGeometry
+    {
+        std::vector<Vertex> Vertices;
+        std::vector<uint32_t> Indices;
+        AABB LocalBounds;  // Object-space bounds, computed once when the geometry is built
+        // Optional material slot per triangle (OBJ usemtl groups), mapped to a scene material by Mesh::MaterialSlots.
+        // Empty when the whole mesh uses a single material.
+        std::vector<uint32_t> TriangleMaterials;
+        std::vector<std::string> MaterialNames;  // usemtl name of each slot, empty for faces before the first usemtl
+        // Coarser levels in increasing error (see MeshSimplifier); empty unless the scene generates LODs
+        std::vector<GeometryLOD> LODs;
+
+        void ComputeBounds()
+        {
+            LocalBounds = AABB{};
+            for (const auto& vertex : Vertices) LocalBounds.Expand(vertex.Position);
+        }
+    };
+
+    /// <summary>
+    /// Mesh instance: a reference to shared geometry plus per-instance transform and material.
     /// </summary>
     struct Mesh
     {
         std::string Filename;
         std::string Name;
-        std::vector<Vertex> Vertices;
-        std::vector<uint32_t> Indices;
+        std::shared_ptr<const MeshGeometry> Geometry;
         glm::mat4 Transform = glm::mat4(1.0f);
         uint32_t MaterialIndex{ 0 };
+        uint32_t LODIndex{ 0 };  // 0 is the full geometry, n is Geometry->LODs[n - 1]
+        // Scene material of each MeshGeometry::TriangleMaterials slot (kDeclaredMaterial for MaterialIndex). Empty
+        // when every triangle uses MaterialIndex, including when a slot name matched no scene material.
+        std::vector<uint32_t> MaterialSlots;
+
+        static constexpr uint32_t kDeclaredMaterial = UINT32_MAX;
+
+        auto GetVertices() const -> const std::vector<Vertex>&
+        {
+            static const std::vector<Vertex> kEmpty;
+            return Geometry ? Geometry->Vertices : kEmpty;
+        }
+
+        // Indices and per-triangle materials of the selected level of detail
+        auto GetIndices() const -> const std::vector<uint32_t>&
+        {
+            static const std::vector<uint32_t> kEmpty;
+            if (const GeometryLOD* lod = GetLOD()) return lod->Indices;
+            return Geometry ? Geometry->Indices : kEmpty;
+        }
+
+        auto GetTriangleMaterial(size_t triangle) const -> uint32_t
+        {
+            const std::vector<uint32_t>* materialSlots = nullptr;
+            if (const GeometryLOD* lod = GetLOD())
+                materialSlots = &lod->TriangleMaterials;
+            else if (Geometry)
+                materialSlots = &Geometry->TriangleMaterials;
+            if (!materialSlots || triangle >= materialSlots->size()) return MaterialIndex;
+            const uint32_t slot = (*materialSlots)[triangle];
+            if (slot >= MaterialSlots.size() || MaterialSlots[slot] == kDeclaredMaterial) return MaterialIndex;
+            return MaterialSlots[slot];
+        }
+
+        auto GetLODCount() const -> uint32_t
+        {
+            return Geometry ? static_cast<uint32_t>(Geometry->LODs.size()) + 1 : 1;
+        }
+
+        auto GetLocalBounds() const -> const AABB&
+        {
+            static const AABB kEmpty;
+            return Geometry ? Geometry->LocalBounds : kEmpty;
+        }
+
+        // Derived from the cached local bounds on first use and re-derived only when Transform or the geometry's
+        // bounds change, so callers never touch vertex data.
+        auto GetWorldBounds() const -> const AABB&
+        {
+            const AABB& local = GetLocalBounds();
+            if (m_CachedTransform != Transform || m_CachedLocalBounds.Min != local.Min
+                    || m_CachedLocalBounds.Max != local.Max) {
+                m_CachedTransform   = Transform;
+                m_CachedLocalBounds = local;
+                m_CachedWorldBounds = local.Transformed(Transform);
+            }
+            return m_CachedWorldBounds;
+        }
+
+    private:
+        auto GetLOD() const -> const GeometryLOD*
+        {
+            if (!Geometry || LODIndex == 0 || LODIndex > Geometry->LODs.size()) return nullptr;
+            return &Geometry->LODs[LODIndex - 1];
+        }
+
+        mutable glm::mat4 m_CachedTransform{ 1.0f };
+        mutable AABB m_CachedLocalBounds;
+        mutable AABB m_CachedWorldBounds;
     };
 
     /// <summary>
@@ -165,6 +343,10 @@ namespace Vlkrt
         bool IsAnalytic{ true };      // true=analytic, false=SDF
         uint32_t PrimitiveType{ 0 };
         int MaterialIndex{ 0 };
+
+        // Primitives are authored in the unit cube [-1,1]^3 (see AccelerationStructure::BuildAABBBLAS)
+        static auto GetLocalBounds() -> AABB { return { glm::vec3(-1.0f), glm::vec3(1.0f) }; }
+        auto GetWorldBounds() const -> AABB { return GetLocalBounds().Transformed(Transform); }
     };
 
     /// <summary>
@@ -181,9 +363,39 @@ namespace Vlkrt
 
     /// <summary>
     /// Scene entity that supports hierarchical transforms, type-specific data, and scripting.
+    /// Move-only: a hierarchy has a single owner, and Parent pointers refer to entities in place. A move (including
+    /// one by a reallocating Children vector) points the moved entity's children back at it.
     /// </summary>
     struct SceneEntity
     {
+        SceneEntity() = default;
+        SceneEntity(SceneEntity&& other) noexcept { *this = std::move(other); }
+        SceneEntity(const SceneEntity&)            = delete;
+        SceneEntity& operator=(const SceneEntity&) = delete;
+
+        SceneEntity& operator=(SceneEntity&& other) noexcept
+        {
+            if (this == &other) return *this;
+            Name              = std::move(other.Name);
+            Type              = other.Type;
+            LocalTransform    = other.LocalTransform;
+            WorldTransform    = other.WorldTransform;
+            ScriptPath        = std::move(other.ScriptPath);
+            ScriptInitialized = other.ScriptInitialized;
+            IsDirty           = other.IsDirty;
+            Parent            = other.Parent;
+            Bounds            = other.Bounds;
+            Children          = std::move(other.Children);
+            MeshData          = std::move(other.MeshData);
+            LightData         = other.LightData;
+            CameraData        = other.CameraData;
+            ProceduralData    = other.ProceduralData;
+
+            // Grandchildren point at the children, which keep their addresses in the moved vector
+            for (auto& child : Children) child.Parent = this;
+            return *this;
+        }
+
         std::string Name;
         EntityType Type{ EntityType::Empty };
         Transform LocalTransform;
@@ -195,12 +407,16 @@ namespace Vlkrt
         bool IsDirty{ true };
         SceneEntity* Parent{ nullptr };
 
+        // World-space bounds of this entity and all of its descendants (see SceneLoader::UpdateHierarchyBounds)
+        AABB Bounds;
+
         std::vector<SceneEntity> Children;
 
         struct MeshData
         {
             std::string Filename;
             int MaterialIndex{};
+            uint32_t MeshCount{ 0 };  // Flat meshes generated for this entity (a glTF file yields several)
         } MeshData;
 
         struct LightData
@@ -239,16 +455,38 @@ namespace Vlkrt
     };
 
     /// <summary>
-    /// Flat scene definition.
+    /// Flat scene definition. Move-only, so loaders and factories hand scenes over without duplicating their data.
     /// </summary>
     struct Scene
     {
+        Scene()                            = default;
+        Scene(Scene&&) noexcept            = default;
+        Scene& operator=(Scene&&) noexcept = default;
+        Scene(const Scene&)                = delete;
+        Scene& operator=(const Scene&)     = delete;
+
         std::vector<Mesh> StaticMeshes;
         std::vector<Mesh> DynamicMeshes;
         std::vector<Material> Materials;
+        // Interned definition each material was created from (see MaterialRegistry), which keeps it referenced
+        std::vector<std::shared_ptr<const Material>> MaterialSources;
         std::vector<Light> Lights;
         std::vector<ProceduralEntity> ProceduralEntities;
 
+        // Generations of the arrays above, renewed through the Mark*Changed functions by whatever edits them in place
+        // (editor, hierarchy sync and therefore scripts, network updates) so the renderer detects changes by comparing
+        // them rather than rehashing every object each frame. They are unique across scenes, so a newly loaded or
+        // created scene never matches one already seen.
+        uint64_t MeshesGeneration{ NextGeneration() };  // StaticMeshes and DynamicMeshes
+        uint64_t MaterialsGeneration{ NextGeneration() };
+        uint64_t LightsGeneration{ NextGeneration() };
+        uint64_t ProceduralsGeneration{ NextGeneration() };
+
+        void MarkMeshesChanged() { MeshesGeneration = NextGeneration(); }
+        void MarkMaterialsChanged() { MaterialsGeneration = NextGeneration(); }
+        void MarkLightsChanged() { LightsGeneration = NextGeneration(); }
+        void MarkProceduralsChanged() { ProceduralsGeneration = NextGeneration(); }
+
         // Rendering parameters
         RaytracingMode RaytracingType{ RaytracingMode::PathTracing };
         ImportanceSamplingMode ImportanceSampling{ ImportanceSamplingMode::BSDF };
@@ -280,6 +518,13 @@ namespace Vlkrt
         bool EnableFSR{ false };
         uint32_t FSRQualityMode{ 1 };  // 1 = Quality
         float FSRSharpness{ 0.0f };
+        // Reorder mesh geometry for cache locality after loading (MeshOptimizer); spatial sort adds a Morton pass
+        bool OptimizeMeshes{ false };
+        bool SpatialSortMeshes{ false };
+        // Simplified LOD chain generated at load (MeshSimplifier), and the screen-space error allowed when choosing
+        bool GenerateLODs{ false };
+        uint32_t LODLevels{ 3 };
+        float LODPixelError{ 1.0f };
         uint32_t SceneIndex{ 0 };
         glm::vec3 BackgroundColor{ 0.0f };
 
@@ -287,6 +532,14 @@ namespace Vlkrt
         bool HasCameraHint{ false };
         glm::vec3 CameraPosition{ 0.0f, 3.0f, 10.0f };
         glm::vec3 CameraTarget{ 0.0f, 0.0f, 0.0f };
+
+    private:
+        // Scenes are built on loader threads
+        static auto NextGeneration() -> uint64_t
+        {
+            static std::atomic<uint64_t> s_Generation{ 0 };
+            return ++s_Generation;
+        }
     };
 
     /// <summary>
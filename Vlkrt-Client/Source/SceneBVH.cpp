@@ -0,0 +1,245 @@
+#include "SceneBVH.h"
+
+#include <algorithm>
+#include <numeric>
+#include <queue>
+
+namespace Vlkrt
+{
+    namespace
+    {
+        // Refits keep the tree topology; once moved objects have grown the root this much past its built size the
+        // tree is rebuilt instead.
+        constexpr float kRebuildAreaRatio = 4.0f;
+        constexpr int kMaxStackDepth      = 64;
+    }  // namespace
+
+    void SceneBVH::Build(const Scene& scene)
+    {
+        Clear();
+
+        m_MeshLeaves.assign(scene.StaticMeshes.size(), -1);
+        m_ProceduralLeaves.assign(scene.ProceduralEntities.size(), -1);
+        m_Leaves.reserve(scene.StaticMeshes.size() + scene.ProceduralEntities.size());
+
+        for (uint32_t i = 0; i < (uint32_t) scene.StaticMeshes.size(); ++i) {
+            const auto& mesh = scene.StaticMeshes[i];
+            if (!mesh.GetLocalBounds().IsValid()) continue;
+
+            m_MeshLeaves[i] = (int32_t) m_Leaves.size();
+            m_Leaves.push_back({ { EntityType::Mesh, i }, mesh.GetWorldBounds() });
+        }
+        for (uint32_t i = 0; i < (uint32_t) scene.ProceduralEntities.size(); ++i) {
+            const auto& pe        = scene.ProceduralEntities[i];
+            m_ProceduralLeaves[i] = (int32_t) m_Leaves.size();
+            m_Leaves.push_back({ { EntityType::Procedural, i }, pe.GetWorldBounds() });
+        }
+
+        if (m_Leaves.empty()) return;
+
+        std::vector<uint32_t> leafIndices(m_Leaves.size());
+        std::iota(leafIndices.begin(), leafIndices.end(), 0u);
+        m_Nodes.reserve(2 * m_Leaves.size() - 1);
+        BuildRecursive(leafIndices, 0, leafIndices.size(), -1);
+
+        m_BuildRootArea = m_Nodes[0].Bounds.GetSurfaceArea();
+    }
+
+    auto SceneBVH::BuildRecursive(std::vector<uint32_t>& leafIndices, size_t begin, size_t end, int32_t parent)
+            -> int32_t
+    {
+        const int32_t nodeIndex = (int32_t) m_Nodes.size();
+        m_Nodes.emplace_back();
+        m_Nodes[nodeIndex].Parent = parent;
+
+        if (end - begin == 1) {
+            const uint32_t leafIndex  = leafIndices[begin];
+            m_Leaves[leafIndex].Node  = nodeIndex;
+            m_Nodes[nodeIndex].Leaf   = (int32_t) leafIndex;
+            m_Nodes[nodeIndex].Bounds = m_Leaves[leafIndex].WorldBounds;
+            return nodeIndex;
+        }
+
+        // Median split on the axis with the largest centroid spread
+        AABB centroidBounds;
+        for (size_t i = begin; i < end; ++i) centroidBounds.Expand(m_Leaves[leafIndices[i]].WorldBounds.GetCenter());
+        glm::vec3 spread = centroidBounds.GetExtent();
+        int axis         = (spread.x >= spread.y && spread.x >= spread.z) ? 0 : (spread.y >= spread.z ? 1 : 2);
+
+        const size_t mid = begin + (end - begin) / 2;
+        std::nth_element(leafIndices.begin() + begin, leafIndices.begin() + mid, leafIndices.begin() + end,
+                [&](uint32_t a, uint32_t b) {
+                    return m_Leaves[a].WorldBounds.GetCenter()[axis] < m_Leaves[b].WorldBounds.GetCenter()[axis];
+                });
+
+        const int32_t left  = BuildRecursive(leafIndices, begin, mid, nodeIndex);
+        const int32_t right = BuildRecursive(leafIndices, mid, end, nodeIndex);
+
+        Node& node  = m_Nodes[nodeIndex];
+        node.Left   = left;
+        node.Right  = right;
+        node.Bounds = m_Nodes[left].Bounds;
+        node.Bounds.Expand(m_Nodes[right].Bounds);
+        return nodeIndex;
+    }
+
+    void SceneBVH::Refit(
+            const Scene& scene, const std::vector<uint32_t>& dirtyMeshes, const std::vector<uint32_t>& dirtyProcedurals)
+    {
+        if (m_Nodes.empty() && dirtyMeshes.empty() && dirtyProcedurals.empty()) return;
+
+        // Structural changes (items added/removed) cannot be refit
+        if (m_MeshLeaves.size() != scene.StaticMeshes.size()
+                || m_ProceduralLeaves.size() != scene.ProceduralEntities.size()) {
+            Build(scene);
+            return;
+        }
+
+        for (uint32_t meshIdx : dirtyMeshes) {
+            if (meshIdx < m_MeshLeaves.size() && m_MeshLeaves[meshIdx] >= 0) {
+                RefitLeaf(m_MeshLeaves[meshIdx], scene.StaticMeshes[meshIdx].GetWorldBounds());
+            }
+        }
+        for (uint32_t procIdx : dirtyProcedurals) {
+            if (procIdx < m_ProceduralLeaves.size() && m_ProceduralLeaves[procIdx] >= 0) {
+                RefitLeaf(m_ProceduralLeaves[procIdx], scene.ProceduralEntities[procIdx].GetWorldBounds());
+            }
+        }
+
+        if (!m_Nodes.empty() && m_Nodes[0].Bounds.GetSurfaceArea() > kRebuildAreaRatio * m_BuildRootArea) {
+            Build(scene);
+        }
+    }
+
+    void SceneBVH::RefitLeaf(int32_t leafIndex, const AABB& worldBounds)
+    {
+        Leaf& leaf       = m_Leaves[leafIndex];
+        leaf.WorldBounds = worldBounds;
+        Node& leafNode   = m_Nodes[leaf.Node];
+        leafNode.Bounds  = leaf.WorldBounds;
+
+        // Propagate to the root; ancestors are recomputed from their children so shrinking is handled too
+        for (int32_t parent = leafNode.Parent; parent >= 0; parent = m_Nodes[parent].Parent) {
+            Node& node  = m_Nodes[parent];
+            node.Bounds = m_Nodes[node.Left].Bounds;
+            node.Bounds.Expand(m_Nodes[node.Right].Bounds);
+        }
+    }
+
+    void SceneBVH::Clear()
+    {
+        m_Nodes.clear();
+        m_Leaves.clear();
+        m_MeshLeaves.clear();
+        m_ProceduralLeaves.clear();
+        m_BuildRootArea = 0.0f;
+    }
+
+    auto SceneBVH::Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const
+            -> std::optional<SpatialRayHit>
+    {
+        if (m_Nodes.empty()) return std::nullopt;
+
+        const glm::vec3 invDirection = 1.0f / direction;
+        std::optional<SpatialRayHit> closest;
+        float closestT = maxDistance;
+
+        int32_t stack[kMaxStackDepth];
+        int stackSize = 0;
+        float t       = 0.0f;
+        if (m_Nodes[0].Bounds.IntersectRay(origin, invDirection, closestT, t)) stack[stackSize++] = 0;
+
+        while (stackSize > 0) {
+            const Node& node = m_Nodes[stack[--stackSize]];
+
+            if (node.Left < 0) {
+                // Re-test: closestT may have shrunk since this leaf was pushed
+                if (node.Bounds.IntersectRay(origin, invDirection, closestT, t)) {
+                    closestT = t;
+                    closest  = SpatialRayHit{ m_Leaves[node.Leaf].Item, t };
+                }
+                continue;
+            }
+
+            float tLeft = 0.0f, tRight = 0.0f;
+            bool hitLeft  = m_Nodes[node.Left].Bounds.IntersectRay(origin, invDirection, closestT, tLeft);
+            bool hitRight = m_Nodes[node.Right].Bounds.IntersectRay(origin, invDirection, closestT, tRight);
+
+            // Push the farther child first so the nearer one is visited first and tightens closestT sooner
+            if (hitLeft && hitRight) {
+                const bool leftFirst = tLeft <= tRight;
+                stack[stackSize++]   = leftFirst ? node.Right : node.Left;
+                stack[stackSize++]   = leftFirst ? node.Left : node.Right;
+            }
+            else if (hitLeft)
+                stack[stackSize++] = node.Left;
+            else if (hitRight)
+                stack[stackSize++] = node.Right;
+        }
+
+        return closest;
+    }
+
+    void SceneBVH::QueryOverlap(const AABB& box, std::vector<SpatialItem>& outItems) const
+    {
+        if (m_Nodes.empty() || !box.IsValid()) return;
+
+        int32_t stack[kMaxStackDepth];
+        int stackSize      = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0) {
+            const Node& node = m_Nodes[stack[--stackSize]];
+            if (!node.Bounds.Overlaps(box)) continue;
+
+            if (node.Left < 0) {
+                outItems.push_back(m_Leaves[node.Leaf].Item);
+                continue;
+            }
+            stack[stackSize++] = node.Left;
+            stack[stackSize++] = node.Right;
+        }
+    }
+
+    auto SceneBVH::QueryNearest(const glm::vec3& point, uint32_t k) const -> std::vector<SpatialItem>
+    {
+        std::vector<SpatialItem> result;
+        if (m_Nodes.empty() || k == 0) return result;
+        result.reserve(std::min<size_t>(k, m_Leaves.size()));
+
+        // Best-first search: a leaf's node bounds are exactly its item bounds, so leaves pop in distance order
+        using Entry = std::pair<float, int32_t>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        queue.push({ m_Nodes[0].Bounds.DistanceSquared(point), 0 });
+
+        while (!queue.empty() && result.size() < k) {
+            const int32_t nodeIndex = queue.top().second;
+            queue.pop();
+
+            const Node& node = m_Nodes[nodeIndex];
+            if (node.Left < 0) {
+                result.push_back(m_Leaves[node.Leaf].Item);
+                continue;
+            }
+            queue.push({ m_Nodes[node.Left].Bounds.DistanceSquared(point), node.Left });
+            queue.push({ m_Nodes[node.Right].Bounds.DistanceSquared(point), node.Right });
+        }
+
+        return result;
+    }
+
+    auto SceneBVH::GetItemBounds(const SpatialItem& item) const -> AABB
+    {
+        int32_t leaf = LeafForItem(item);
+        return leaf >= 0 ? m_Leaves[leaf].WorldBounds : AABB{};
+    }
+
+    auto SceneBVH::LeafForItem(const SpatialItem& item) const -> int32_t
+    {
+        if (item.Type == EntityType::Mesh)
+            return item.Index < m_MeshLeaves.size() ? m_MeshLeaves[item.Index] : -1;
+        if (item.Type == EntityType::Procedural)
+            return item.Index < m_ProceduralLeaves.size() ? m_ProceduralLeaves[item.Index] : -1;
+        return -1;
+    }
+}  // namespace Vlkrt
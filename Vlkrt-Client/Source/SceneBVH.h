@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Scene.h"
+
+#include <cfloat>
+#include <optional>
+#include <vector>
+
+namespace Vlkrt
+{
+    /// <summary>
+    /// Reference to an object stored in the flat Scene arrays (StaticMeshes or ProceduralEntities).
+    /// </summary>
+    struct SpatialItem
+    {
+        EntityType Type{ EntityType::Mesh };
+        uint32_t Index{ 0 };
+
+        auto operator==(const SpatialItem& other) const -> bool = default;
+    };
+
+    struct SpatialRayHit
+    {
+        SpatialItem Item;
+        float Distance{ 0.0f };  // Distance along the ray to the item's world-space bounds
+    };
+
+    /// <summary>
+    /// CPU bounding volume hierarchy over the world-space AABBs of static meshes and procedural entities.
+    /// Built once per scene load and refit in place when transforms change; rebuilt automatically when refits have
+    /// degraded the tree too much. Queries work on bounds only, which is what picking, broad-phase collision and
+    /// culling need.
+    /// </summary>
+    class SceneBVH
+    {
+    public:
+        void Build(const Scene& scene);
+        void Refit(const Scene& scene, const std::vector<uint32_t>& dirtyMeshes,
+                const std::vector<uint32_t>& dirtyProcedurals);
+        void Clear();
+
+        // Closest item whose bounds the ray enters, within maxDistance. direction does not need to be normalized.
+        auto Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance = FLT_MAX) const
+                -> std::optional<SpatialRayHit>;
+        // Appends every item whose bounds overlap the box.
+        void QueryOverlap(const AABB& box, std::vector<SpatialItem>& outItems) const;
+        // Up to k items ordered by distance from the point to their bounds.
+        auto QueryNearest(const glm::vec3& point, uint32_t k) const -> std::vector<SpatialItem>;
+
+        auto GetItemBounds(const SpatialItem& item) const -> AABB;
+        auto GetRootBounds() const -> AABB { return m_Nodes.empty() ? AABB{} : m_Nodes[0].Bounds; }
+        auto GetItemCount() const -> size_t { return m_Leaves.size(); }
+        auto GetNodeCount() const -> size_t { return m_Nodes.size(); }
+
+    private:
+        struct Node
+        {
+            AABB Bounds;
+            int32_t Left{ -1 };  // Interior nodes: child indices. Leaves: Left == -1 and Leaf is set
+            int32_t Right{ -1 };
+            int32_t Parent{ -1 };
+            int32_t Leaf{ -1 };
+        };
+
+        struct Leaf
+        {
+            SpatialItem Item;
+            AABB WorldBounds;
+            int32_t Node{ -1 };
+        };
+
+        auto BuildRecursive(std::vector<uint32_t>& leafIndices, size_t begin, size_t end, int32_t parent) -> int32_t;
+        auto LeafForItem(const SpatialItem& item) const -> int32_t;
+        void RefitLeaf(int32_t leafIndex, const AABB& worldBounds);
+
+    private:
+        std::vector<Node> m_Nodes;
+        std::vector<Leaf> m_Leaves;
+        std::vector<int32_t> m_MeshLeaves;        // StaticMeshes index -> leaf
+        std::vector<int32_t> m_ProceduralLeaves;  // ProceduralEntities index -> leaf
+        float m_BuildRootArea{ 0.0f };
+    };
+}  // namespace Vlkrt
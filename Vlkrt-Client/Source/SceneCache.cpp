@@ -0,0 +1,583 @@
+#include "SceneCache.h"
+#include "GeometryRegistry.h"
+#include "MaterialRegistry.h"
+#include "MappedFile.h"
+#include "Utils.h"
+
+#include "Walnut/Core/Log.h"
+#include "Walnut/Timer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace Vlkrt
+{
+    namespace
+    {
+        constexpr uint32_t kMagic   = 0x4353'4B56;  // "VKSC"
+        constexpr uint32_t kVersion = 6;            // Bump whenever the layout below changes
+
+        struct Header
+        {
+            uint32_t Magic{ kMagic };
+            uint32_t Version{ kVersion };
+            uint32_t VertexSize{ sizeof(Vertex) };
+            uint32_t Reserved{ 0 };
+            uint64_t SourceKey{ 0 };
+        };
+
+        class BinaryWriter
+        {
+        public:
+            template <typename T>
+                requires std::is_trivially_copyable_v<T>
+            void operator()(const T& value)
+            {
+                WriteBytes(&value, sizeof(T));
+            }
+
+            void operator()(const std::string& value)
+            {
+                (*this)(static_cast<uint32_t>(value.size()));
+                WriteBytes(value.data(), value.size());
+            }
+
+            void WriteBytes(const void* data, size_t size)
+            {
+                const auto* bytes = static_cast<const uint8_t*>(data);
+                m_Data.insert(m_Data.end(), bytes, bytes + size);
+            }
+
+            auto GetData() const -> const std::vector<uint8_t>& { return m_Data; }
+
+        private:
+            std::vector<uint8_t> m_Data;
+        };
+
+        // Reads straight out of the mapped file; throws on truncated or corrupt data.
+        class BinaryReader
+        {
+        public:
+            BinaryReader(const uint8_t* data, size_t size) : m_Data(data), m_Size(size) {}
+
+            template <typename T>
+                requires std::is_trivially_copyable_v<T>
+            void operator()(T& value)
+            {
+                std::memcpy(&value, Take(sizeof(T)), sizeof(T));
+            }
+
+            void operator()(std::string& value)
+            {
+                uint32_t size = 0;
+                (*this)(size);
+                value.assign(reinterpret_cast<const char*>(Take(size)), size);
+            }
+
+            auto Take(size_t size) -> const uint8_t*
+            {
+                if (size > m_Size - m_Offset) throw std::runtime_error("unexpected end of baked scene");
+                const uint8_t* data = m_Data + m_Offset;
+                m_Offset += size;
+                return data;
+            }
+
+        private:
+            const uint8_t* m_Data;
+            size_t m_Size;
+            size_t m_Offset{ 0 };
+        };
+
+        // Field lists shared by saving and loading; Archive is BinaryWriter (const objects) or BinaryReader.
+        template <typename Archive, typename MaterialT>
+        static void VisitMaterial(Archive& ar, MaterialT& mat)
+        {
+            ar(mat.Name);
+            ar(mat.Albedo);
+            ar(mat.Emission);
+            ar(mat.Extinction);
+            ar(mat.AtDistance);
+            ar(mat.Roughness);
+            ar(mat.Metallic);
+            ar(mat.Subsurface);
+            ar(mat.Anisotropic);
+            ar(mat.Sheen);
+            ar(mat.SheenTint);
+            ar(mat.Clearcoat);
+            ar(mat.ClearcoatGloss);
+            ar(mat.SpecularTint);
+            ar(mat.SpecularTransmission);
+            ar(mat.Eta);
+            ar(mat.StepScale);
+            ar(mat.MaterialIndex);
+            ar(mat.LightIndex);
+            ar(mat.TextureFilename);
+            ar(mat.TextureAlbedoFilename);
+            ar(mat.TextureNormalFilename);
+            ar(mat.TextureMetallicRoughnessFilename);
+            ar(mat.TextureEmissiveFilename);
+            ar(mat.TextureOcclusionFilename);
+            ar(mat.Tiling);
+        }
+
+        template <typename Archive, typename SceneT>
+        static void VisitSettings(Archive& ar, SceneT& scene)
+        {
+            ar(scene.RaytracingType);
+            ar(scene.ImportanceSampling);
+            ar(scene.MaxRecursionDepth);
+            ar(scene.MaxShadowRecursionDepth);
+            ar(scene.PathSqrtSamplesPerPixel);
+            ar(scene.ApplyJitter);
+            ar(scene.OnlyOneLightSample);
+            ar(scene.RussianRouletteDepth);
+            ar(scene.AnisotropicBSDF);
+            ar(scene.EnableNRDDenoiser);
+            ar(scene.EnableDenoiseMetrics);
+            ar(scene.EnableFSR);
+            ar(scene.FSRQualityMode);
+            ar(scene.FSRSharpness);
+            ar(scene.OptimizeMeshes);
+            ar(scene.SpatialSortMeshes);
+            ar(scene.GenerateLODs);
+            ar(scene.LODLevels);
+            ar(scene.LODPixelError);
+            ar(scene.SceneIndex);
+            ar(scene.BackgroundColor);
+            ar(scene.HasCameraHint);
+            ar(scene.CameraPosition);
+            ar(scene.CameraTarget);
+        }
+
+        template <typename Archive, typename EntityT>
+        static void VisitEntityFields(Archive& ar, EntityT& entity)
+        {
+            ar(entity.Name);
+            ar(entity.Type);
+            ar(entity.LocalTransform);
+            ar(entity.ScriptPath);
+            ar(entity.MeshData.Filename);
+            ar(entity.MeshData.MaterialIndex);
+            ar(entity.MeshData.MeshCount);
+            ar(entity.LightData);
+            ar(entity.CameraData);
+            ar(entity.ProceduralData);
+        }
+
+        static void WriteEntity(BinaryWriter& writer, const SceneEntity& entity)
+        {
+            VisitEntityFields(writer, entity);
+            writer(static_cast<uint32_t>(entity.Children.size()));
+            for (const auto& child : entity.Children) WriteEntity(writer, child);
+        }
+
+        static void ReadEntity(BinaryReader& reader, SceneEntity& entity, SceneEntity* parent)
+        {
+            VisitEntityFields(reader, entity);
+            entity.Parent = parent;
+
+            uint32_t childCount = 0;
+            reader(childCount);
+            // Reserved up front so that children never move and their Parent pointers stay valid
+            entity.Children.reserve(childCount);
+            for (uint32_t i = 0; i < childCount; ++i) ReadEntity(reader, entity.Children.emplace_back(), &entity);
+        }
+
+        // Where the mesh loaders find a model file (see MeshLoader), or empty if there is none
+        static auto ResolveDependency(const std::string& filename) -> std::filesystem::path
+        {
+            const std::filesystem::path candidates[] = { std::filesystem::path(Vlkrt::MODELS_DIR) / filename,
+                std::filesystem::path(Vlkrt::SCENES_DIR) / filename, std::filesystem::path(filename) };
+            for (const auto& candidate : candidates) {
+                std::error_code ec;
+                if (std::filesystem::is_regular_file(candidate, ec)) return candidate;
+            }
+            return {};
+        }
+
+        static auto DecodeURI(std::string_view uri) -> std::string
+        {
+            auto hexValue = [](char c) -> int {
+                if (c >= '0' && c <= '9') return c - '0';
+                if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+                if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+                return -1;
+            };
+
+            std::string decoded;
+            decoded.reserve(uri.size());
+            for (size_t i = 0; i < uri.size(); ++i) {
+                if (uri[i] == '%' && i + 2 < uri.size() && hexValue(uri[i + 1]) >= 0 && hexValue(uri[i + 2]) >= 0) {
+                    decoded += static_cast<char>(hexValue(uri[i + 1]) * 16 + hexValue(uri[i + 2]));
+                    i += 2;
+                }
+                else if (uri[i] == '\\' && i + 1 < uri.size() && uri[i + 1] == '/') {
+                    decoded += '/';  // JSON-escaped slash
+                    ++i;
+                }
+                else {
+                    decoded += uri[i];
+                }
+            }
+            return decoded;
+        }
+
+        // Buffers and images a glTF file loads from beside it, named relative to the file the way the file itself
+        // is named; data: URIs are part of the file and need no entry
+        static void CollectExternalURIs(const std::string& gltfFilename, std::vector<std::string>& outFiles)
+        {
+            const std::filesystem::path path = ResolveDependency(gltfFilename);
+            if (path.empty()) return;
+            std::ifstream file(path, std::ios::binary);
+            if (!file.is_open()) return;
+
+            // A .glb keeps its JSON in the first chunk, after the 12-byte file header and the 8-byte chunk header
+            std::string json;
+            char magic[4] = {};
+            file.read(magic, sizeof(magic));
+            if (file && std::memcmp(magic, "glTF", sizeof(magic)) == 0) {
+                uint32_t header[4] = {};  // Version, total length, JSON chunk length, JSON chunk type
+                file.read(reinterpret_cast<char*>(header), sizeof(header));
+                if (!file || header[3] != 0x4E4F'534A) return;  // "JSON"
+                json.resize(header[2]);
+                file.read(json.data(), header[2]);
+                if (!file) return;
+            }
+            else {
+                file.clear();
+                file.seekg(0);
+                json.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            }
+
+            // Only buffers and images have a "uri" member, so a plain scan finds them without parsing the document
+            const std::string directory = std::filesystem::path(gltfFilename).parent_path().generic_string();
+            size_t pos                  = 0;
+            while ((pos = json.find("\"uri\"", pos)) != std::string::npos) {
+                pos += 5;
+                const size_t open = json.find_first_not_of(" \t\r\n:", pos);
+                if (open == std::string::npos || json[open] != '"') continue;
+                const size_t close = json.find('"', open + 1);
+                if (close == std::string::npos) break;
+                pos = close + 1;
+
+                const std::string uri = DecodeURI(std::string_view(json).substr(open + 1, close - open - 1));
+                if (uri.empty() || uri.rfind("data:", 0) == 0) continue;
+                std::string dependency = directory.empty() ? uri : directory + "/" + uri;
+                if (std::find(outFiles.begin(), outFiles.end(), dependency) == outFiles.end()) {
+                    outFiles.push_back(std::move(dependency));
+                }
+            }
+        }
+
+        // Model files, and the buffers and images of glTF ones, that the baked geometry was built from
+        static void CollectDependencies(const SceneEntity& entity, std::vector<std::string>& outFiles)
+        {
+            if (entity.Type == EntityType::Mesh && !entity.MeshData.Filename.empty()
+                    && std::find(outFiles.begin(), outFiles.end(), entity.MeshData.Filename) == outFiles.end()) {
+                outFiles.push_back(entity.MeshData.Filename);
+
+                std::string ext = std::filesystem::path(entity.MeshData.Filename).extension().string();
+                std::transform(ext.begin(), ext.end(), ext.begin(),
+                        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+                if (ext == ".gltf" || ext == ".glb") CollectExternalURIs(entity.MeshData.Filename, outFiles);
+            }
+            for (const auto& child : entity.Children) CollectDependencies(child, outFiles);
+        }
+
+        // Size and modification time of a dependency, looked up the same way the mesh loaders resolve it
+        static auto HashDependency(uint64_t hash, const std::string& filename) -> uint64_t
+        {
+            hash = HashBytes(hash, filename.data(), filename.size());
+
+            const std::filesystem::path path = ResolveDependency(filename);
+            if (!path.empty()) {
+                std::error_code ec;
+                const uint64_t size = std::filesystem::file_size(path, ec);
+                const int64_t time  = ec ? 0 : std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+                if (!ec) {
+                    hash = HashBytes(hash, &size, sizeof(size));
+                    return HashBytes(hash, &time, sizeof(time));
+                }
+            }
+
+            const uint64_t missing = ~0ull;
+            return HashBytes(hash, &missing, sizeof(missing));
+        }
+
+        static auto ComputeSourceKey(
+                const std::filesystem::path& yamlPath, const std::vector<std::string>& dependencies, uint64_t& outKey)
+                -> bool
+        {
+            std::ifstream file(yamlPath, std::ios::binary);
+            if (!file.is_open()) return false;
+            const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+            uint64_t key = HashBytes(kFNVOffsetBasis, text.data(), text.size());
+            for (const auto& dependency : dependencies) key = HashDependency(key, dependency);
+            outKey = key;
+            return true;
+        }
+    }  // namespace
+
+    auto SceneCache::GetCachePath(const std::string& filename) -> std::filesystem::path
+    {
+        std::filesystem::path path = std::filesystem::path(Vlkrt::SCENES_DIR) / filename;
+        path.replace_extension(".vkscene");
+        return path;
+    }
+
+    auto SceneCache::TryLoad(const std::string& filename, Scene& scene, SceneEntity& sceneRoot) -> bool
+    {
+        scene     = Scene{};
+        sceneRoot = SceneEntity{};
+
+        MappedFile file(GetCachePath(filename));
+        if (!file.IsOpen()) return false;
+
+        Walnut::Timer timer;
+        try {
+            BinaryReader reader(file.GetData(), file.GetSize());
+
+            Header header;
+            reader(header);
+            if (header.Magic != kMagic || header.Version != kVersion || header.VertexSize != sizeof(Vertex)) {
+                WL_INFO_TAG("SceneCache", "Ignoring baked scene for '{}' written by another version", filename);
+                return false;
+            }
+
+            uint32_t dependencyCount = 0;
+            reader(dependencyCount);
+            std::vector<std::string> dependencies(dependencyCount);
+            for (auto& dependency : dependencies) reader(dependency);
+
+            uint64_t sourceKey = 0;
+            if (!ComputeSourceKey(std::filesystem::path(Vlkrt::SCENES_DIR) / filename, dependencies, sourceKey)
+                    || sourceKey != header.SourceKey) {
+                WL_INFO_TAG("SceneCache", "Baked scene for '{}' is out of date", filename);
+                return false;
+            }
+
+            VisitSettings(reader, scene);
+
+            uint32_t count = 0;
+            reader(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                Material mat;
+                VisitMaterial(reader, mat);
+                MaterialRegistry::AddToScene(scene, mat);
+            }
+
+            // Geometry blobs are registered under the bake's key, so reloading the same bake shares them
+            reader(count);
+            std::vector<std::shared_ptr<const MeshGeometry>> geometries(count);
+            const std::string registryPrefix = "baked:" + filename + ":" + std::to_string(header.SourceKey) + ":";
+            for (uint32_t i = 0; i < count; ++i) {
+                uint32_t vertexCount = 0, indexCount = 0, triangleMaterialCount = 0;
+                AABB bounds;
+                reader(vertexCount);
+                reader(indexCount);
+                reader(triangleMaterialCount);
+                reader(bounds);
+                const uint8_t* vertices          = reader.Take(vertexCount * sizeof(Vertex));
+                const uint8_t* indices           = reader.Take(indexCount * sizeof(uint32_t));
+                const uint8_t* triangleMaterials = reader.Take(triangleMaterialCount * sizeof(uint32_t));
+
+                uint32_t materialNameCount = 0;
+                reader(materialNameCount);
+                std::vector<std::string> materialNames(materialNameCount);
+                for (auto& name : materialNames) reader(name);
+
+                uint32_t lodCount = 0;
+                reader(lodCount);
+                std::vector<GeometryLOD> lods(lodCount);
+                for (auto& lod : lods) {
+                    uint32_t lodIndexCount = 0, lodTriangleMaterialCount = 0;
+                    reader(lodIndexCount);
+                    reader(lodTriangleMaterialCount);
+                    reader(lod.Error);
+                    const uint8_t* lodIndices   = reader.Take(lodIndexCount * sizeof(uint32_t));
+                    const uint8_t* lodMaterials = reader.Take(lodTriangleMaterialCount * sizeof(uint32_t));
+                    lod.Indices.resize(lodIndexCount);
+                    lod.TriangleMaterials.resize(lodTriangleMaterialCount);
+                    std::memcpy(lod.Indices.data(), lodIndices, lodIndexCount * sizeof(uint32_t));
+                    std::memcpy(lod.TriangleMaterials.data(), lodMaterials,
+                            lodTriangleMaterialCount * sizeof(uint32_t));
+                }
+
+                geometries[i] = GeometryRegistry::GetOrCreate(registryPrefix + std::to_string(i), [&] {
+                    auto geometry = std::make_shared<MeshGeometry>();
+                    geometry->Vertices.resize(vertexCount);
+                    geometry->Indices.resize(indexCount);
+                    std::memcpy(geometry->Vertices.data(), vertices, vertexCount * sizeof(Vertex));
+                    std::memcpy(geometry->Indices.data(), indices, indexCount * sizeof(uint32_t));
+                    geometry->TriangleMaterials.resize(triangleMaterialCount);
+                    std::memcpy(geometry->TriangleMaterials.data(), triangleMaterials,
+                            triangleMaterialCount * sizeof(uint32_t));
+                    geometry->MaterialNames = std::move(materialNames);
+                    geometry->LocalBounds   = bounds;
+                    geometry->LODs          = std::move(lods);
+                    return std::shared_ptr<const MeshGeometry>(std::move(geometry));
+                });
+            }
+
+            reader(count);
+            scene.StaticMeshes.resize(count);
+            for (auto& mesh : scene.StaticMeshes) {
+                uint32_t geometryIndex = 0;
+                reader(mesh.Name);
+                reader(mesh.Filename);
+                reader(geometryIndex);
+                reader(mesh.Transform);
+                reader(mesh.MaterialIndex);
+                uint32_t materialSlotCount = 0;
+                reader(materialSlotCount);
+                mesh.MaterialSlots.resize(materialSlotCount);
+                for (auto& slot : mesh.MaterialSlots) reader(slot);
+                if (geometryIndex < geometries.size()) mesh.Geometry = geometries[geometryIndex];
+            }
+
+            reader(count);
+            scene.Lights.resize(count);
+            for (auto& light : scene.Lights) reader(light);
+
+            reader(count);
+            scene.ProceduralEntities.resize(count);
+            for (auto& pe : scene.ProceduralEntities) {
+                reader(pe.Name);
+                reader(pe.Transform);
+                reader(pe.IsAnalytic);
+                reader(pe.PrimitiveType);
+                reader(pe.MaterialIndex);
+            }
+
+            ReadEntity(reader, sceneRoot, nullptr);
+        }
+        catch (const std::exception& e) {
+            WL_WARN_TAG("SceneCache", "Failed to read baked scene for '{}': {}", filename, e.what());
+            scene     = Scene{};
+            sceneRoot = SceneEntity{};
+            return false;
+        }
+
+        WL_INFO_TAG("SceneCache", "Loaded baked scene '{}' ({} meshes) in {:.2f} ms", filename,
+                scene.StaticMeshes.size(), timer.ElapsedMillis());
+        return true;
+    }
+
+    auto SceneCache::Save(const std::string& filename, const Scene& scene, const SceneEntity& sceneRoot) -> bool
+    {
+        std::vector<std::string> dependencies;
+        CollectDependencies(sceneRoot, dependencies);
+
+        Header header;
+        if (!ComputeSourceKey(std::filesystem::path(Vlkrt::SCENES_DIR) / filename, dependencies, header.SourceKey)) {
+            return false;
+        }
+
+        BinaryWriter writer;
+        writer(header);
+        writer(static_cast<uint32_t>(dependencies.size()));
+        for (const auto& dependency : dependencies) writer(dependency);
+
+        VisitSettings(writer, scene);
+
+        writer(static_cast<uint32_t>(scene.Materials.size()));
+        for (const auto& mat : scene.Materials) VisitMaterial(writer, mat);
+
+        // Each distinct geometry is written once; meshes refer to it by index
+        std::vector<const MeshGeometry*> geometries;
+        std::unordered_map<const MeshGeometry*, uint32_t> geometryIndices;
+        for (const auto& mesh : scene.StaticMeshes) {
+            if (!mesh.Geometry) continue;
+            if (geometryIndices.try_emplace(mesh.Geometry.get(), (uint32_t) geometries.size()).second) {
+                geometries.push_back(mesh.Geometry.get());
+            }
+        }
+
+        writer(static_cast<uint32_t>(geometries.size()));
+        for (const MeshGeometry* geometry : geometries) {
+            writer(static_cast<uint32_t>(geometry->Vertices.size()));
+            writer(static_cast<uint32_t>(geometry->Indices.size()));
+            writer(static_cast<uint32_t>(geometry->TriangleMaterials.size()));
+            writer(geometry->LocalBounds);
+            writer.WriteBytes(geometry->Vertices.data(), geometry->Vertices.size() * sizeof(Vertex));
+            writer.WriteBytes(geometry->Indices.data(), geometry->Indices.size() * sizeof(uint32_t));
+            writer.WriteBytes(
+                    geometry->TriangleMaterials.data(), geometry->TriangleMaterials.size() * sizeof(uint32_t));
+            writer(static_cast<uint32_t>(geometry->MaterialNames.size()));
+            for (const auto& name : geometry->MaterialNames) writer(name);
+
+            writer(static_cast<uint32_t>(geometry->LODs.size()));
+            for (const auto& lod : geometry->LODs) {
+                writer(static_cast<uint32_t>(lod.Indices.size()));
+                writer(static_cast<uint32_t>(lod.TriangleMaterials.size()));
+                writer(lod.Error);
+                writer.WriteBytes(lod.Indices.data(), lod.Indices.size() * sizeof(uint32_t));
+                writer.WriteBytes(lod.TriangleMaterials.data(), lod.TriangleMaterials.size() * sizeof(uint32_t));
+            }
+        }
+
+        writer(static_cast<uint32_t>(scene.StaticMeshes.size()));
+        for (const auto& mesh : scene.StaticMeshes) {
+            writer(mesh.Name);
+            writer(mesh.Filename);
+            writer(mesh.Geometry ? geometryIndices.at(mesh.Geometry.get()) : UINT32_MAX);
+            writer(mesh.Transform);
+            writer(mesh.MaterialIndex);
+            writer(static_cast<uint32_t>(mesh.MaterialSlots.size()));
+            for (uint32_t slot : mesh.MaterialSlots) writer(slot);
+        }
+
+        writer(static_cast<uint32_t>(scene.Lights.size()));
+        for (const auto& light : scene.Lights) writer(light);
+
+        writer(static_cast<uint32_t>(scene.ProceduralEntities.size()));
+        for (const auto& pe : scene.ProceduralEntities) {
+            writer(pe.Name);
+            writer(pe.Transform);
+            writer(pe.IsAnalytic);
+            writer(pe.PrimitiveType);
+            writer(pe.MaterialIndex);
+        }
+
+        WriteEntity(writer, sceneRoot);
+
+        // Write to a temporary file and rename, so a reader never maps a half-written bake
+        const std::filesystem::path cachePath = GetCachePath(filename);
+        std::filesystem::path tempPath        = cachePath;
+        tempPath += ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                WL_WARN_TAG("SceneCache", "Failed to open '{}' for writing", tempPath.string());
+                return false;
+            }
+            const auto& data = writer.GetData();
+            file.write(reinterpret_cast<const char*>(data.data()), (std::streamsize) data.size());
+            if (!file) {
+                WL_WARN_TAG("SceneCache", "Failed to write '{}'", tempPath.string());
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath, cachePath, ec);
+        if (ec) {
+            WL_WARN_TAG("SceneCache", "Failed to replace '{}': {}", cachePath.string(), ec.message());
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+
+        WL_INFO_TAG("SceneCache", "Baked scene '{}' ({} geometries, {:.1f} MB)", filename, geometries.size(),
+                writer.GetData().size() / (1024.0 * 1024.0));
+        return true;
+    }
+}  // namespace Vlkrt
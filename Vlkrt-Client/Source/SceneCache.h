@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Scene.h"
+
+#include <filesystem>
+#include <string>
+
+namespace Vlkrt
+{
+    /// <summary>
+    /// Versioned binary bake of a YAML scene: hierarchy, flat scene, materials (with their texture references) and the
+    /// vertex/index data of every distinct geometry. Stored next to the YAML file and memory-mapped on load, so that a
+    /// baked scene skips YAML parsing and all OBJ/glTF decoding.
+    /// A bake is keyed by a hash of the YAML text and of the size and modification time of every model file it
+    /// references; any change makes TryLoad fail and the scene is loaded (and re-baked) from source.
+    /// </summary>
+    class SceneCache
+    {
+    public:
+        // filename is relative to SCENES_DIR, as for SceneLoader. Outputs are reset first and left empty on failure.
+        static auto TryLoad(const std::string& filename, Scene& outScene, SceneEntity& outRoot) -> bool;
+        static auto Save(const std::string& filename, const Scene& scene, const SceneEntity& root) -> bool;
+        static auto GetCachePath(const std::string& filename) -> std::filesystem::path;
+    };
+}  // namespace Vlkrt
@@ -1,4 +1,5 @@
 #include "SceneFactory.h"
+#include "MaterialRegistry.h"
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <random>
@@ -33,7 +34,7 @@ namespace Vlkrt
             m.Albedo        = glm::vec3(0.9f);
             m.Roughness     = 0.4f;
             m.MaterialIndex = 0;
-            scene.Materials.push_back(m);
+            MaterialRegistry::AddToScene(scene, m);
         }
         // Index 1: white wall (back, top/bottom)
         {
@@ -42,7 +43,7 @@ namespace Vlkrt
             m.Albedo        = glm::vec3(0.9f);
             m.Roughness     = 1.0f;
             m.MaterialIndex = 1;
-            scene.Materials.push_back(m);
+            MaterialRegistry::AddToScene(scene, m);
         }
         // Index 2: green wall (left)
         {
@@ -51,7 +52,7 @@ namespace Vlkrt
             m.Albedo        = glm::vec3(0.2f, 0.8f, 0.2f);
             m.Roughness     = 1.0f;
             m.MaterialIndex = 2;
-            scene.Materials.push_back(m);
+            MaterialRegistry::AddToScene(scene, m);
         }
         // Index 3: red wall (right)
         {
@@ -60,7 +61,7 @@ namespace Vlkrt
             m.Albedo        = glm::vec3(0.8f, 0.1f, 0.1f);
             m.Roughness     = 1.0f;
             m.MaterialIndex = 3;
-            scene.Materials.push_back(m);
+            MaterialRegistry::AddToScene(scene, m);
         }
         // Index 4: light emission material (area light mesh)
         {
@@ -71,7 +72,7 @@ namespace Vlkrt
             m.Roughness     = 1.0f;
             m.MaterialIndex = 4;
             m.LightIndex    = 0;
-            scene.Materials.push_back(m);
+            MaterialRegistry::AddToScene(scene, m);
         }
         // Index 5: AABB box material (white, subsurface)
         {
@@ -83,7 +84,7 @@ namespace Vlkrt
             m.Eta           = 1.7f;
             m.Extinction    = glm::vec3(1.0f, 0.9f, 1.0f);
             m.MaterialIndex = 5;
-            scene.Materials.push_back(m);
+            MaterialRegistry::AddToScene(scene, m);
         }
         // Index 6: sphere material (chrome reflective)
         {
@@ -95,7 +96,7 @@ namespace Vlkrt
             m.Extinction    = glm::vec3(0.7f, 1.0f, 1.0f);
             m.Eta           = 1.5f;
             m.MaterialIndex = 6;
-            scene.Materials.push_back(m);
+            MaterialRegistry::AddToScene(scene, m);
         }
 
         // Area Light
@@ -122,7 +123,7 @@ namespace Vlkrt
             m.Transform     = glm::mat4(1.0f);
             AddQuad(m, glm::vec3(x0, y0, z0), glm::vec3(x1, y0, z0), glm::vec3(x1, y0, z1), glm::vec3(x0, y0, z1),
                     glm::vec3(0, 1, 0), 0);
-            scene.StaticMeshes.push_back(m);
+            scene.StaticMeshes.push_back(std::move(m));
         }
         // Ceiling (mat 1 white)
         {
@@ -132,7 +133,7 @@ namespace Vlkrt
             m.Transform     = glm::mat4(1.0f);
             AddQuad(m, glm::vec3(x0, y1, z1), glm::vec3(x1, y1, z1), glm::vec3(x1, y1, z0), glm::vec3(x0, y1, z0),
                     glm::vec3(0, -1, 0), 1);
-            scene.StaticMeshes.push_back(m);
+            scene.StaticMeshes.push_back(std::move(m));
         }
         // Back wall (mat 1 white)
         {
@@ -142,7 +143,7 @@ namespace Vlkrt
             m.Transform     = glm::mat4(1.0f);
             AddQuad(m, glm::vec3(x0, y0, z0), glm::vec3(x0, y1, z0), glm::vec3(x1, y1, z0), glm::vec3(x1, y0, z0),
                     glm::vec3(0, 0, 1), 1);
-            scene.StaticMeshes.push_back(m);
+            scene.StaticMeshes.push_back(std::move(m));
         }
         // Left wall (green)
         {
@@ -152,7 +153,7 @@ namespace Vlkrt
             m.Transform     = glm::mat4(1.0f);
             AddQuad(m, glm::vec3(x0, y0, z1), glm::vec3(x0, y1, z1), glm::vec3(x0, y1, z0), glm::vec3(x0, y0, z0),
                     glm::vec3(1, 0, 0), 2);
-            scene.StaticMeshes.push_back(m);
+            scene.StaticMeshes.push_back(std::move(m));
         }
         // Right wall (red)
         {
@@ -162,7 +163,7 @@ namespace Vlkrt
             m.Transform     = glm::mat4(1.0f);
             AddQuad(m, glm::vec3(x1, y0, z0), glm::vec3(x1, y1, z0), glm::vec3(x1, y1, z1), glm::vec3(x1, y0, z1),
                     glm::vec3(-1, 0, 0), 3);
-            scene.StaticMeshes.push_back(m);
+            scene.StaticMeshes.push_back(std::move(m));
         }
         // Area light quad mesh
         {
@@ -173,7 +174,7 @@ namespace Vlkrt
             m.Transform     = glm::mat4(1.0f);
             AddQuad(m, glm::vec3(-s, 4.799f, -1.5f - s), glm::vec3(s, 4.799f, -1.5f - s),
                     glm::vec3(s, 4.799f, -1.5f + s), glm::vec3(-s, 4.799f, -1.5f + s), glm::vec3(0, -1, 0), 4);
-            scene.StaticMeshes.push_back(m);
+            scene.StaticMeshes.push_back(std::move(m));
         }
 
         // Procedural primitives
@@ -221,7 +222,7 @@ namespace Vlkrt
             m.Albedo        = glm::vec3(0.9f);
             m.Roughness     = 0.4f;
             m.MaterialIndex = 0;
-            scene.Materials.push_back(m);
+            MaterialRegistry::AddToScene(scene, m);
         }
         // 1: AABB orange (transmission)
         {
@@ -234,7 +235,7 @@ namespace Vlkrt
             m.Subsurface           = 1.0f;
             m.Extinction           = glm::vec3(1.0f, 0.9f, 1.0f);
             m.MaterialIndex        = 1;
-            scene.Materials.push_back(m);
+            MaterialRegistry::AddToScene(scene, m);
         }
         // 2: sphere red (transmission)
         {
@@ -245,7 +246,7 @@ namespace Vlkrt
             m.Eta                  = 1.5f;
             m.Extinction           = glm::vec3(0.7f, 1.0f, 1.0f);
             m.MaterialIndex        = 2;
-            scene.Materials.push_back(m);
+            MaterialRegistry::AddToScene(scene, m);
         }
         // 3: IntersectedRoundCube green
         {
@@ -254,7 +255,7 @@ namespace Vlkrt
             m.Albedo        = glm::vec3(0.2f, 0.8f, 0.2f);
             m.Roughness     = 0.8f;
             m.MaterialIndex = 3;
-            scene.Materials.push_back(m);
+            MaterialRegistry::AddToScene(scene, m);
         }
         // 4: SquareTorus violet
         {
@@ -265,7 +266,7 @@ namespace Vlkrt
             m.SpecularTint  = 0.2f;
             m.Clearcoat     = 0.7f;
             m.MaterialIndex = 4;
-            scene.Materials.push_back(m);
+            MaterialRegistry::AddToScene(scene, m);
         }
         // 5: Cog yellow
         {
@@ -275,7 +276,7 @@ namespace Vlkrt
             m.Roughness     = 0.9f;
             m.Eta           = 1.51f;
             m.MaterialIndex = 5;
-            scene.Materials.push_back(m);
+            MaterialRegistry::AddToScene(scene, m);
         }
         // 6: Cylinder silver (metallic)
         {
@@ -286,7 +287,7 @@ namespace Vlkrt
             m.Roughness     = 0.0f;
             m.Eta           = 0.15f;
             m.MaterialIndex = 6;
-            scene.Materials.push_back(m);
+            MaterialRegistry::AddToScene(scene, m);
         }
         // 7: SolidAngle copper (metallic)
         {
@@ -299,7 +300,7 @@ namespace Vlkrt
             m.ClearcoatGloss = 1.0f;
             m.Eta            = 1.1f;
             m.MaterialIndex  = 7;
-            scene.Materials.push_back(m);
+            MaterialRegistry::AddToScene(scene, m);
         }
 
         // Lights
@@ -331,7 +332,7 @@ namespace Vlkrt
             const float S   = 30.0f;
             AddQuad(m, glm::vec3(-S, 0, -S), glm::vec3(S, 0, -S), glm::vec3(S, 0, S), glm::vec3(-S, 0, S),
                     glm::vec3(0, 1, 0), 0);
-            scene.StaticMeshes.push_back(m);
+            scene.StaticMeshes.push_back(std::move(m));
         }
 
         // Procedural primitives
@@ -459,7 +460,7 @@ namespace Vlkrt
             m.Albedo        = glm::vec3(0.75f);
             m.Roughness     = 0.4f;
             m.MaterialIndex = 0;
-            scene.Materials.push_back(m);
+            MaterialRegistry::AddToScene(scene, m);
         }
 
         // Materials 1..numSpheres for spheres
@@ -481,7 +482,7 @@ namespace Vlkrt
             const float emitChance = dist(rng);
             if (emitChance > 0.9f) m.Emission = glm::vec3(dist(rng), dist(rng), dist(rng));
             m.MaterialIndex = i + 1;
-            scene.Materials.push_back(m);
+            MaterialRegistry::AddToScene(scene, m);
         }
 
         // Floor mesh
@@ -493,7 +494,7 @@ namespace Vlkrt
             const float S   = 50.0f;
             AddQuad(m, glm::vec3(-S, 0, -S), glm::vec3(S, 0, -S), glm::vec3(S, 0, S), glm::vec3(-S, 0, S),
                     glm::vec3(0, 1, 0), 0);
-            scene.StaticMeshes.push_back(m);
+            scene.StaticMeshes.push_back(std::move(m));
         }
 
         // Sphere grid
@@ -520,18 +521,21 @@ namespace Vlkrt
     void SceneFactory::AddQuad(Mesh& mesh, const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2,
             const glm::vec3& p3, const glm::vec3& normal, int matIdx)
     {
-        const uint32_t base = (uint32_t) mesh.Vertices.size();
+        auto geometry       = std::make_shared<MeshGeometry>(mesh.Geometry ? *mesh.Geometry : MeshGeometry{});
+        const uint32_t base = (uint32_t) geometry->Vertices.size();
         glm::vec2 uv[4]     = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
-        mesh.Vertices.push_back({ p0, normal, uv[0] });
-        mesh.Vertices.push_back({ p1, normal, uv[1] });
-        mesh.Vertices.push_back({ p2, normal, uv[2] });
-        mesh.Vertices.push_back({ p3, normal, uv[3] });
-        mesh.Indices.push_back(base + 0);
-        mesh.Indices.push_back(base + 1);
-        mesh.Indices.push_back(base + 2);
-        mesh.Indices.push_back(base + 0);
-        mesh.Indices.push_back(base + 2);
-        mesh.Indices.push_back(base + 3);
+        geometry->Vertices.push_back({ p0, normal, uv[0] });
+        geometry->Vertices.push_back({ p1, normal, uv[1] });
+        geometry->Vertices.push_back({ p2, normal, uv[2] });
+        geometry->Vertices.push_back({ p3, normal, uv[3] });
+        geometry->Indices.push_back(base + 0);
+        geometry->Indices.push_back(base + 1);
+        geometry->Indices.push_back(base + 2);
+        geometry->Indices.push_back(base + 0);
+        geometry->Indices.push_back(base + 2);
+        geometry->Indices.push_back(base + 3);
+        for (const auto& p : { p0, p1, p2, p3 }) geometry->LocalBounds.Expand(p);
+        mesh.Geometry = std::move(geometry);
     }
 
     auto SceneFactory::MakeSphere(const std::string& name, const glm::vec3& center, float radius, int materialIndex)
@@ -0,0 +1,78 @@
+#include "SceneLoadJob.h"
+#include "ThreadPool.h"
+
+#include "Walnut/Core/Log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <unordered_set>
+
+namespace Vlkrt
+{
+    SceneLoadJob::SceneLoadJob(std::string sceneName, std::vector<std::string> residentTextures)
+        : m_SceneName(std::move(sceneName))
+    {
+        m_Result = ThreadPool::Get().Submit(
+                [this, resident = std::move(residentTextures)]() mutable { return Run(std::move(resident)); });
+    }
+
+    SceneLoadJob::~SceneLoadJob()
+    {
+        if (m_Result.valid()) m_Result.wait();
+    }
+
+    auto SceneLoadJob::IsReady() const -> bool
+    {
+        return m_Result.valid() && m_Result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    auto SceneLoadJob::TakeResult() -> Result { return m_Result.get(); }
+
+    auto SceneLoadJob::Run(std::vector<std::string> residentTextures) -> Result
+    {
+        Result result;
+        try {
+            result.Success = SceneLoader::LoadFromYAMLWithHierarchy(
+                    m_SceneName + ".yaml", result.LoadedScene, result.Root, true, &m_Progress);
+            if (!result.Success) return result;
+
+            // Same texture slots the renderer binds (occlusion is not sampled)
+            std::unordered_set<std::string> seen(residentTextures.begin(), residentTextures.end());
+            std::vector<std::string> pending;
+            std::vector<TextureUsage> pendingUsage;
+            for (const auto& mat : result.LoadedScene.Materials) {
+                for (const std::string* texture : { &mat.TextureAlbedoFilename, &mat.TextureFilename,
+                             &mat.TextureNormalFilename, &mat.TextureMetallicRoughnessFilename,
+                             &mat.TextureEmissiveFilename }) {
+                    const TextureUsage usage
+                            = texture == &mat.TextureNormalFilename ? TextureUsage::Normal : TextureUsage::Color;
+                    if (texture->empty() || !seen.insert(TextureLoader::MakeKey(*texture, usage)).second) continue;
+                    pending.push_back(*texture);
+                    pendingUsage.push_back(usage);
+                }
+            }
+
+            std::vector<uint64_t> textureBytes(pending.size());
+            for (size_t i = 0; i < pending.size(); ++i) {
+                textureBytes[i] = TextureLoader::GetFileSize(pending[i]);
+                m_Progress.BytesTotal += textureBytes[i];
+            }
+            m_Progress.TexturesTotal += static_cast<uint32_t>(pending.size());
+
+            result.Textures.resize(pending.size());
+            ThreadPool::Get().ParallelFor(pending.size(), [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    result.Textures[i] = TextureLoader::Load(pending[i], pendingUsage[i]);
+                    m_Progress.BytesParsed += textureBytes[i];
+                    ++m_Progress.TexturesDecoded;
+                }
+            });
+            std::erase_if(result.Textures, [](const DecodedTexture& texture) { return !texture.IsValid(); });
+        }
+        catch (const std::exception& e) {
+            WL_ERROR_TAG("SceneLoadJob", "Failed to load scene '{}': {}", m_SceneName, e.what());
+            result = Result{};
+        }
+        return result;
+    }
+}  // namespace Vlkrt
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Scene.h"
+#include "SceneLoader.h"
+#include "TextureLoader.h"
+
+#include "Walnut/Timer.h"
+
+#include <future>
+#include <string>
+#include <vector>
+
+namespace Vlkrt
+{
+    /// <summary>
+    /// Loads a YAML scene on the thread pool, together with CPU decodes of the textures its materials reference, while
+    /// the frame thread keeps rendering the current scene. Progress can be polled at any time; once IsReady, the frame
+    /// thread takes the result, uploads the textures and swaps the scene in.
+    /// </summary>
+    class SceneLoadJob
+    {
+    public:
+        struct Result
+        {
+            bool Success{ false };
+            Scene LoadedScene;
+            SceneEntity Root;
+            std::vector<DecodedTexture> Textures;  // Only those that were not resident when the job started
+        };
+
+    public:
+        // residentTextures lists the keys (see TextureLoader::MakeKey) of the textures the renderer already holds; they
+        // are not decoded again.
+        SceneLoadJob(std::string sceneName, std::vector<std::string> residentTextures);
+        // Waits for the load, since it writes into this object
+        ~SceneLoadJob();
+
+        SceneLoadJob(const SceneLoadJob&)            = delete;
+        SceneLoadJob& operator=(const SceneLoadJob&) = delete;
+
+        auto GetSceneName() const -> const std::string& { return m_SceneName; }
+        auto GetProgress() const -> const SceneLoadProgress& { return m_Progress; }
+        auto GetElapsedMillis() -> float { return m_Timer.ElapsedMillis(); }
+        auto IsReady() const -> bool;
+        // Blocks until the load is done; call once.
+        auto TakeResult() -> Result;
+
+    private:
+        auto Run(std::vector<std::string> residentTextures) -> Result;
+
+    private:
+        std::string m_SceneName;
+        SceneLoadProgress m_Progress;
+        Walnut::Timer m_Timer;
+        std::future<Result> m_Result;
+    };
+}  // namespace Vlkrt
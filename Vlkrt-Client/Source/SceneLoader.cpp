@@ -1,34 +1,105 @@
 #include "SceneLoader.h"
+#include "GeometryRegistry.h"
+#include "MaterialRegistry.h"
 #include "MeshLoader.h"
+#include "MeshOptimizer.h"
+#include "SceneCache.h"
+#include "ThreadPool.h"
 #include "Utils.h"
 
 #include "Walnut/Core/Log.h"
+#include "Walnut/Timer.h"
 
 #include <fstream>
 #include <yaml-cpp/yaml.h>
 #include <filesystem>
 #include <algorithm>
 #include <cctype>
+#include <functional>
 
 namespace Vlkrt
 {
+    namespace
+    {
+        static auto IsGLTFFile(const std::string& filename) -> bool
+        {
+            std::string ext = std::filesystem::path(filename).extension().string();
+            std::transform(ext.begin(), ext.end(), ext.begin(),
+                    [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return ext == ".gltf" || ext == ".glb";
+        }
+
+        // Model files are looked up as the mesh loaders do: in MODELS_DIR, then SCENES_DIR, then as given
+        static auto ResolveModelPath(const std::string& filename) -> std::filesystem::path
+        {
+            for (const auto& candidate : { std::filesystem::path(Vlkrt::MODELS_DIR) / filename,
+                         std::filesystem::path(Vlkrt::SCENES_DIR) / filename, std::filesystem::path(filename) }) {
+                std::error_code ec;
+                if (std::filesystem::is_regular_file(candidate, ec)) return candidate;
+            }
+            return {};
+        }
+
+        // Each distinct geometry referenced by the scene's meshes, once, with its position in the list
+        static auto CollectGeometries(const Scene& scene, std::unordered_map<const MeshGeometry*, size_t>& outIndices)
+                -> std::vector<std::shared_ptr<const MeshGeometry>>
+        {
+            std::vector<std::shared_ptr<const MeshGeometry>> geometries;
+            for (const auto& mesh : scene.StaticMeshes) {
+                if (mesh.Geometry && outIndices.emplace(mesh.Geometry.get(), geometries.size()).second) {
+                    geometries.push_back(mesh.Geometry);
+                }
+            }
+            return geometries;
+        }
+
+        static auto FileSizeOrZero(const std::filesystem::path& path) -> uint64_t
+        {
+            std::error_code ec;
+            const uint64_t size = path.empty() ? 0 : std::filesystem::file_size(path, ec);
+            return ec ? 0 : size;
+        }
+    }  // namespace
+
     auto SceneLoader::LoadFromYAML(const std::string& filename) -> Scene
     {
-        auto [scene, root] = LoadFromYAMLWithHierarchy(filename);
+        Scene scene;
+        SceneEntity root;
+        LoadFromYAMLWithHierarchy(filename, scene, root);
         return scene;
     }
 
-    auto SceneLoader::LoadFromYAMLWithHierarchy(const std::string& filename) -> std::pair<Scene, SceneEntity>
+    auto SceneLoader::LoadFromYAMLWithHierarchy(const std::string& filename, Scene& scene, SceneEntity& sceneRoot,
+            bool useBakedCache, SceneLoadProgress* progress) -> bool
     {
         auto filepath = Vlkrt::SCENES_DIR + filename;
 
+        if (useBakedCache && SceneCache::TryLoad(filename, scene, sceneRoot)) {
+            if (progress) {
+                const uint64_t bakedBytes = FileSizeOrZero(SceneCache::GetCachePath(filename));
+                const auto meshCount      = static_cast<uint32_t>(scene.StaticMeshes.size());
+                progress->BytesTotal += bakedBytes;
+                progress->BytesParsed += bakedBytes;
+                progress->MeshesTotal += meshCount;
+                progress->MeshesDone += meshCount;
+            }
+            return true;
+        }
+
+        const uint64_t yamlBytes = FileSizeOrZero(filepath);
+        if (progress) progress->BytesTotal += yamlBytes;
+
+        // Build directly into the caller's objects; nothing is copied or moved once parsed
+        scene     = Scene{};
+        sceneRoot = SceneEntity{};
+
         try {
             YAML::Node root = YAML::LoadFile(filepath);
+            if (progress) progress->BytesParsed += yamlBytes;
 
-            Scene scene;
-            SceneEntity sceneRoot;
-            sceneRoot.Type = EntityType::Empty;
-            sceneRoot.Name = "scene_root";
+            sceneRoot.Type   = EntityType::Empty;
+            sceneRoot.Name   = "scene_root";
+            sceneRoot.Parent = nullptr;
 
             // Parse materials
             if (root["materials"]) {
@@ -113,7 +184,8 @@ namespace Vlkrt
 
                     if (matNode["tiling"]) { mat.Tiling = matNode["tiling"].as<float>(); }
 
-                    scene.Materials.push_back(mat);
+                    // Entities refer to YAML materials by position, so identical ones are not merged here
+                    MaterialRegistry::AddToScene(scene, mat);
                 }
                 WL_INFO_TAG("SceneLoader", "Loaded {} materials", scene.Materials.size());
             }
@@ -125,13 +197,23 @@ namespace Vlkrt
             }
 
             // Parse entities and build hierarchy
+            std::unordered_map<std::string, std::vector<uint32_t>> importedMaterialIndices;
             if (root["entities"]) {
                 WL_INFO_TAG("SceneLoader", "Found entities section");
-                for (const auto& entityNode : root["entities"]) {
-                    SceneEntity entity = ParseEntity(entityNode, &sceneRoot);
-                    sceneRoot.Children.push_back(entity);
-                    FlattenEntity(entity, glm::mat4(1.0f), scene, materialMap);
+                const auto& entitiesNode = root["entities"];
+                sceneRoot.Children.reserve(entitiesNode.size());
+                for (const auto& entityNode : entitiesNode) {
+                    ParseEntity(entityNode, sceneRoot.Children.emplace_back(), &sceneRoot);
                 }
+
+                // Decode every referenced model in parallel first; flattening then runs in hierarchy order against
+                // the warm registry, so mesh and material order is the same as a serial load.
+                PreloadMeshAssets(sceneRoot, progress);
+                for (auto& entity : sceneRoot.Children) {
+                    FlattenEntity(entity, glm::mat4(1.0f), scene, materialMap, importedMaterialIndices);
+                }
+                // After flattening, so OBJ usemtl names also match materials that glTF imports added
+                for (auto& mesh : scene.StaticMeshes) ResolveMaterialSlots(scene, mesh);
             }
 
             // Parse optional scene settings
@@ -157,6 +239,11 @@ namespace Vlkrt
                 if (ss["enable_fsr"]) { scene.EnableFSR = ss["enable_fsr"].as<bool>(); }
                 if (ss["fsr_quality_mode"]) { scene.FSRQualityMode = ss["fsr_quality_mode"].as<uint32_t>(); }
                 if (ss["fsr_sharpness"]) { scene.FSRSharpness = ss["fsr_sharpness"].as<float>(); }
+                if (ss["optimize_meshes"]) { scene.OptimizeMeshes = ss["optimize_meshes"].as<bool>(); }
+                if (ss["spatial_sort_meshes"]) { scene.SpatialSortMeshes = ss["spatial_sort_meshes"].as<bool>(); }
+                if (ss["generate_lods"]) { scene.GenerateLODs = ss["generate_lods"].as<bool>(); }
+                if (ss["lod_levels"]) { scene.LODLevels = ss["lod_levels"].as<uint32_t>(); }
+                if (ss["lod_pixel_error"]) { scene.LODPixelError = ss["lod_pixel_error"].as<float>(); }
                 if (ss["scene_index"]) { scene.SceneIndex = ss["scene_index"].as<uint32_t>(); }
                 if (ss["camera_position"]) {
                     auto cp              = ss["camera_position"].as<std::vector<float>>();
@@ -170,21 +257,26 @@ namespace Vlkrt
                 }
             }
 
+            if (scene.OptimizeMeshes) OptimizeMeshes(scene);
+            if (scene.GenerateLODs) GenerateMeshLODs(scene);
+
             WL_INFO_TAG("SceneLoader", "Scene loaded - Materials: {}, Meshes: {}, Lights: {}, Procedurals: {}",
                     scene.Materials.size(), scene.StaticMeshes.size(), scene.Lights.size(),
                     scene.ProceduralEntities.size());
 
-            return { scene, sceneRoot };
+            if (useBakedCache) SceneCache::Save(filename, scene, sceneRoot);
+            return true;
         }
         catch (const std::exception& e) {
             WL_ERROR_TAG("SceneLoader", "Error loading YAML scene: {} - {}", filepath, e.what());
-            return { Scene(), SceneEntity() };
+            scene     = Scene{};
+            sceneRoot = SceneEntity{};
+            return false;
         }
     }
 
-    auto SceneLoader::ParseEntity(const YAML::Node& entityNode, SceneEntity* parent) -> SceneEntity
+    void SceneLoader::ParseEntity(const YAML::Node& entityNode, SceneEntity& entity, SceneEntity* parent)
     {
-        SceneEntity entity;
         entity.Type           = EntityType::Empty;
         entity.LocalTransform = Transform();
         entity.Parent         = parent;
@@ -259,14 +351,15 @@ namespace Vlkrt
             }
         }
 
+        // Children are constructed in place; reserving up front keeps their addresses (and the Parent pointers of
+        // their own children) stable while the subtree is parsed.
         if (entityNode["children"]) {
-            for (const auto& childNode : entityNode["children"]) {
-                SceneEntity child = ParseEntity(childNode, &entity);
-                entity.Children.push_back(child);
+            const auto& childrenNode = entityNode["children"];
+            entity.Children.reserve(childrenNode.size());
+            for (const auto& childNode : childrenNode) {
+                ParseEntity(childNode, entity.Children.emplace_back(), &entity);
             }
         }
-
-        return entity;
     }
 
     auto SceneLoader::ParseTransform(const YAML::Node& transformNode) -> Transform
@@ -291,38 +384,161 @@ namespace Vlkrt
         return transform;
     }
 
-    void SceneLoader::FlattenEntity(const SceneEntity& entity, const glm::mat4& parentWorldTransform, Scene& outScene,
-            const std::unordered_map<std::string, int>& materialMap)
+    void SceneLoader::PreloadMeshAssets(const SceneEntity& root, SceneLoadProgress* progress)
+    {
+        std::vector<std::string> files;
+        std::function<void(const SceneEntity&)> collect = [&](const SceneEntity& entity) {
+            if (entity.Type == EntityType::Mesh && !entity.MeshData.Filename.empty()
+                    && std::find(files.begin(), files.end(), entity.MeshData.Filename) == files.end()) {
+                files.push_back(entity.MeshData.Filename);
+            }
+            for (const auto& child : entity.Children) collect(child);
+        };
+        collect(root);
+        if (files.empty()) return;
+
+        std::vector<uint64_t> fileBytes(files.size(), 0);
+        if (progress) {
+            for (size_t i = 0; i < files.size(); ++i) {
+                fileBytes[i] = FileSizeOrZero(ResolveModelPath(files[i]));
+                progress->BytesTotal += fileBytes[i];
+            }
+            progress->MeshesTotal += static_cast<uint32_t>(files.size());
+        }
+
+        Walnut::Timer timer;
+        ThreadPool::Get().ParallelFor(files.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                try {
+                    if (IsGLTFFile(files[i]))
+                        GeometryRegistry::GetGLTF(files[i]);
+                    else
+                        GeometryRegistry::GetOBJ(files[i]);
+                }
+                catch (const std::exception& e) {
+                    // Reported again, per entity, when FlattenEntity retries the load
+                    WL_WARN_TAG("SceneLoader", "Error preloading mesh: {} - {}", files[i], e.what());
+                }
+                if (progress) {
+                    progress->BytesParsed += fileBytes[i];
+                    ++progress->MeshesDone;
+                }
+            }
+        });
+        WL_INFO_TAG("SceneLoader", "Preloaded {} mesh files on {} threads in {} ms", files.size(),
+                ThreadPool::Get().GetThreadCount() + 1, timer.ElapsedMillis());
+    }
+
+    void SceneLoader::OptimizeMeshes(Scene& scene)
+    {
+        std::unordered_map<const MeshGeometry*, size_t> sourceIndex;
+        const auto sources = CollectGeometries(scene, sourceIndex);
+        if (sources.empty()) return;
+
+        Walnut::Timer timer;
+        std::vector<std::shared_ptr<const MeshGeometry>> optimized(sources.size());
+        std::vector<MeshLocalityMetrics> before(sources.size()), after(sources.size());
+        ThreadPool::Get().ParallelFor(sources.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                optimized[i] = GeometryRegistry::GetOptimized(sources[i], scene.SpatialSortMeshes);
+                before[i]    = MeshOptimizer::Analyze(*sources[i]);
+                after[i]     = MeshOptimizer::Analyze(*optimized[i]);
+            }
+        });
+        for (auto& mesh : scene.StaticMeshes) {
+            if (mesh.Geometry) mesh.Geometry = optimized[sourceIndex.at(mesh.Geometry.get())];
+        }
+
+        // Triangle-weighted averages over the distinct geometries
+        double triangles = 0.0, acmrBefore = 0.0, acmrAfter = 0.0, fetchBefore = 0.0, fetchAfter = 0.0;
+        for (size_t i = 0; i < sources.size(); ++i) {
+            const double weight = static_cast<double>(sources[i]->Indices.size() / 3);
+            triangles += weight;
+            acmrBefore += before[i].ACMR * weight;
+            acmrAfter += after[i].ACMR * weight;
+            fetchBefore += before[i].FetchEfficiency * weight;
+            fetchAfter += after[i].FetchEfficiency * weight;
+        }
+        if (triangles == 0.0) return;
+        WL_INFO_TAG("SceneLoader",
+                "Optimized {} geometries in {} ms{} - ACMR {:.3f} -> {:.3f}, fetch efficiency {:.3f} -> {:.3f}",
+                sources.size(), timer.ElapsedMillis(), scene.SpatialSortMeshes ? " (spatial sort)" : "",
+                acmrBefore / triangles, acmrAfter / triangles, fetchBefore / triangles, fetchAfter / triangles);
+    }
+
+    void SceneLoader::GenerateMeshLODs(Scene& scene)
+    {
+        std::unordered_map<const MeshGeometry*, size_t> sourceIndex;
+        const auto sources = CollectGeometries(scene, sourceIndex);
+        if (sources.empty()) return;
+
+        Walnut::Timer timer;
+        std::vector<std::shared_ptr<const MeshGeometry>> withLODs(sources.size());
+        ThreadPool::Get().ParallelFor(sources.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                withLODs[i] = GeometryRegistry::GetWithLODs(sources[i], scene.LODLevels);
+            }
+        });
+        for (auto& mesh : scene.StaticMeshes) {
+            if (mesh.Geometry) mesh.Geometry = withLODs[sourceIndex.at(mesh.Geometry.get())];
+        }
+
+        size_t simplified = 0, lodCount = 0;
+        uint64_t baseTriangles = 0, coarsestTriangles = 0;
+        for (const auto& geometry : withLODs) {
+            if (geometry->LODs.empty()) continue;
+            ++simplified;
+            lodCount += geometry->LODs.size();
+            baseTriangles += geometry->Indices.size() / 3;
+            coarsestTriangles += geometry->LODs.back().Indices.size() / 3;
+        }
+        WL_INFO_TAG("SceneLoader",
+                "Generated {} LODs for {} of {} geometries in {} ms - {} -> {} triangles at coarsest", lodCount,
+                simplified, sources.size(), timer.ElapsedMillis(), baseTriangles, coarsestTriangles);
+    }
+
+    void SceneLoader::FlattenEntity(SceneEntity& entity, const glm::mat4& parentWorldTransform, Scene& outScene,
+            const std::unordered_map<std::string, int>& materialMap,
+            std::unordered_map<std::string, std::vector<uint32_t>>& importedMaterialIndices)
     {
         glm::mat4 worldTransform = entity.LocalTransform.GetWorldMatrix(parentWorldTransform);
+        const size_t firstMesh   = outScene.StaticMeshes.size();
 
         if (entity.Type == EntityType::Mesh) {
             if (!entity.MeshData.Filename.empty()) {
                 try {
-                    std::filesystem::path meshPath(entity.MeshData.Filename);
-                    std::string ext = meshPath.extension().string();
-                    std::transform(ext.begin(), ext.end(), ext.begin(),
-                            [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
-
-                    if (ext == ".gltf" || ext == ".glb") {
-                        auto gltfScene          = MeshLoader::LoadGLTF(entity.MeshData.Filename, worldTransform);
-                        uint32_t materialOffset = static_cast<uint32_t>(outScene.Materials.size());
-                        for (auto& mat : gltfScene.Materials) { outScene.Materials.push_back(std::move(mat)); }
-
-                        for (auto& mesh : gltfScene.Meshes) {
-                            mesh.Filename = entity.MeshData.Filename;
+                    if (IsGLTFFile(entity.MeshData.Filename)) {
+                        // The import is shared process-wide; its materials are added once per scene however many
+                        // entities instance the file, and share a scene slot with any identical material already in it
+                        auto gltfScene             = GeometryRegistry::GetGLTF(entity.MeshData.Filename);
+                        auto [indicesIt, firstUse] = importedMaterialIndices.try_emplace(entity.MeshData.Filename);
+                        std::vector<uint32_t>& sceneMaterialIndices = indicesIt->second;
+                        if (firstUse) {
+                            sceneMaterialIndices.reserve(gltfScene->Materials.size());
+                            for (const auto& material : gltfScene->Materials) {
+                                sceneMaterialIndices.push_back(MaterialRegistry::AddToScene(outScene, material, true));
+                            }
+                        }
+
+                        for (const auto& source : gltfScene->Meshes) {
+                            Mesh mesh      = source;
+                            mesh.Filename  = entity.MeshData.Filename;
+                            mesh.Transform = worldTransform * source.Transform;
                             if (!entity.Name.empty()) mesh.Name = entity.Name + ":" + mesh.Name;
-                            mesh.MaterialIndex += materialOffset;
+                            if (mesh.MaterialIndex < sceneMaterialIndices.size())
+                                mesh.MaterialIndex = sceneMaterialIndices[mesh.MaterialIndex];
                             outScene.StaticMeshes.push_back(std::move(mesh));
                         }
                     }
                     else {
-                        Mesh mesh          = MeshLoader::LoadOBJ(entity.MeshData.Filename);
+                        // Entities referencing the same file share one immutable copy of its geometry
+                        Mesh mesh;
+                        mesh.Geometry      = GeometryRegistry::GetOBJ(entity.MeshData.Filename);
                         mesh.Filename      = entity.MeshData.Filename;
                         mesh.Name          = entity.Name;
                         mesh.Transform     = worldTransform;
                         mesh.MaterialIndex = entity.MeshData.MaterialIndex;
-                        outScene.StaticMeshes.push_back(mesh);
+                        outScene.StaticMeshes.push_back(std::move(mesh));
                     }
                 }
                 catch (const std::exception& e) {
@@ -341,7 +557,7 @@ namespace Vlkrt
             glm::vec3 defaultDirection = glm::vec3(0.0f, 0.0f, -1.0f);
             light.Direction            = glm::normalize(glm::vec3(worldTransform * glm::vec4(defaultDirection, 0.0f)));
 
-            outScene.Lights.push_back(light);
+            outScene.Lights.push_back(std::move(light));
         }
         else if (entity.Type == EntityType::Procedural) {
             ProceduralEntity pe;
@@ -350,10 +566,14 @@ namespace Vlkrt
             pe.IsAnalytic    = entity.ProceduralData.IsAnalytic;
             pe.PrimitiveType = entity.ProceduralData.PrimitiveType;
             pe.MaterialIndex = entity.ProceduralData.MaterialIndex;
-            outScene.ProceduralEntities.push_back(pe);
+            outScene.ProceduralEntities.push_back(std::move(pe));
         }
 
-        for (const auto& child : entity.Children) { FlattenEntity(child, worldTransform, outScene, materialMap); }
+        entity.MeshData.MeshCount = static_cast<uint32_t>(outScene.StaticMeshes.size() - firstMesh);
+
+        for (auto& child : entity.Children) {
+            FlattenEntity(child, worldTransform, outScene, materialMap, importedMaterialIndices);
+        }
     }
 
     void SceneLoader::SaveToYAML(const std::string& filename, const Scene& scene)
@@ -466,12 +686,15 @@ namespace Vlkrt
     void SceneLoader::PopulateMappingRecursive(const SceneEntity& entity, const Scene& scene, HierarchyMapping& mapping,
             uint32_t& meshIndex, uint32_t& lightIndex, uint32_t& proceduralIndex)
     {
-        // Map this entity to its index in the flat arrays
+        // Map this entity to its index in the flat arrays. Mesh entities own MeshCount consecutive meshes (none if the
+        // file failed to load, several for glTF), mapped by their first index.
         if (entity.Type == EntityType::Mesh) {
-            if (meshIndex < scene.StaticMeshes.size()) {
+            if (entity.MeshData.MeshCount > 0 && meshIndex < scene.StaticMeshes.size()) {
                 mapping.EntityToMeshIdx[const_cast<SceneEntity*>(&entity)] = meshIndex;
-                mapping.MeshIndexToEntity.push_back(const_cast<SceneEntity*>(&entity));
-                meshIndex++;
+                for (uint32_t i = 0; i < entity.MeshData.MeshCount && meshIndex < scene.StaticMeshes.size(); ++i) {
+                    mapping.MeshIndexToEntity.push_back(const_cast<SceneEntity*>(&entity));
+                    meshIndex++;
+                }
             }
         }
         else if (entity.Type == EntityType::Light) {
@@ -533,6 +756,81 @@ namespace Vlkrt
         }
     }
 
+    void SceneLoader::ResolveMaterialSlots(const Scene& scene, Mesh& mesh)
+    {
+        mesh.MaterialSlots.clear();
+        if (!mesh.Geometry || mesh.Geometry->MaterialNames.empty()) return;
+
+        std::vector<uint32_t> slots;
+        slots.reserve(mesh.Geometry->MaterialNames.size());
+        for (const auto& name : mesh.Geometry->MaterialNames) {
+            if (name.empty()) {
+                slots.push_back(Mesh::kDeclaredMaterial);
+                continue;
+            }
+            auto it = std::find_if(scene.Materials.begin(), scene.Materials.end(),
+                    [&](const Material& material) { return material.Name == name; });
+            if (it == scene.Materials.end()) {
+                WL_WARN_TAG("SceneLoader", "Mesh '{}' uses material '{}', which the scene does not define; using "
+                        "material {} for the whole mesh", mesh.Name, name, mesh.MaterialIndex);
+                return;
+            }
+            slots.push_back(static_cast<uint32_t>(it - scene.Materials.begin()));
+        }
+        mesh.MaterialSlots = std::move(slots);
+    }
+
+    auto SceneLoader::UpdateHierarchyBounds(SceneEntity& entity, const Scene& scene, const HierarchyMapping& mapping)
+            -> const AABB&
+    {
+        for (auto& child : entity.Children) UpdateHierarchyBounds(child, scene, mapping);
+        RefreshEntityBounds(entity, scene, mapping);
+        return entity.Bounds;
+    }
+
+    void SceneLoader::UpdateMovedBounds(const Scene& scene, const HierarchyMapping& mapping,
+            const std::vector<uint32_t>& movedMeshes, const std::vector<uint32_t>& movedProcedurals)
+    {
+        auto refreshUpwards = [&](SceneEntity* entity) {
+            // An entity whose bounds did not change leaves its ancestors' unchanged too
+            for (; entity != nullptr; entity = entity->Parent) {
+                if (!RefreshEntityBounds(*entity, scene, mapping)) break;
+            }
+        };
+        for (uint32_t meshIndex : movedMeshes) {
+            if (meshIndex < mapping.MeshIndexToEntity.size()) refreshUpwards(mapping.MeshIndexToEntity[meshIndex]);
+        }
+        for (uint32_t procIndex : movedProcedurals) {
+            if (procIndex < mapping.ProceduralIndexToEntity.size())
+                refreshUpwards(mapping.ProceduralIndexToEntity[procIndex]);
+        }
+    }
+
+    auto SceneLoader::RefreshEntityBounds(SceneEntity& entity, const Scene& scene, const HierarchyMapping& mapping)
+            -> bool
+    {
+        AABB bounds;
+        if (entity.Type == EntityType::Mesh) {
+            auto it = mapping.EntityToMeshIdx.find(&entity);
+            if (it != mapping.EntityToMeshIdx.end()) {
+                size_t end = std::min<size_t>(it->second + entity.MeshData.MeshCount, scene.StaticMeshes.size());
+                for (size_t i = it->second; i < end; ++i) bounds.Expand(scene.StaticMeshes[i].GetWorldBounds());
+            }
+        }
+        else if (entity.Type == EntityType::Procedural) {
+            auto it = mapping.EntityToProceduralIdx.find(&entity);
+            if (it != mapping.EntityToProceduralIdx.end() && it->second < scene.ProceduralEntities.size()) {
+                bounds = scene.ProceduralEntities[it->second].GetWorldBounds();
+            }
+        }
+
+        for (const auto& child : entity.Children) bounds.Expand(child.Bounds);
+
+        const bool changed = bounds.Min != entity.Bounds.Min || bounds.Max != entity.Bounds.Max;
+        entity.Bounds      = bounds;
+        return changed;
+    }
+
     void SceneLoader::SaveToYAMLWithHierarchy(
             const std::string& filename, const Scene& scene, const SceneEntity& rootEntity)
     {
@@ -604,6 +902,11 @@ namespace Vlkrt
             file << "  enable_fsr: " << (scene.EnableFSR ? "true" : "false") << "\n";
             file << "  fsr_quality_mode: " << scene.FSRQualityMode << "\n";
             file << "  fsr_sharpness: " << scene.FSRSharpness << "\n";
+            file << "  optimize_meshes: " << (scene.OptimizeMeshes ? "true" : "false") << "\n";
+            file << "  spatial_sort_meshes: " << (scene.SpatialSortMeshes ? "true" : "false") << "\n";
+            file << "  generate_lods: " << (scene.GenerateLODs ? "true" : "false") << "\n";
+            file << "  lod_levels: " << scene.LODLevels << "\n";
+            file << "  lod_pixel_error: " << scene.LODPixelError << "\n";
             if (scene.HasCameraHint) {
                 file << "  camera_position: [ " << scene.CameraPosition.x << ", " << scene.CameraPosition.y << ", "
                      << scene.CameraPosition.z << " ]\n";
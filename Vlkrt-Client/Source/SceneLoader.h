@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Scene.h"
+#include <atomic>
 #include <string>
 #include <unordered_map>
 
@@ -23,13 +24,29 @@ namespace Vlkrt
         std::vector<SceneEntity*> ProceduralIndexToEntity;
     };
 
+    /// @brief Counters published by a running scene load so that other threads can report its progress. Totals grow as
+    /// dependencies are discovered.
+    struct SceneLoadProgress
+    {
+        std::atomic<uint64_t> BytesParsed{ 0 };  // Scene, model and texture file bytes processed so far
+        std::atomic<uint64_t> BytesTotal{ 0 };
+        std::atomic<uint32_t> MeshesDone{ 0 };  // Model files
+        std::atomic<uint32_t> MeshesTotal{ 0 };
+        std::atomic<uint32_t> TexturesDecoded{ 0 };
+        std::atomic<uint32_t> TexturesTotal{ 0 };
+    };
+
     /// @brief Class responsible for loading and saving scenes from/to YAML files, as well as maintaining the mapping
     /// between the hierarchical SceneEntity structure and the flat Scene arrays.
     class SceneLoader
     {
     public:
         static auto LoadFromYAML(const std::string& filename) -> Scene;
-        static auto LoadFromYAMLWithHierarchy(const std::string& filename) -> std::pair<Scene, SceneEntity>;
+        // Loads into the given objects in place (both are reset first); returns false and leaves them empty on error.
+        // With useBakedCache, an up-to-date bake (see SceneCache) is loaded instead, and a fresh one written otherwise.
+        // Safe to call off the frame thread; progress, if given, is updated as the load advances.
+        static auto LoadFromYAMLWithHierarchy(const std::string& filename, Scene& outScene, SceneEntity& outRoot,
+                bool useBakedCache = true, SceneLoadProgress* progress = nullptr) -> bool;
         static void SaveToYAML(const std::string& filename, const Scene& scene);
         static void SaveToYAMLWithHierarchy(
                 const std::string& filename, const Scene& scene, const SceneEntity& rootEntity);
@@ -37,14 +54,37 @@ namespace Vlkrt
         static void UpdateFlatScene(const SceneEntity& entity, const glm::mat4& parentWorldTransform, Scene& outScene,
                 const HierarchyMapping& mapping, std::vector<uint32_t>& outModifiedMeshes,
                 std::vector<uint32_t>& outModifiedLights);
+        // Recomputes SceneEntity::Bounds for the subtree from the cached world bounds of the mapped flat objects.
+        static auto UpdateHierarchyBounds(SceneEntity& entity, const Scene& scene, const HierarchyMapping& mapping)
+                -> const AABB&;
+        // Maps the mesh geometry's usemtl slots to the scene materials of the same name. If any name has no match the
+        // slots are cleared, so the whole mesh uses its declared MaterialIndex.
+        static void ResolveMaterialSlots(const Scene& scene, Mesh& mesh);
+        // Refreshes the bounds of the entities owning the given moved meshes and procedurals and then of their
+        // ancestors, stopping at the first one whose bounds are unchanged; the rest of the hierarchy is not visited.
+        static void UpdateMovedBounds(const Scene& scene, const HierarchyMapping& mapping,
+                const std::vector<uint32_t>& movedMeshes, const std::vector<uint32_t>& movedProcedurals);
 
     private:
-        static auto ParseEntity(const YAML::Node& entityNode, SceneEntity* parent = nullptr) -> SceneEntity;
+        static void ParseEntity(const YAML::Node& entityNode, SceneEntity& outEntity, SceneEntity* parent = nullptr);
         static auto ParseTransform(const YAML::Node& transformNode) -> Transform;
-        static void FlattenEntity(const SceneEntity& entity, const glm::mat4& parentWorldTransform, Scene& outScene,
-                const std::unordered_map<std::string, int>& materialMap);
+        // Loads every model file referenced under root into GeometryRegistry, in parallel.
+        static void PreloadMeshAssets(const SceneEntity& root, SceneLoadProgress* progress);
+        // Swaps every mesh's geometry for its MeshOptimizer output, per the scene's settings, and logs the metrics.
+        static void OptimizeMeshes(Scene& scene);
+        // Swaps every mesh's geometry for a copy carrying a LOD chain (MeshSimplifier), and logs the reduction.
+        static void GenerateMeshLODs(Scene& scene);
+        // importedMaterialIndices maps each glTF file already flattened into outScene to the scene index of each of its
+        // materials.
+        static void FlattenEntity(SceneEntity& entity, const glm::mat4& parentWorldTransform, Scene& outScene,
+                const std::unordered_map<std::string, int>& materialMap,
+                std::unordered_map<std::string, std::vector<uint32_t>>& importedMaterialIndices);
         static void PopulateMappingRecursive(const SceneEntity& entity, const Scene& scene, HierarchyMapping& mapping,
                 uint32_t& meshIndex, uint32_t& lightIndex, uint32_t& proceduralIndex);
+        // Sets Bounds from the entity's own flat objects and its children's current Bounds; returns whether they
+        // changed
+        static auto RefreshEntityBounds(SceneEntity& entity, const Scene& scene, const HierarchyMapping& mapping)
+                -> bool;
         static void SaveEntityToYAML(std::ofstream& file, const SceneEntity& entity, int indentLevel);
     };
 }  // namespace Vlkrt
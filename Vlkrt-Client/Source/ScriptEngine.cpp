@@ -6,6 +6,7 @@
 
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include <functional>
 #include <iostream>
 
 namespace Vlkrt
@@ -83,7 +84,8 @@ namespace Vlkrt
         sol::protected_function onUpdate = (*s_LuaState)["OnUpdate"];
         if (!onUpdate.valid()) return;
 
-        auto result = onUpdate(entity, ts);
+        // By reference, so a script's SetTransform moves the entity itself (a copy would drop the change)
+        auto result = onUpdate(std::ref(entity), ts);
         if (!result.valid()) {
             sol::error err = result;
             WL_ERROR_TAG("ScriptEngine", "Script Error in OnUpdate: {}", err.what());
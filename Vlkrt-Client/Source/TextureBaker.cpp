@@ -0,0 +1,585 @@
+#include "TextureBaker.h"
+#include "MappedFile.h"
+#include "ThreadPool.h"
+#include "Utils.h"
+
+#include "Walnut/Core/Log.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <numbers>
+#include <thread>
+#include <utility>
+
+#include <glm/glm.hpp>
+
+namespace Vlkrt
+{
+    namespace
+    {
+        constexpr uint32_t kMagic   = 0x5854'4B56;  // "VKTX"
+        constexpr uint32_t kVersion = 1;            // Bump whenever the layout or the encoders change
+
+        struct Header
+        {
+            uint32_t Magic{ kMagic };
+            uint32_t Version{ kVersion };
+            uint64_t SourceHash{ 0 };
+            uint32_t Format{ 0 };
+            uint32_t Width{ 0 };
+            uint32_t Height{ 0 };
+            uint32_t MipCount{ 0 };
+        };
+
+        constexpr float kKaiserAlpha = 4.0f;
+
+        // BC7 interpolation weights for 4-bit indices, out of 64
+        constexpr uint32_t kBC7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+        struct FloatImage
+        {
+            uint32_t Width{ 0 };
+            uint32_t Height{ 0 };
+            std::vector<glm::vec4> Pixels;  // 0..1
+        };
+
+        using Taps = std::vector<std::vector<std::pair<uint32_t, float>>>;
+
+        static auto BlockBytes(TextureFormat format) -> uint32_t
+        {
+            switch (format) {
+                case TextureFormat::BC1: return 8;
+                case TextureFormat::BC3:
+                case TextureFormat::BC5:
+                case TextureFormat::BC7: return 16;
+                default: return 0;
+            }
+        }
+
+        static auto BesselI0(float x) -> float
+        {
+            float sum = 1.0f, term = 1.0f;
+            for (int k = 1; k < 20; ++k) {
+                term *= (x * 0.5f / k) * (x * 0.5f / k);
+                sum += term;
+            }
+            return sum;
+        }
+
+        static auto Sinc(float x) -> float
+        {
+            if (std::abs(x) < 1e-6f) return 1.0f;
+            const float px = std::numbers::pi_v<float> * x;
+            return std::sin(px) / px;
+        }
+
+        // For each destination texel along one axis, the source texels it filters and their weights. Distances are in
+        // destination texels, so the kernel widens with the reduction.
+        static auto BuildTaps(uint32_t srcSize, uint32_t dstSize, MipFilter filter) -> Taps
+        {
+            const float scale  = static_cast<float>(srcSize) / dstSize;
+            const float radius = filter == MipFilter::Kaiser ? 1.5f : 0.5f;
+            Taps taps(dstSize);
+            for (uint32_t x = 0; x < dstSize; ++x) {
+                const float center = (x + 0.5f) * scale;
+                const int first    = static_cast<int>(std::floor(center - radius * scale));
+                const int last     = static_cast<int>(std::ceil(center + radius * scale));
+                float total        = 0.0f;
+                for (int s = first; s <= last; ++s) {
+                    const float t = (s + 0.5f - center) / scale;
+                    if (std::abs(t) > radius) continue;
+                    const float u      = t / radius;
+                    const float weight = filter == MipFilter::Kaiser
+                                                 ? Sinc(t) * BesselI0(kKaiserAlpha * std::sqrt(1.0f - u * u))
+                                                           / BesselI0(kKaiserAlpha)
+                                                 : 1.0f;
+                    const int wrapped  = ((s % (int) srcSize) + (int) srcSize) % (int) srcSize;
+                    taps[x].push_back({ static_cast<uint32_t>(wrapped), weight });
+                    total += weight;
+                }
+                for (auto& tap : taps[x]) tap.second /= total;
+            }
+            return taps;
+        }
+
+        static auto Downsample(const FloatImage& src, MipFilter filter, bool normalize) -> FloatImage
+        {
+            FloatImage dst;
+            dst.Width  = std::max(src.Width / 2, 1u);
+            dst.Height = std::max(src.Height / 2, 1u);
+
+            // Separable: rows first, then columns; an axis that is already 1 texel is left alone
+            FloatImage rows;
+            rows.Width  = dst.Width;
+            rows.Height = src.Height;
+            rows.Pixels.resize(static_cast<size_t>(rows.Width) * rows.Height);
+            const Taps columnTaps = BuildTaps(src.Width, dst.Width, filter);
+            ThreadPool::Get().ParallelFor(src.Height, [&](size_t begin, size_t end) {
+                for (size_t y = begin; y < end; ++y) {
+                    const glm::vec4* in = &src.Pixels[y * src.Width];
+                    glm::vec4* out      = &rows.Pixels[y * rows.Width];
+                    for (uint32_t x = 0; x < rows.Width; ++x) {
+                        if (src.Width == rows.Width) {
+                            out[x] = in[x];
+                            continue;
+                        }
+                        glm::vec4 sum(0.0f);
+                        for (const auto& [index, weight] : columnTaps[x]) sum += in[index] * weight;
+                        out[x] = sum;
+                    }
+                }
+            }, 16);
+
+            dst.Pixels.resize(static_cast<size_t>(dst.Width) * dst.Height);
+            const Taps rowTaps = BuildTaps(src.Height, dst.Height, filter);
+            ThreadPool::Get().ParallelFor(dst.Height, [&](size_t begin, size_t end) {
+                for (size_t y = begin; y < end; ++y) {
+                    for (uint32_t x = 0; x < dst.Width; ++x) {
+                        glm::vec4 sum(0.0f);
+                        if (src.Height == dst.Height) { sum = rows.Pixels[y * rows.Width + x]; }
+                        else {
+                            for (const auto& [index, weight] : rowTaps[y]) {
+                                sum += rows.Pixels[static_cast<size_t>(index) * rows.Width + x] * weight;
+                            }
+                        }
+                        sum = glm::clamp(sum, 0.0f, 1.0f);
+                        if (normalize) {
+                            const glm::vec3 n  = glm::vec3(sum) * 2.0f - 1.0f;
+                            const float length = glm::length(n);
+                            if (length > 1e-6f) sum = glm::vec4(n / length * 0.5f + 0.5f, sum.w);
+                        }
+                        dst.Pixels[y * dst.Width + x] = sum;
+                    }
+                }
+            }, 16);
+            return dst;
+        }
+
+        // Texels of a 4x4 block, repeating the last row and column where the image ends mid-block
+        static void LoadBlock(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t bx, uint32_t by,
+                uint8_t block[16][4])
+        {
+            for (uint32_t y = 0; y < 4; ++y) {
+                for (uint32_t x = 0; x < 4; ++x) {
+                    const uint32_t sx = std::min(bx * 4 + x, width - 1);
+                    const uint32_t sy = std::min(by * 4 + y, height - 1);
+                    std::memcpy(block[y * 4 + x], rgba + (static_cast<size_t>(sy) * width + sx) * 4, 4);
+                }
+            }
+        }
+
+        // Mean and dominant direction of points, by power iteration on their covariance
+        template <int N>
+        static auto PrincipalAxis(const glm::vec<N, float>* points, int count, glm::vec<N, float>& outMean)
+                -> glm::vec<N, float>
+        {
+            using Vec = glm::vec<N, float>;
+            Vec mean(0.0f), lo(points[0]), hi(points[0]);
+            for (int i = 0; i < count; ++i) {
+                mean += points[i];
+                lo = glm::min(lo, points[i]);
+                hi = glm::max(hi, points[i]);
+            }
+            mean /= static_cast<float>(count);
+            outMean = mean;
+
+            float covariance[N][N]{};
+            for (int i = 0; i < count; ++i) {
+                const Vec d = points[i] - mean;
+                for (int r = 0; r < N; ++r) {
+                    for (int c = 0; c < N; ++c) covariance[r][c] += d[r] * d[c];
+                }
+            }
+
+            Vec axis = hi - lo;
+            if (glm::dot(axis, axis) < 1e-12f) return Vec(0.0f);
+            for (int iteration = 0; iteration < 8; ++iteration) {
+                Vec next(0.0f);
+                for (int r = 0; r < N; ++r) {
+                    for (int c = 0; c < N; ++c) next[r] += covariance[r][c] * axis[c];
+                }
+                const float length = glm::length(next);
+                if (length < 1e-12f) break;
+                axis = next / length;
+            }
+            return glm::normalize(axis);
+        }
+
+        template <int N>
+        static void AxisExtents(const glm::vec<N, float>* points, int count, const glm::vec<N, float>& mean,
+                const glm::vec<N, float>& axis, glm::vec<N, float>& outLow, glm::vec<N, float>& outHigh)
+        {
+            float tMin = 0.0f, tMax = 0.0f;
+            for (int i = 0; i < count; ++i) {
+                const float t = glm::dot(points[i] - mean, axis);
+                tMin          = std::min(tMin, t);
+                tMax          = std::max(tMax, t);
+            }
+            outLow  = glm::clamp(mean + axis * tMin, 0.0f, 255.0f);
+            outHigh = glm::clamp(mean + axis * tMax, 0.0f, 255.0f);
+        }
+
+        static auto Pack565(const glm::vec3& color) -> uint16_t
+        {
+            const auto r = static_cast<uint32_t>(std::lround(color.x * 31.0f / 255.0f));
+            const auto g = static_cast<uint32_t>(std::lround(color.y * 63.0f / 255.0f));
+            const auto b = static_cast<uint32_t>(std::lround(color.z * 31.0f / 255.0f));
+            return static_cast<uint16_t>(r << 11 | g << 5 | b);
+        }
+
+        static auto Unpack565(uint16_t packed) -> glm::vec3
+        {
+            const uint32_t r = packed >> 11 & 31, g = packed >> 5 & 63, b = packed & 31;
+            return glm::vec3(r << 3 | r >> 2, g << 2 | g >> 4, b << 3 | b >> 2);
+        }
+
+        template <int N>
+        static auto Nearest(const glm::vec<N, float>& value, const glm::vec<N, float>* palette, int paletteSize)
+                -> uint32_t
+        {
+            using Vec = glm::vec<N, float>;
+
+            uint32_t best   = 0;
+            float bestError = FLT_MAX;
+            for (int i = 0; i < paletteSize; ++i) {
+                const Vec d       = value - palette[i];
+                const float error = glm::dot(d, d);
+                if (error < bestError) {
+                    bestError = error;
+                    best      = static_cast<uint32_t>(i);
+                }
+            }
+            return best;
+        }
+
+        // Opaque (four-color) BC1 block: endpoints at the extremes of the colors along their principal axis
+        static void EncodeBC1(const uint8_t block[16][4], uint8_t* out)
+        {
+            glm::vec3 colors[16];
+            for (int i = 0; i < 16; ++i) colors[i] = glm::vec3(block[i][0], block[i][1], block[i][2]);
+
+            glm::vec3 mean;
+            const glm::vec3 axis = PrincipalAxis<3>(colors, 16, mean);
+            glm::vec3 low, high;
+            AxisExtents<3>(colors, 16, mean, axis, low, high);
+
+            uint16_t c0 = Pack565(high), c1 = Pack565(low);
+            if (c0 < c1) std::swap(c0, c1);
+            uint32_t indices = 0;
+            if (c0 != c1) {
+                const glm::vec3 e0 = Unpack565(c0), e1 = Unpack565(c1);
+                const glm::vec3 palette[4] = { e0, e1, (2.0f * e0 + e1) / 3.0f, (e0 + 2.0f * e1) / 3.0f };
+                for (int i = 0; i < 16; ++i) indices |= Nearest<3>(colors[i], palette, 4) << (2 * i);
+            }
+
+            std::memcpy(out, &c0, 2);
+            std::memcpy(out + 2, &c1, 2);
+            std::memcpy(out + 4, &indices, 4);
+        }
+
+        // Eight-value BC4 block over one channel
+        static void EncodeBC4(const uint8_t values[16], uint8_t* out)
+        {
+            const uint8_t hi = *std::max_element(values, values + 16);
+            const uint8_t lo = *std::min_element(values, values + 16);
+            out[0]           = hi;
+            out[1]           = lo;
+
+            uint64_t indices = 0;
+            if (hi != lo) {
+                float palette[8] = { static_cast<float>(hi), static_cast<float>(lo) };
+                for (int i = 2; i < 8; ++i) palette[i] = ((8 - i) * hi + (i - 1) * lo) / 7.0f;
+                for (int i = 0; i < 16; ++i) {
+                    uint64_t best   = 0;
+                    float bestError = FLT_MAX;
+                    for (int p = 0; p < 8; ++p) {
+                        const float error = std::abs(values[i] - palette[p]);
+                        if (error < bestError) {
+                            bestError = error;
+                            best      = static_cast<uint64_t>(p);
+                        }
+                    }
+                    indices |= best << (3 * i);
+                }
+            }
+            for (int i = 0; i < 6; ++i) out[2 + i] = static_cast<uint8_t>(indices >> (8 * i));
+        }
+
+        static void EncodeBC3(const uint8_t block[16][4], uint8_t* out)
+        {
+            uint8_t alpha[16];
+            for (int i = 0; i < 16; ++i) alpha[i] = block[i][3];
+            EncodeBC4(alpha, out);
+            EncodeBC1(block, out + 8);
+        }
+
+        static void EncodeBC5(const uint8_t block[16][4], uint8_t* out)
+        {
+            uint8_t channel[16];
+            for (int c = 0; c < 2; ++c) {
+                for (int i = 0; i < 16; ++i) channel[i] = block[i][c];
+                EncodeBC4(channel, out + 8 * c);
+            }
+        }
+
+        // BC7 mode 6: one subset, RGBA endpoints of 7 bits plus a shared low bit (p-bit) each, 4-bit indices
+        static void EncodeBC7(const uint8_t block[16][4], uint8_t* out)
+        {
+            glm::vec4 texels[16];
+            for (int i = 0; i < 16; ++i) texels[i] = glm::vec4(block[i][0], block[i][1], block[i][2], block[i][3]);
+
+            glm::vec4 mean;
+            const glm::vec4 axis = PrincipalAxis<4>(texels, 16, mean);
+            glm::vec4 ends[2];
+            AxisExtents<4>(texels, 16, mean, axis, ends[0], ends[1]);
+
+            // Quantize each endpoint with whichever p-bit lands closer
+            uint32_t quantized[2][4], pbits[2];
+            glm::vec4 decoded[2];
+            for (int e = 0; e < 2; ++e) {
+                float bestError = FLT_MAX;
+                for (uint32_t p = 0; p < 2; ++p) {
+                    uint32_t q[4];
+                    glm::vec4 value;
+                    for (int c = 0; c < 4; ++c) {
+                        q[c] = static_cast<uint32_t>(std::clamp<long>(std::lround((ends[e][c] - p) / 2.0f), 0, 127));
+                        value[c] = static_cast<float>(q[c] << 1 | p);
+                    }
+                    const glm::vec4 d = value - ends[e];
+                    if (glm::dot(d, d) < bestError) {
+                        bestError = glm::dot(d, d);
+                        std::copy(q, q + 4, quantized[e]);
+                        pbits[e]   = p;
+                        decoded[e] = value;
+                    }
+                }
+            }
+
+            glm::vec4 palette[16];
+            for (int i = 0; i < 16; ++i) {
+                const float weight = static_cast<float>(kBC7Weights[i]);
+                palette[i]         = glm::floor(((64.0f - weight) * decoded[0] + weight * decoded[1] + 32.0f) / 64.0f);
+            }
+            uint32_t indices[16];
+            for (int i = 0; i < 16; ++i) indices[i] = Nearest<4>(texels[i], palette, 16);
+
+            // The first texel's index is stored without its top bit, which must therefore be 0
+            if (indices[0] >= 8) {
+                std::swap(quantized[0], quantized[1]);
+                std::swap(pbits[0], pbits[1]);
+                for (uint32_t& index : indices) index = 15 - index;
+            }
+
+            uint64_t bits[2]  = {};
+            uint32_t position = 0;
+            const auto write  = [&](uint32_t value, uint32_t count) {
+                for (uint32_t i = 0; i < count; ++i, ++position) {
+                    bits[position / 64] |= static_cast<uint64_t>(value >> i & 1) << (position % 64);
+                }
+            };
+            write(1u << 6, 7);  // Mode 6
+            for (int c = 0; c < 4; ++c) {
+                write(quantized[0][c], 7);
+                write(quantized[1][c], 7);
+            }
+            write(pbits[0], 1);
+            write(pbits[1], 1);
+            write(indices[0], 3);
+            for (int i = 1; i < 16; ++i) write(indices[i], 4);
+            std::memcpy(out, bits, 16);
+        }
+
+        static void EncodeLevel(const uint8_t* rgba, uint32_t width, uint32_t height, TextureFormat format,
+                uint8_t* out)
+        {
+            const uint32_t blocksX    = (width + 3) / 4;
+            const uint32_t blocksY    = (height + 3) / 4;
+            const uint32_t blockBytes = BlockBytes(format);
+            ThreadPool::Get().ParallelFor(blocksY, [&](size_t begin, size_t end) {
+                uint8_t block[16][4];
+                for (size_t by = begin; by < end; ++by) {
+                    for (uint32_t bx = 0; bx < blocksX; ++bx) {
+                        LoadBlock(rgba, width, height, bx, static_cast<uint32_t>(by), block);
+                        uint8_t* dst = out + (by * blocksX + bx) * blockBytes;
+                        switch (format) {
+                            case TextureFormat::BC1: EncodeBC1(block, dst); break;
+                            case TextureFormat::BC3: EncodeBC3(block, dst); break;
+                            case TextureFormat::BC5: EncodeBC5(block, dst); break;
+                            case TextureFormat::BC7: EncodeBC7(block, dst); break;
+                            default: break;
+                        }
+                    }
+                }
+            }, 4);
+        }
+    }  // namespace
+
+    auto TextureBaker::ChooseFormat(const DecodedTexture& rgba, TextureUsage usage, const Settings& settings)
+            -> TextureFormat
+    {
+        if (usage == TextureUsage::Normal) return TextureFormat::BC5;
+        if (settings.PreferBC7) return TextureFormat::BC7;
+
+        for (size_t i = 3; i < rgba.Pixels.size(); i += 4) {
+            if (rgba.Pixels[i] != 255) return TextureFormat::BC3;
+        }
+        return TextureFormat::BC1;
+    }
+
+    auto TextureBaker::Bake(const DecodedTexture& rgba, TextureUsage usage, const Settings& settings)
+            -> DecodedTexture
+    {
+        DecodedTexture baked;
+        baked.Filename   = rgba.Filename;
+        baked.SourcePath = rgba.SourcePath;
+        if (!rgba.IsValid() || rgba.Format != TextureFormat::RGBA8) return baked;
+
+        baked.Width  = rgba.Width;
+        baked.Height = rgba.Height;
+        baked.Format = ChooseFormat(rgba, usage, settings);
+
+        uint32_t mipCount = 1;
+        while ((std::max(rgba.Width, rgba.Height) >> mipCount) > 0) ++mipCount;
+
+        uint64_t offset = 0;
+        for (uint32_t level = 0; level < mipCount; ++level) {
+            TextureMip mip;
+            mip.Width  = std::max(rgba.Width >> level, 1u);
+            mip.Height = std::max(rgba.Height >> level, 1u);
+            mip.Offset = offset;
+            mip.Size   = static_cast<uint64_t>((mip.Width + 3) / 4) * ((mip.Height + 3) / 4)
+                       * BlockBytes(baked.Format);
+            offset += mip.Size;
+            baked.Mips.push_back(mip);
+        }
+        baked.Pixels.resize(offset);
+
+        // Level 0 is encoded from the source texels as they are; later levels are filtered in float
+        FloatImage level;
+        level.Width  = rgba.Width;
+        level.Height = rgba.Height;
+        level.Pixels.resize(static_cast<size_t>(rgba.Width) * rgba.Height);
+        for (size_t i = 0; i < level.Pixels.size(); ++i) {
+            level.Pixels[i] = glm::vec4(rgba.Pixels[4 * i], rgba.Pixels[4 * i + 1], rgba.Pixels[4 * i + 2],
+                                      rgba.Pixels[4 * i + 3])
+                              / 255.0f;
+        }
+
+        EncodeLevel(rgba.Pixels.data(), rgba.Width, rgba.Height, baked.Format, baked.Pixels.data());
+        std::vector<uint8_t> texels;
+        for (uint32_t i = 1; i < mipCount; ++i) {
+            level = Downsample(level, settings.Filter, usage == TextureUsage::Normal);
+            texels.resize(level.Pixels.size() * 4);
+            for (size_t p = 0; p < level.Pixels.size(); ++p) {
+                for (int c = 0; c < 4; ++c) {
+                    texels[4 * p + c] = static_cast<uint8_t>(std::lround(level.Pixels[p][c] * 255.0f));
+                }
+            }
+            EncodeLevel(texels.data(), level.Width, level.Height, baked.Format,
+                    baked.Pixels.data() + baked.Mips[i].Offset);
+        }
+        return baked;
+    }
+
+    auto TextureBaker::GetCachePath(const std::filesystem::path& sourcePath, TextureUsage usage)
+            -> std::filesystem::path
+    {
+        // One bake per usage, so a file bound both ways does not rebake each time the other one loads
+        std::filesystem::path path = sourcePath;
+        path += usage == TextureUsage::Normal ? ".normal.vktex" : ".vktex";
+        return path;
+    }
+
+    auto TextureBaker::HashSource(
+            const std::filesystem::path& sourcePath, TextureUsage usage, const Settings& settings) -> uint64_t
+    {
+        MappedFile file(sourcePath);
+        if (!file.IsOpen()) return 0;
+
+        uint64_t hash        = kFNVOffsetBasis;
+        const uint32_t key[] = { kVersion, static_cast<uint32_t>(usage), static_cast<uint32_t>(settings.Filter),
+            settings.PreferBC7 ? 1u : 0u };
+        hash                 = HashBytes(hash, key, sizeof(key));
+        hash                 = HashBytes(hash, file.GetData(), file.GetSize());
+        return hash != 0 ? hash : 1;
+    }
+
+    auto TextureBaker::TryLoadInto(const std::filesystem::path& sourcePath, TextureUsage usage, uint64_t sourceHash,
+            const TextureLoader::PixelAllocator& allocate) -> DecodedTexture
+    {
+        DecodedTexture texture;
+        MappedFile file(GetCachePath(sourcePath, usage));
+        if (!file.IsOpen() || file.GetSize() < sizeof(Header)) return texture;
+
+        Header header;
+        std::memcpy(&header, file.GetData(), sizeof(Header));
+        const size_t tableBytes = static_cast<size_t>(header.MipCount) * sizeof(TextureMip);
+        if (header.Magic != kMagic || header.Version != kVersion || header.SourceHash != sourceHash
+                || header.MipCount == 0 || header.MipCount > 32 || file.GetSize() < sizeof(Header) + tableBytes) {
+            return texture;
+        }
+
+        std::vector<TextureMip> mips(header.MipCount);
+        std::memcpy(mips.data(), file.GetData() + sizeof(Header), tableBytes);
+        const uint64_t dataBytes = mips.back().Offset + mips.back().Size;
+        if (file.GetSize() != sizeof(Header) + tableBytes + dataBytes) return texture;
+
+        uint8_t* dst = allocate(dataBytes);
+        if (!dst) return texture;
+        std::memcpy(dst, file.GetData() + sizeof(Header) + tableBytes, dataBytes);
+
+        texture.SourcePath = sourcePath;
+        texture.Width      = header.Width;
+        texture.Height     = header.Height;
+        texture.Format     = static_cast<TextureFormat>(header.Format);
+        texture.Mips       = std::move(mips);
+        return texture;
+    }
+
+    auto TextureBaker::Save(const std::filesystem::path& sourcePath, TextureUsage usage, uint64_t sourceHash,
+            const DecodedTexture& baked) -> bool
+    {
+        if (!baked.IsValid() || sourceHash == 0) return false;
+
+        Header header;
+        header.SourceHash = sourceHash;
+        header.Format     = static_cast<uint32_t>(baked.Format);
+        header.Width      = baked.Width;
+        header.Height     = baked.Height;
+        header.MipCount   = static_cast<uint32_t>(baked.Mips.size());
+
+        // Write to a temporary file and rename, so a reader never maps a half-written bake. The name is unique per
+        // thread, since a scene load and the texture streamer can bake the same file at once.
+        const std::filesystem::path cachePath = GetCachePath(sourcePath, usage);
+        std::filesystem::path tempPath        = cachePath;
+        tempPath += ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                WL_WARN_TAG("TextureBaker", "Failed to open '{}' for writing", tempPath.string());
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(baked.Mips.data()),
+                    (std::streamsize) (baked.Mips.size() * sizeof(TextureMip)));
+            file.write(reinterpret_cast<const char*>(baked.Pixels.data()), (std::streamsize) baked.Pixels.size());
+            if (!file) {
+                WL_WARN_TAG("TextureBaker", "Failed to write '{}'", tempPath.string());
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath, cachePath, ec);
+        if (ec) {
+            WL_WARN_TAG("TextureBaker", "Failed to replace '{}': {}", cachePath.string(), ec.message());
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+        return true;
+    }
+}  // namespace Vlkrt
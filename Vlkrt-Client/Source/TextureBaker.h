@@ -0,0 +1,51 @@
+#pragma once
+
+#include "TextureLoader.h"
+
+#include <cstdint>
+#include <filesystem>
+
+namespace Vlkrt
+{
+    enum class MipFilter : uint32_t
+    {
+        Box = 0,  // Average of the texels each mip texel covers
+        Kaiser,   // Kaiser-windowed sinc; sharper than box at the cost of slight ringing
+    };
+
+    /// <summary>
+    /// Bakes RGBA8 textures into GPU-ready mip chains in block-compressed formats, and caches the result next to the
+    /// source file (<source>.vktex, or <source>.normal.vktex for a normal map bake) so that later runs upload it
+    /// without decoding or encoding anything.
+    /// Mips wrap around at the borders, since material textures tile. Normal maps are renormalized per level and
+    /// stored as BC5 (XY only).
+    /// A bake is keyed by a hash of the source file's contents, the usage and the settings; any change makes
+    /// TryLoadInto fail and the texture is baked again.
+    /// </summary>
+    class TextureBaker
+    {
+    public:
+        struct Settings
+        {
+            MipFilter Filter{ MipFilter::Kaiser };
+            bool PreferBC7{ false };  // BC7 for all color textures instead of BC1 (opaque) and BC3 (with alpha)
+        };
+
+    public:
+        static auto ChooseFormat(const DecodedTexture& rgba, TextureUsage usage, const Settings& settings)
+                -> TextureFormat;
+        // rgba must be a single RGBA8 level, as from TextureLoader::Decode
+        static auto Bake(const DecodedTexture& rgba, TextureUsage usage, const Settings& settings) -> DecodedTexture;
+
+        static auto GetCachePath(const std::filesystem::path& sourcePath, TextureUsage usage) -> std::filesystem::path;
+        // Returns 0 if the source cannot be read
+        static auto HashSource(const std::filesystem::path& sourcePath, TextureUsage usage, const Settings& settings)
+                -> uint64_t;
+        // Reads the cached bake of sourcePath into memory from allocate. Returns an invalid texture if there is no
+        // bake with sourceHash.
+        static auto TryLoadInto(const std::filesystem::path& sourcePath, TextureUsage usage, uint64_t sourceHash,
+                const TextureLoader::PixelAllocator& allocate) -> DecodedTexture;
+        static auto Save(const std::filesystem::path& sourcePath, TextureUsage usage, uint64_t sourceHash,
+                const DecodedTexture& baked) -> bool;
+    };
+}  // namespace Vlkrt
@@ -0,0 +1,81 @@
+#include "TextureFeedback.h"
+
+#include <algorithm>
+
+namespace Vlkrt
+{
+    void TextureFeedback::Reset(size_t slotCount, uint64_t frame)
+    {
+        History history;
+        history.WindowStart   = frame;
+        history.LastSeenFrame = frame;
+        m_History.assign(slotCount, history);
+    }
+
+    void TextureFeedback::Accumulate(std::span<const uint32_t> feedback, std::span<const Slot> slots, uint64_t frame)
+    {
+        const size_t count = std::min(feedback.size(), slots.size());
+        if (m_History.size() < count) m_History.resize(count, History{ kNoFeedback, kNoFeedback, frame, frame });
+
+        for (size_t i = 0; i < count; ++i) {
+            History& history = m_History[i];
+            if (frame >= history.WindowStart + kHistoryFrames) {
+                history.PreviousWanted = history.Wanted;
+                history.Wanted         = kNoFeedback;
+                history.WindowStart    = frame;
+            }
+
+            if (feedback[i] == kNoFeedback || slots[i].MipCount == 0) continue;
+
+            const int64_t level = static_cast<int64_t>(slots[i].ResidentFirstMip)
+                                  + static_cast<int64_t>(feedback[i]) - kLevelBias;
+            const auto wanted     = static_cast<uint32_t>(std::clamp<int64_t>(level, 0, slots[i].MipCount - 1));
+            history.Wanted        = std::min(history.Wanted, wanted);
+            history.LastSeenFrame = frame;
+        }
+    }
+
+    auto TextureFeedback::Prioritize(std::span<const Slot> slots, uint64_t frame, size_t maxPageIns) const
+            -> std::vector<Request>
+    {
+        std::vector<Request> pageIns;
+        std::vector<Request> pageOuts;
+        const size_t count = std::min(slots.size(), m_History.size());
+        for (size_t i = 0; i < count; ++i) {
+            const Slot& slot = slots[i];
+            if (slot.MipCount == 0) continue;
+
+            const uint32_t wanted   = GetWantedMip(i);
+            const uint32_t resident = slot.ResidentFirstMip;
+            const uint64_t unseen   = frame - m_History[i].LastSeenFrame;
+
+            if (wanted != kNoFeedback && wanted < resident) {
+                // Missing levels matter most; among equals, the texture sampled most recently goes first
+                const float recency = 1.0f / (1.0f + static_cast<float>(unseen));
+                const float missing = static_cast<float>(resident - wanted);
+                pageIns.push_back({ static_cast<uint32_t>(i), wanted, missing + recency });
+            }
+            else if (unseen > 2 * kHistoryFrames && resident < slot.TailMip) {
+                pageOuts.push_back({ static_cast<uint32_t>(i), slot.TailMip, -static_cast<float>(unseen) });
+            }
+            else if (wanted != kNoFeedback && wanted > resident + 1) {
+                // Keep one level above what is sampled, so that a small move does not page it straight back in
+                pageOuts.push_back({ static_cast<uint32_t>(i), wanted - 1, -static_cast<float>(wanted - resident) });
+            }
+        }
+
+        auto byPriority = [](const Request& a, const Request& b) { return a.Priority > b.Priority; };
+        std::sort(pageIns.begin(), pageIns.end(), byPriority);
+        std::sort(pageOuts.begin(), pageOuts.end(), byPriority);
+        if (pageIns.size() > maxPageIns) pageIns.resize(maxPageIns);
+
+        pageIns.insert(pageIns.end(), pageOuts.begin(), pageOuts.end());
+        return pageIns;
+    }
+
+    auto TextureFeedback::GetWantedMip(size_t slot) const -> uint32_t
+    {
+        if (slot >= m_History.size()) return kNoFeedback;
+        return std::min(m_History[slot].Wanted, m_History[slot].PreviousWanted);
+    }
+}  // namespace Vlkrt
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Vlkrt
+{
+    /// <summary>
+    /// Decides which mips of the bound textures should be resident, from the mip feedback the hit shaders write: for
+    /// every entry of the texture array, the finest level sampled during a frame. Levels in the feedback are relative
+    /// to the bound texture, whose top level may be a coarser mip of the source (see TextureResidency), and are
+    /// stored with kLevelBias added so that requests for finer levels than the bound ones can be expressed.
+    /// The wanted level of a texture is the finest one seen over the last two history windows, so that it does not
+    /// flicker with the view; textures unseen for a while fall back to their mip tail. No Vulkan dependencies, so
+    /// it can be driven with synthetic feedback.
+    /// </summary>
+    class TextureFeedback
+    {
+    public:
+        static constexpr uint32_t kNoFeedback    = UINT32_MAX;  // Not sampled this frame
+        static constexpr int32_t kLevelBias      = 16;
+        static constexpr uint64_t kHistoryFrames = 30;
+
+        struct Slot
+        {
+            uint32_t ResidentFirstMip{ 0 };  // Source level the bound texture starts at
+            uint32_t MipCount{ 0 };          // Levels in the source's full chain; 0 for an empty slot
+            uint32_t TailMip{ 0 };           // Coarsest level a texture is paged out to
+        };
+
+        struct Request
+        {
+            uint32_t Slot{ 0 };
+            uint32_t FirstMip{ 0 };  // Source level to make resident as the top level
+            float Priority{ 0.0f };  // Larger first; page-outs are negative
+        };
+
+    public:
+        // Forgets all history, e.g. when the texture array is rebound to another scene. Slots count as seen at frame,
+        // so nothing is paged out before the feedback has had time to ask for it.
+        void Reset(size_t slotCount, uint64_t frame);
+        // Folds in one frame of feedback; feedback and slots are indexed like the texture array
+        void Accumulate(std::span<const uint32_t> feedback, std::span<const Slot> slots, uint64_t frame);
+        // Page-ins (finer mips wanted), by priority, followed by page-outs (mips no longer needed). At most
+        // maxPageIns page-ins are returned.
+        auto Prioritize(std::span<const Slot> slots, uint64_t frame, size_t maxPageIns) const -> std::vector<Request>;
+
+        // Finest source level wanted for a slot over the history, or kNoFeedback if it has not been sampled
+        auto GetWantedMip(size_t slot) const -> uint32_t;
+
+    private:
+        struct History
+        {
+            uint32_t Wanted{ kNoFeedback };          // Finest level this window
+            uint32_t PreviousWanted{ kNoFeedback };  // Finest level the window before
+            uint64_t WindowStart{ 0 };
+            uint64_t LastSeenFrame{ 0 };
+        };
+
+        std::vector<History> m_History;
+    };
+}  // namespace Vlkrt
@@ -0,0 +1,200 @@
+#include "TextureLoader.h"
+#include "TextureBaker.h"
+#include "Utils.h"
+
+#include "Walnut/Core/Log.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <stb_image.h>
+
+namespace Vlkrt
+{
+    namespace
+    {
+        constexpr int kTextureScale = 1;  // Full resolution textures
+
+        // Load bakes textures to block-compressed mip chains; disable to upload plain RGBA8 without mips
+        constexpr bool kBakeTextures = true;
+        constexpr TextureBaker::Settings kBakeSettings{};
+
+        // Downscales by averaging kTextureScale x kTextureScale blocks into scaledW x scaledH pixels at dst.
+        static void Downscale(const uint8_t* data, int width, int height, int scaledW, int scaledH, uint8_t* dst)
+        {
+            for (int y = 0; y < scaledH; y++) {
+                for (int x = 0; x < scaledW; x++) {
+                    uint32_t r = 0, g = 0, b = 0, a = 0, count = 0;
+                    for (int dy = 0; dy < kTextureScale; dy++) {
+                        for (int dx = 0; dx < kTextureScale; dx++) {
+                            int sx  = std::min(x * kTextureScale + dx, width - 1);
+                            int sy  = std::min(y * kTextureScale + dy, height - 1);
+                            int idx = (sy * width + sx) * 4;
+                            r += data[idx + 0];
+                            g += data[idx + 1];
+                            b += data[idx + 2];
+                            a += data[idx + 3];
+                            count++;
+                        }
+                    }
+                    size_t outIdx   = (static_cast<size_t>(y) * scaledW + x) * 4;
+                    dst[outIdx + 0] = static_cast<uint8_t>(r / count);
+                    dst[outIdx + 1] = static_cast<uint8_t>(g / count);
+                    dst[outIdx + 2] = static_cast<uint8_t>(b / count);
+                    dst[outIdx + 3] = static_cast<uint8_t>(a / count);
+                }
+            }
+        }
+    }  // namespace
+
+    auto TextureLoader::Decode(const std::string& filename) -> DecodedTexture
+    {
+        std::vector<uint8_t> pixels;
+        DecodedTexture texture = DecodeInto(filename, [&](uint64_t bytes) {
+            pixels.resize(bytes);
+            return pixels.data();
+        });
+        if (texture.IsValid()) texture.Pixels = std::move(pixels);
+        return texture;
+    }
+
+    auto TextureLoader::DecodeInto(const std::string& filename, const PixelAllocator& allocate) -> DecodedTexture
+    {
+        DecodedTexture texture;
+        texture.Filename = filename;
+
+        std::filesystem::path path = ResolvePath(filename);
+        if (path.empty()) {
+            WL_WARN_TAG("TextureLoader", "Failed to load texture '{}'.", filename);
+            return texture;
+        }
+
+        int width, height, channels;
+        unsigned char* data = stbi_load(path.string().c_str(), &width, &height, &channels, 4);
+        if (!data || width <= 0 || height <= 0) {
+            stbi_image_free(data);
+            WL_WARN_TAG("TextureLoader", "Failed to decode texture '{}': {}", path.string(),
+                    stbi_failure_reason() ? stbi_failure_reason() : "unknown error");
+            return texture;
+        }
+
+        const int scaledW = (width + kTextureScale - 1) / kTextureScale;
+        const int scaledH = (height + kTextureScale - 1) / kTextureScale;
+        const uint64_t bytes = static_cast<uint64_t>(scaledW) * static_cast<uint64_t>(scaledH) * 4;
+        if (uint8_t* dst = allocate(bytes)) {
+            if (kTextureScale > 1) { Downscale(data, width, height, scaledW, scaledH, dst); }
+            else {
+                std::memcpy(dst, data, static_cast<size_t>(width) * static_cast<size_t>(height) * 4);
+            }
+            texture.SourcePath = path;
+            texture.Width      = static_cast<uint32_t>(scaledW);
+            texture.Height     = static_cast<uint32_t>(scaledH);
+            texture.Mips       = { TextureMip{ 0, bytes, texture.Width, texture.Height } };
+        }
+        stbi_image_free(data);
+        return texture;
+    }
+
+    auto TextureLoader::Load(const std::string& filename, TextureUsage usage) -> DecodedTexture
+    {
+        std::vector<uint8_t> pixels;
+        DecodedTexture texture = LoadInto(filename, usage, [&](uint64_t bytes) {
+            pixels.resize(bytes);
+            return pixels.data();
+        });
+        if (texture.IsValid()) texture.Pixels = std::move(pixels);
+        return texture;
+    }
+
+    auto TextureLoader::LoadInto(const std::string& filename, TextureUsage usage, const PixelAllocator& allocate)
+            -> DecodedTexture
+    {
+        if (!kBakeTextures) {
+            DecodedTexture texture = DecodeInto(filename, allocate);
+            texture.Usage          = usage;
+            return texture;
+        }
+
+        // Failures still name the request, so that streaming can retire it
+        DecodedTexture failed;
+        failed.Filename = filename;
+        failed.Usage    = usage;
+
+        std::filesystem::path path = ResolvePath(filename);
+        if (path.empty()) {
+            WL_WARN_TAG("TextureLoader", "Failed to load texture '{}'.", filename);
+            return failed;
+        }
+
+        const uint64_t hash = TextureBaker::HashSource(path, usage, kBakeSettings);
+        if (hash != 0) {
+            DecodedTexture cached = TextureBaker::TryLoadInto(path, usage, hash, allocate);
+            if (cached.IsValid()) {
+                cached.Filename = filename;
+                cached.Usage    = usage;
+                return cached;
+            }
+        }
+
+        DecodedTexture rgba = Decode(path.string());
+        if (!rgba.IsValid()) return failed;
+
+        DecodedTexture baked = TextureBaker::Bake(rgba, usage, kBakeSettings);
+        if (!TextureBaker::Save(path, usage, hash, baked)) {
+            WL_WARN_TAG("TextureLoader", "Failed to write the bake cache of '{}'.", path.string());
+        }
+
+        uint8_t* dst = allocate(baked.GetByteSize());
+        if (!dst) return failed;
+        std::memcpy(dst, baked.Pixels.data(), baked.Pixels.size());
+        baked.Pixels.clear();
+        baked.Pixels.shrink_to_fit();
+        baked.Filename   = filename;
+        baked.Usage      = usage;
+        baked.SourcePath = path;
+        return baked;
+    }
+
+    auto TextureLoader::GuessUsage(const std::string& filename) -> TextureUsage
+    {
+        std::string stem = std::filesystem::path(filename).stem().string();
+        std::transform(stem.begin(), stem.end(), stem.begin(), [](unsigned char c) { return std::tolower(c); });
+
+        for (const char* marker : { "normal", "nrm", "ddn" }) {
+            if (stem.find(marker) != std::string::npos) return TextureUsage::Normal;
+        }
+        const bool normalSuffix = stem.size() > 2 && stem.compare(stem.size() - 2, 2, "_n") == 0;
+        return normalSuffix ? TextureUsage::Normal : TextureUsage::Color;
+    }
+
+    auto TextureLoader::MakeKey(const std::string& filename, TextureUsage usage) -> std::string
+    {
+        return usage == TextureUsage::Normal ? filename + "#normal" : filename;
+    }
+
+    auto DecodedTexture::GetKey() const -> std::string { return TextureLoader::MakeKey(Filename, Usage); }
+
+    auto TextureLoader::GetFileSize(const std::string& filename) -> uint64_t
+    {
+        std::filesystem::path path = ResolvePath(filename);
+        std::error_code ec;
+        uint64_t size = path.empty() ? 0 : std::filesystem::file_size(path, ec);
+        return ec ? 0 : size;
+    }
+
+    auto TextureLoader::ResolvePath(const std::string& filename) -> std::filesystem::path
+    {
+        std::filesystem::path inputPath(filename);
+        std::vector<std::filesystem::path> candidates{ inputPath };
+        if (!inputPath.is_absolute()) {
+            candidates.emplace_back(std::filesystem::path(TEXTURES_DIR) / inputPath);
+            candidates.emplace_back(std::filesystem::path(MODELS_DIR) / inputPath);
+        }
+
+        for (const auto& candidate : candidates) {
+            std::error_code ec;
+            if (std::filesystem::is_regular_file(candidate, ec)) return candidate;
+        }
+        return {};
+    }
+}  // namespace Vlkrt
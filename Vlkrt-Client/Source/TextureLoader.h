@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Vlkrt
+{
+    enum class TextureFormat : uint32_t
+    {
+        RGBA8 = 0,
+        BC1,  // RGB, 8 bytes per 4x4 block
+        BC3,  // BC1 color plus a BC4 alpha block, 16 bytes per block
+        BC5,  // Two BC4 blocks (RG), 16 bytes per block
+        BC7,  // RGBA, 16 bytes per block
+    };
+
+    // What a texture is sampled as, which decides how it is filtered and compressed
+    enum class TextureUsage : uint32_t
+    {
+        Color = 0,  // Albedo, emission, metallic-roughness
+        Normal,     // Tangent-space normals; the shader reconstructs Z, so only XY need to be stored
+    };
+
+    struct TextureMip
+    {
+        uint64_t Offset{ 0 };  // Into the texture's pixel data
+        uint64_t Size{ 0 };
+        uint32_t Width{ 0 };
+        uint32_t Height{ 0 };
+    };
+
+    /// <summary>
+    /// Pixels of a texture on the CPU, not yet uploaded to the GPU: either RGBA8 straight from the file, or a baked mip
+    /// chain in a block-compressed format (see TextureBaker).
+    /// </summary>
+    struct DecodedTexture
+    {
+        std::string Filename;  // Name the texture is requested by
+        TextureUsage Usage{ TextureUsage::Color };
+        std::filesystem::path SourcePath;
+        uint32_t Width{ 0 };
+        uint32_t Height{ 0 };
+        TextureFormat Format{ TextureFormat::RGBA8 };
+        std::vector<TextureMip> Mips;  // Level 0 first
+        std::vector<uint8_t> Pixels;   // Every level, at its Mips[i].Offset
+
+        auto IsValid() const -> bool { return Width > 0 && Height > 0 && !Mips.empty(); }
+        auto GetByteSize() const -> uint64_t { return Mips.empty() ? 0 : Mips.back().Offset + Mips.back().Size; }
+        auto GetKey() const -> std::string;
+    };
+
+    /// <summary>
+    /// Class used to decode texture files into CPU memory. Thread-safe, so decoding can run on worker threads while
+    /// the GPU upload stays on the frame thread (see Renderer::AddDecodedTextures).
+    /// </summary>
+    class TextureLoader
+    {
+    public:
+        // Returns where to write the given number of bytes of pixel data, or null to abandon the load
+        using PixelAllocator = std::function<uint8_t*(uint64_t bytes)>;
+
+        // Looks the file up as given, then in TEXTURES_DIR and MODELS_DIR. Returns an invalid texture on failure.
+        // The result is RGBA8 with a single level.
+        static auto Decode(const std::string& filename) -> DecodedTexture;
+        // Like Decode, but writes the pixels into memory from allocate (e.g. mapped staging memory) instead of
+        // Pixels, which stays empty.
+        static auto DecodeInto(const std::string& filename, const PixelAllocator& allocate) -> DecodedTexture;
+
+        // GPU-ready texture: the baked mip chain from the file's bake cache, baked and cached first if the cache is
+        // missing or stale. Falls back to Decode's RGBA8 if baking is disabled.
+        static auto Load(const std::string& filename, TextureUsage usage) -> DecodedTexture;
+        static auto LoadInto(const std::string& filename, TextureUsage usage, const PixelAllocator& allocate)
+                -> DecodedTexture;
+        // Usage from naming conventions, for textures requested without a material slot
+        static auto GuessUsage(const std::string& filename) -> TextureUsage;
+        // Cache key of a file loaded for a usage (the Renderer's and TextureStreamer's). The same file bound as both
+        // color and normal map bakes to different formats, so the two are separate textures.
+        static auto MakeKey(const std::string& filename, TextureUsage usage) -> std::string;
+
+        // Size of the file Decode would read, or 0 if it cannot be found.
+        static auto GetFileSize(const std::string& filename) -> uint64_t;
+
+    private:
+        static auto ResolvePath(const std::string& filename) -> std::filesystem::path;
+    };
+}  // namespace Vlkrt
@@ -0,0 +1,119 @@
+#include "TextureResidency.h"
+
+namespace Vlkrt
+{
+    auto TextureResidency::GetFirstMip(TextureHandle handle) const -> uint32_t
+    {
+        const SlotInfo* info = FindInfo(handle);
+        return info ? info->FirstMip : 0;
+    }
+
+    auto TextureResidency::GetMipCount(TextureHandle handle) const -> uint32_t
+    {
+        const SlotInfo* info = FindInfo(handle);
+        return info ? info->MipCount : 0;
+    }
+
+    auto TextureResidency::Insert(const std::string& key, std::shared_ptr<GPUTexture> texture, uint32_t firstMip,
+            uint32_t mipCount) -> TextureHandle
+    {
+        // A streamed load can finish after the same texture was loaded synchronously
+        if (TextureHandle cached = m_Pool.Find(key); cached.IsValid()) return cached;
+        if (!texture || texture->GetWidth() == 0) return {};
+
+        const uint64_t bytes = texture->GetSizeBytes();
+        TextureHandle handle = m_Pool.Insert(key, std::move(texture), bytes);
+        if (handle.Index >= m_SlotInfo.size()) m_SlotInfo.resize(handle.Index + 1);
+        m_SlotInfo[handle.Index] = SlotInfo{ handle, 0, firstMip, mipCount };
+        return handle;
+    }
+
+    auto TextureResidency::InsertIfRoom(const std::string& key, std::shared_ptr<GPUTexture> texture,
+            uint32_t firstMip, uint32_t mipCount) -> TextureHandle
+    {
+        if (TextureHandle cached = m_Pool.Find(key); cached.IsValid()) return cached;
+        if (!texture || !HasRoomFor(texture->GetSizeBytes())) {
+            ++m_RejectedCount;
+            return {};
+        }
+        return Insert(key, std::move(texture), firstMip, mipCount);
+    }
+
+    auto TextureResidency::Remap(TextureHandle handle, std::shared_ptr<GPUTexture> texture, uint32_t firstMip) -> bool
+    {
+        SlotInfo* info = FindInfo(handle);
+        if (!info || !texture || info->FirstMip == firstMip) return false;
+
+        // The current texture is referenced, so its bytes are already counted against the budget
+        const uint64_t currentBytes = m_Pool.Get(handle)->GetSizeBytes();
+        const uint64_t bytes        = texture->GetSizeBytes();
+        if (bytes > currentBytes && !HasRoomFor(bytes - currentBytes)) {
+            ++m_RejectedCount;
+            return false;
+        }
+
+        m_Pool.Replace(handle, std::move(texture), bytes);
+        info->FirstMip = firstMip;
+        return true;
+    }
+
+    void TextureResidency::MarkUsed(TextureHandle handle, uint64_t frame)
+    {
+        if (SlotInfo* info = FindInfo(handle)) {
+            m_Pool.Touch(handle);
+            info->LastUsedFrame = frame;
+        }
+    }
+
+    auto TextureResidency::GetLastUsedFrame(TextureHandle handle) const -> uint64_t
+    {
+        const SlotInfo* info = FindInfo(handle);
+        return info ? info->LastUsedFrame : 0;
+    }
+
+    auto TextureResidency::HasRoomFor(uint64_t bytes) const -> bool
+    {
+        return m_Pool.GetReferencedBytes() + bytes <= m_BudgetBytes;
+    }
+
+    void TextureResidency::Trim()
+    {
+        const uint64_t referencedBytes = m_Pool.GetReferencedBytes();
+        const uint64_t retainBytes     = m_BudgetBytes > referencedBytes ? m_BudgetBytes - referencedBytes : 0;
+        m_EvictedCount += m_Pool.EvictUnreferenced(retainBytes);
+    }
+
+    void TextureResidency::Clear()
+    {
+        m_Pool.Clear();
+        m_SlotInfo.clear();
+    }
+
+    auto TextureResidency::GetStats() const -> Stats
+    {
+        Stats stats;
+        stats.BudgetBytes     = m_BudgetBytes;
+        stats.ResidentBytes   = m_Pool.GetResidentBytes();
+        stats.ReferencedBytes = m_Pool.GetReferencedBytes();
+        stats.ResidentCount   = static_cast<uint32_t>(m_Pool.GetResidentCount());
+        stats.ReferencedCount = static_cast<uint32_t>(m_Pool.GetReferencedCount());
+        stats.EvictedCount    = m_EvictedCount;
+        stats.RejectedCount   = m_RejectedCount;
+        for (const SlotInfo& info : m_SlotInfo) {
+            if (info.FirstMip > 0 && m_Pool.Get(info.Handle)) ++stats.PartialCount;
+        }
+        return stats;
+    }
+
+    auto TextureResidency::FindInfo(TextureHandle handle) const -> const SlotInfo*
+    {
+        if (handle.Index >= m_SlotInfo.size() || !m_Pool.Get(handle)) return nullptr;
+        const SlotInfo& info = m_SlotInfo[handle.Index];
+        return info.Handle == handle ? &info : nullptr;
+    }
+
+    auto TextureResidency::FindInfo(TextureHandle handle) -> SlotInfo*
+    {
+        return const_cast<SlotInfo*>(static_cast<const TextureResidency*>(this)->FindInfo(handle));
+    }
+}  // namespace Vlkrt
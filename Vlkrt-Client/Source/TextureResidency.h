@@ -0,0 +1,97 @@
+#pragma once
+
+#include "GPUTexture.h"
+#include "ResourcePool.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Vlkrt
+{
+    using TextureHandle = ResourceHandle<GPUTexture>;
+
+    /// <summary>
+    /// Keeps the GPU-resident textures within a VRAM budget. Textures bound by the current scene are referenced and
+    /// never evicted; unreferenced ones are kept for reuse and evicted least recently used first once the budget is
+    /// exceeded. A texture can be resident with only part of its mip chain: the levels from FirstMip down, where
+    /// FirstMip counts levels of the source (baked) chain. Textures start partial when a scene needs them right away,
+    /// and mip feedback (see TextureFeedback) moves FirstMip up and down from there.
+    /// Frame thread only.
+    /// </summary>
+    class TextureResidency
+    {
+    public:
+        struct Stats
+        {
+            uint64_t BudgetBytes{ 0 };
+            uint64_t ResidentBytes{ 0 };
+            uint64_t ReferencedBytes{ 0 };
+            uint32_t ResidentCount{ 0 };
+            uint32_t ReferencedCount{ 0 };
+            uint32_t PartialCount{ 0 };
+            uint64_t EvictedCount{ 0 };   // Since creation
+            uint64_t RejectedCount{ 0 };  // Preloads and remaps that did not fit the budget, since creation
+        };
+
+        static constexpr uint64_t kDefaultBudgetBytes = 1024ull * 1024 * 1024;
+
+    public:
+        void SetBudget(uint64_t budgetBytes) { m_BudgetBytes = budgetBytes; }
+        auto GetBudget() const -> uint64_t { return m_BudgetBytes; }
+
+        auto Find(const std::string& key) -> TextureHandle { return m_Pool.Find(key); }
+        auto Get(TextureHandle handle) const -> std::shared_ptr<GPUTexture> { return m_Pool.Get(handle); }
+        auto IsPartial(TextureHandle handle) const -> bool { return GetFirstMip(handle) > 0; }
+        // Source level the resident texture starts at, and the levels in the source chain
+        auto GetFirstMip(TextureHandle handle) const -> uint32_t;
+        auto GetMipCount(TextureHandle handle) const -> uint32_t;
+
+        // Keeps the texture already resident under key, if any. texture holds source levels firstMip and down
+        // of a mipCount-level chain.
+        auto Insert(const std::string& key, std::shared_ptr<GPUTexture> texture, uint32_t firstMip,
+                uint32_t mipCount) -> TextureHandle;
+        // Inserts a texture nothing needs yet, unless it would not fit the budget without evicting referenced ones
+        auto InsertIfRoom(const std::string& key, std::shared_ptr<GPUTexture> texture, uint32_t firstMip,
+                uint32_t mipCount) -> TextureHandle;
+        // Replaces a texture with another range of its mips, if the budget allows when that is larger; handles stay
+        // valid
+        auto Remap(TextureHandle handle, std::shared_ptr<GPUTexture> texture, uint32_t firstMip) -> bool;
+
+        void AddRef(TextureHandle handle) { m_Pool.AddRef(handle); }
+        void Release(TextureHandle handle) { m_Pool.Release(handle); }
+        void MarkUsed(TextureHandle handle, uint64_t frame);
+        auto GetLastUsedFrame(TextureHandle handle) const -> uint64_t;
+
+        // Whether bytes more would fit, counting unreferenced textures as evictable
+        auto HasRoomFor(uint64_t bytes) const -> bool;
+        // Evicts unreferenced textures, least recently used first, until the resident ones fit the budget
+        void Trim();
+        void Clear();
+
+        auto GetResidentKeys() const -> std::vector<std::string> { return m_Pool.GetResidentKeys(); }
+        auto GetResidentBytes() const -> uint64_t { return m_Pool.GetResidentBytes(); }
+        auto GetStats() const -> Stats;
+
+    private:
+        struct SlotInfo
+        {
+            TextureHandle Handle;  // Which texture the info is for; slots outlive evicted textures
+            uint64_t LastUsedFrame{ 0 };
+            uint32_t FirstMip{ 0 };
+            uint32_t MipCount{ 0 };
+        };
+
+        // Null if the handle does not resolve
+        auto FindInfo(TextureHandle handle) const -> const SlotInfo*;
+        auto FindInfo(TextureHandle handle) -> SlotInfo*;
+
+    private:
+        ResourcePool<GPUTexture> m_Pool;
+        std::vector<SlotInfo> m_SlotInfo;  // By handle index
+        uint64_t m_BudgetBytes{ kDefaultBudgetBytes };
+        uint64_t m_EvictedCount{ 0 };
+        uint64_t m_RejectedCount{ 0 };
+    };
+}  // namespace Vlkrt
@@ -0,0 +1,357 @@
+#include "TextureStreamer.h"
+#include "ThreadPool.h"
+#include "VulkanUtils.h"
+
+#include "Walnut/Application.h"
+#include "Walnut/Core/Log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace Vlkrt
+{
+    namespace
+    {
+        // Staging sizes are rounded up so that buffers are reused across textures of similar size
+        constexpr VkDeviceSize kStagingGranularity = 1024 * 1024;
+
+        static auto MakeLayoutBarrier(VkImage image, uint32_t mipCount, VkImageLayout oldLayout,
+                VkImageLayout newLayout, VkAccessFlags srcAccess, VkAccessFlags dstAccess) -> VkImageMemoryBarrier
+        {
+            VkImageMemoryBarrier barrier            = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+            barrier.image                           = image;
+            barrier.oldLayout                       = oldLayout;
+            barrier.newLayout                       = newLayout;
+            barrier.srcAccessMask                   = srcAccess;
+            barrier.dstAccessMask                   = dstAccess;
+            barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+            barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+            barrier.subresourceRange.baseMipLevel   = 0;
+            barrier.subresourceRange.levelCount     = mipCount;
+            barrier.subresourceRange.baseArrayLayer = 0;
+            barrier.subresourceRange.layerCount     = 1;
+            return barrier;
+        }
+    }  // namespace
+
+    TextureStreamer::TextureStreamer() { m_Device = Walnut::Application::GetDevice(); }
+
+    TextureStreamer::~TextureStreamer()
+    {
+        for (auto& decode : m_Decodes) decode.wait();
+
+        std::scoped_lock lock(m_Mutex);
+        for (auto& staged : m_Ready) DestroyStaging(staged.Staging);
+        for (auto& staging : m_FreeStaging) DestroyStaging(staging);
+    }
+
+    void TextureStreamer::Request(const std::vector<std::string>& filenames)
+    {
+        for (const auto& filename : filenames) {
+            const TextureUsage usage = TextureLoader::GuessUsage(filename);
+            if (!m_Requested.insert(TextureLoader::MakeKey(filename, usage)).second) continue;
+            m_Queued.push_back({ filename, usage });
+        }
+    }
+
+    void TextureStreamer::RequestUrgent(const std::string& filename, TextureUsage usage, uint32_t firstMip)
+    {
+        Enqueue(filename, usage, firstMip, true);
+    }
+
+    void TextureStreamer::RequestMips(const std::string& filename, TextureUsage usage, uint32_t firstMip)
+    {
+        Enqueue(filename, usage, firstMip, false);
+    }
+
+    void TextureStreamer::Enqueue(const std::string& filename, TextureUsage usage, uint32_t firstMip, bool front)
+    {
+        if (!m_Requested.insert(TextureLoader::MakeKey(filename, usage)).second) {
+            // Already queued: requeue it with the new mips. Already decoding: nothing to do.
+            auto queued = std::find_if(m_Queued.begin(), m_Queued.end(), [&](const QueuedRequest& request) {
+                return request.Filename == filename && request.Usage == usage;
+            });
+            if (queued == m_Queued.end()) return;
+            m_Queued.erase(queued);
+        }
+        if (front) m_Queued.push_front({ filename, usage, firstMip });
+        else m_Queued.push_back({ filename, usage, firstMip });
+    }
+
+    auto TextureStreamer::Update(uint64_t budgetBytes) -> std::vector<Upload>
+    {
+        std::erase_if(m_Decodes, [](const std::future<void>& decode) {
+            return decode.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        });
+
+        // Keep at most two textures per worker decoded or decoding, which bounds the staging memory in use
+        std::vector<StagedTexture> batch;
+        {
+            std::scoped_lock lock(m_Mutex);
+            const size_t maxPending = 2 * std::max<size_t>(ThreadPool::Get().GetThreadCount(), 1);
+            while (!m_Queued.empty() && m_Decodes.size() + m_Ready.size() < maxPending) {
+                m_Decodes.push_back(ThreadPool::Get().Submit([this, request = std::move(m_Queued.front())] {
+                    StagedTexture staged = DecodeToStaging(request.Filename, request.Usage);
+                    staged.Key           = TextureLoader::MakeKey(request.Filename, request.Usage);
+                    if (!staged.Info.Mips.empty()) {
+                        staged.FirstMip = std::min<uint32_t>(
+                                request.FirstMip, static_cast<uint32_t>(staged.Info.Mips.size()) - 1);
+                    }
+                    std::scoped_lock readyLock(m_Mutex);
+                    m_Ready.push_back(std::move(staged));
+                }));
+                m_Queued.pop_front();
+            }
+
+            uint64_t bytes = 0;
+            size_t taken   = 0;
+            for (; taken < m_Ready.size(); ++taken) {
+                // Only the levels from FirstMip down are copied
+                const StagedTexture& staged = m_Ready[taken];
+                uint64_t size               = 0;
+                if (staged.Info.IsValid()) size = staged.Info.GetByteSize() - staged.Info.Mips[staged.FirstMip].Offset;
+                if (taken > 0 && bytes + size > budgetBytes) break;
+                bytes += size;
+            }
+            batch.assign(std::make_move_iterator(m_Ready.begin()), std::make_move_iterator(m_Ready.begin() + taken));
+            m_Ready.erase(m_Ready.begin(), m_Ready.begin() + taken);
+        }
+
+        for (const auto& staged : batch) m_Requested.erase(staged.Key);
+        std::vector<Upload> uploads = UploadStaged(batch);
+        if (m_Requested.empty()) TrimStaging(kRetainedStagingBytes);
+        return uploads;
+    }
+
+    auto TextureStreamer::LoadNow(const std::string& filename, TextureUsage usage, uint32_t maxDimension) -> Upload
+    {
+        // A decode already in flight still completes; its upload is a duplicate the caller drops
+        const auto sameRequest = [&](const QueuedRequest& request) {
+            return request.Filename == filename && request.Usage == usage;
+        };
+        if (std::erase_if(m_Queued, sameRequest) > 0) m_Requested.erase(TextureLoader::MakeKey(filename, usage));
+
+        std::vector<StagedTexture> batch;
+        batch.push_back(DecodeToStaging(filename, usage));
+        if (maxDimension > 0) {
+            const auto& mips = batch.front().Info.Mips;
+            uint32_t& first  = batch.front().FirstMip;
+            while (first + 1 < mips.size() && std::max(mips[first].Width, mips[first].Height) > maxDimension) ++first;
+        }
+
+        std::vector<Upload> uploads = UploadStaged(batch);
+        return uploads.empty() ? Upload{ filename, usage } : std::move(uploads.front());
+    }
+
+    auto TextureStreamer::UploadDecoded(std::vector<DecodedTexture>& textures) -> std::vector<Upload>
+    {
+        std::vector<StagedTexture> batch;
+        batch.reserve(textures.size());
+        for (DecodedTexture& texture : textures) {
+            if (texture.IsValid() && texture.Pixels.size() == texture.GetByteSize()) {
+                try {
+                    StagedTexture staged;
+                    staged.Staging = AcquireStaging(texture.GetByteSize());
+                    std::memcpy(staged.Staging.Mapped, texture.Pixels.data(), texture.Pixels.size());
+                    texture.Pixels = {};
+                    staged.Info    = std::move(texture);
+                    batch.push_back(std::move(staged));
+                }
+                catch (const std::exception& e) {
+                    WL_WARN_TAG("TextureStreamer", "Failed to stage texture '{}': {}", texture.Filename, e.what());
+                }
+            }
+            texture.Pixels = {};
+        }
+
+        std::vector<Upload> uploads = UploadStaged(batch);
+        if (m_Requested.empty()) TrimStaging(kRetainedStagingBytes);
+        return uploads;
+    }
+
+    auto TextureStreamer::GetPendingCount() const -> size_t { return m_Requested.size(); }
+
+    auto TextureStreamer::GetStagingBytes() const -> uint64_t
+    {
+        std::scoped_lock lock(m_Mutex);
+        return m_StagingBytes;
+    }
+
+    auto TextureStreamer::DecodeToStaging(const std::string& filename, TextureUsage usage) -> StagedTexture
+    {
+        StagedTexture staged;
+        staged.Info = TextureLoader::LoadInto(filename, usage, [&](uint64_t bytes) -> uint8_t* {
+            try {
+                staged.Staging = AcquireStaging(bytes);
+                return staged.Staging.Mapped;
+            }
+            catch (const std::exception& e) {
+                WL_WARN_TAG("TextureStreamer", "Failed to stage texture '{}': {}", filename, e.what());
+                return nullptr;
+            }
+        });
+        if (!staged.Info.IsValid() && staged.Staging.Buffer != VK_NULL_HANDLE) ReleaseStaging(staged.Staging);
+        return staged;
+    }
+
+    auto TextureStreamer::UploadStaged(std::vector<StagedTexture>& textures) -> std::vector<Upload>
+    {
+        std::vector<Upload> uploads;
+        std::vector<const StagedTexture*> sources;
+        for (const auto& staged : textures) {
+            if (!staged.Info.IsValid() || staged.Staging.Buffer == VK_NULL_HANDLE) continue;
+            try {
+                const TextureMip& top = staged.Info.Mips[staged.FirstMip];
+                auto texture          = std::make_shared<GPUTexture>(top.Width, top.Height, staged.Info.Format,
+                        static_cast<uint32_t>(staged.Info.Mips.size()) - staged.FirstMip);
+                uploads.push_back({ staged.Info.Filename, staged.Info.Usage, std::move(texture), staged.FirstMip,
+                        static_cast<uint32_t>(staged.Info.Mips.size()) });
+                sources.push_back(&staged);
+            }
+            catch (const std::exception& e) {
+                WL_WARN_TAG("TextureStreamer", "Failed to create texture '{}': {}", staged.Info.SourcePath.string(),
+                        e.what());
+            }
+        }
+
+        if (!uploads.empty()) {
+            std::vector<VkImageMemoryBarrier> barriers;
+            barriers.reserve(uploads.size());
+            for (const auto& upload : uploads) {
+                barriers.push_back(MakeLayoutBarrier(upload.Texture->GetVkImage(), upload.Texture->GetMipCount(),
+                        VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0,
+                        VK_ACCESS_TRANSFER_WRITE_BIT));
+            }
+
+            VkCommandBuffer cmd = Walnut::Application::GetCommandBuffer(true);
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr,
+                    0, nullptr, static_cast<uint32_t>(barriers.size()), barriers.data());
+
+            // One region per mip level; block-compressed levels are tightly packed like RGBA8 ones
+            std::vector<VkBufferImageCopy> regions;
+            for (size_t i = 0; i < uploads.size(); ++i) {
+                const auto& mips     = sources[i]->Info.Mips;
+                const uint32_t first = sources[i]->FirstMip;
+                regions.clear();
+                for (uint32_t level = first; level < mips.size(); ++level) {
+                    VkBufferImageCopy region           = {};
+                    region.bufferOffset                = mips[level].Offset;
+                    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                    region.imageSubresource.mipLevel   = level - first;
+                    region.imageSubresource.layerCount = 1;
+                    region.imageExtent                 = { mips[level].Width, mips[level].Height, 1 };
+                    regions.push_back(region);
+                }
+                vkCmdCopyBufferToImage(cmd, sources[i]->Staging.Buffer, uploads[i].Texture->GetVkImage(),
+                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(regions.size()), regions.data());
+            }
+
+            for (size_t i = 0; i < uploads.size(); ++i) {
+                barriers[i] = MakeLayoutBarrier(uploads[i].Texture->GetVkImage(), uploads[i].Texture->GetMipCount(),
+                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                        VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT);
+            }
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                    VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0,
+                    nullptr, 0, nullptr, static_cast<uint32_t>(barriers.size()), barriers.data());
+
+            // Waits for the copies, so the staging buffers can be reused right away
+            Walnut::Application::FlushCommandBuffer(cmd);
+
+            for (const StagedTexture* source : sources) {
+                const TextureMip& top = source->Info.Mips[source->FirstMip];
+                WL_INFO_TAG("TextureStreamer", "Loaded texture: {} ({}x{}, {} mips)", source->Info.SourcePath.string(),
+                        top.Width, top.Height, source->Info.Mips.size() - source->FirstMip);
+            }
+        }
+
+        for (auto& staged : textures) {
+            if (staged.Staging.Buffer != VK_NULL_HANDLE) ReleaseStaging(staged.Staging);
+        }
+        return uploads;
+    }
+
+    auto TextureStreamer::AcquireStaging(VkDeviceSize size) -> StagingBuffer
+    {
+        size = (size + kStagingGranularity - 1) / kStagingGranularity * kStagingGranularity;
+        {
+            // Best fit among the pooled buffers
+            std::scoped_lock lock(m_Mutex);
+            auto best = m_FreeStaging.end();
+            for (auto it = m_FreeStaging.begin(); it != m_FreeStaging.end(); ++it) {
+                if (it->Size >= size && (best == m_FreeStaging.end() || it->Size < best->Size)) best = it;
+            }
+            if (best != m_FreeStaging.end()) {
+                StagingBuffer staging = *best;
+                m_FreeStaging.erase(best);
+                return staging;
+            }
+        }
+
+        StagingBuffer staging;
+        staging.Size = size;
+
+        VkBufferCreateInfo bufferInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+        bufferInfo.size               = size;
+        bufferInfo.usage              = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        bufferInfo.sharingMode        = VK_SHARING_MODE_EXCLUSIVE;
+        if (vkCreateBuffer(m_Device, &bufferInfo, nullptr, &staging.Buffer) != VK_SUCCESS) {
+            throw std::runtime_error("vkCreateBuffer failed in TextureStreamer::AcquireStaging");
+        }
+
+        VkMemoryRequirements memRequirements;
+        vkGetBufferMemoryRequirements(m_Device, staging.Buffer, &memRequirements);
+
+        VkMemoryAllocateInfo allocInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+        allocInfo.allocationSize       = memRequirements.size;
+        allocInfo.memoryTypeIndex      = FindMemoryTypeIndex(memRequirements.memoryTypeBits,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        void* mapped                   = nullptr;
+        if (allocInfo.memoryTypeIndex == UINT32_MAX
+                || vkAllocateMemory(m_Device, &allocInfo, nullptr, &staging.Memory) != VK_SUCCESS
+                || vkBindBufferMemory(m_Device, staging.Buffer, staging.Memory, 0) != VK_SUCCESS
+                || vkMapMemory(m_Device, staging.Memory, 0, size, 0, &mapped) != VK_SUCCESS) {
+            DestroyStaging(staging);
+            throw std::runtime_error("Failed to allocate staging memory in TextureStreamer::AcquireStaging");
+        }
+        staging.Mapped = static_cast<uint8_t*>(mapped);
+
+        std::scoped_lock lock(m_Mutex);
+        m_StagingBytes += size;
+        return staging;
+    }
+
+    void TextureStreamer::ReleaseStaging(StagingBuffer& staging)
+    {
+        std::scoped_lock lock(m_Mutex);
+        m_FreeStaging.push_back(staging);
+        staging = StagingBuffer{};
+    }
+
+    void TextureStreamer::DestroyStaging(StagingBuffer& staging)
+    {
+        if (staging.Mapped) vkUnmapMemory(m_Device, staging.Memory);
+        if (staging.Buffer != VK_NULL_HANDLE) vkDestroyBuffer(m_Device, staging.Buffer, nullptr);
+        if (staging.Memory != VK_NULL_HANDLE) vkFreeMemory(m_Device, staging.Memory, nullptr);
+        staging = StagingBuffer{};
+    }
+
+    void TextureStreamer::TrimStaging(uint64_t keepBytes)
+    {
+        std::scoped_lock lock(m_Mutex);
+        uint64_t freeBytes = 0;
+        for (const auto& staging : m_FreeStaging) freeBytes += staging.Size;
+
+        std::sort(m_FreeStaging.begin(), m_FreeStaging.end(),
+                [](const StagingBuffer& lhs, const StagingBuffer& rhs) { return lhs.Size < rhs.Size; });
+        while (freeBytes > keepBytes && !m_FreeStaging.empty()) {
+            freeBytes -= m_FreeStaging.back().Size;
+            m_StagingBytes -= m_FreeStaging.back().Size;
+            DestroyStaging(m_FreeStaging.back());
+            m_FreeStaging.pop_back();
+        }
+    }
+}  // namespace Vlkrt
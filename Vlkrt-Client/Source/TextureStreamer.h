@@ -0,0 +1,120 @@
+#pragma once
+
+#include "GPUTexture.h"
+#include "TextureLoader.h"
+
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+namespace Vlkrt
+{
+    /// <summary>
+    /// Streams textures to the GPU. Requested files are decoded on the thread pool straight into pooled, persistently
+    /// mapped staging buffers, and the frame thread records the copies of everything ready into one command buffer,
+    /// up to a byte budget per frame, so that preloading a texture library never stalls a frame on decoding.
+    /// Textures are loaded with TextureLoader::LoadInto, so what is staged is the baked mip chain.
+    /// </summary>
+    class TextureStreamer
+    {
+    public:
+        struct Upload
+        {
+            std::string Filename;
+            TextureUsage Usage{ TextureUsage::Color };
+            std::shared_ptr<GPUTexture> Texture;
+            uint32_t FirstMip{ 0 };  // Source level the texture starts at; finer levels were not uploaded
+            uint32_t MipCount{ 0 };  // Levels in the source chain
+        };
+
+        static constexpr uint64_t kUploadBudgetBytes    = 32ull * 1024 * 1024;   // Per Update; one texture always goes
+        static constexpr uint64_t kRetainedStagingBytes = 128ull * 1024 * 1024;  // Kept mapped while idle
+
+    public:
+        TextureStreamer();
+        // Waits for the decodes in flight, since they write into pooled staging buffers
+        ~TextureStreamer();
+
+        TextureStreamer(const TextureStreamer&)            = delete;
+        TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+        // Queues files for decoding; ones already queued or in flight are skipped. Usage is guessed from the names.
+        void Request(const std::vector<std::string>& filenames);
+        // Queues one file ahead of the speculative requests above, e.g. finer mips of a bound texture, uploading
+        // source levels firstMip and down. A queued request for the same file and usage is moved and takes the new
+        // firstMip.
+        void RequestUrgent(const std::string& filename, TextureUsage usage, uint32_t firstMip = 0);
+        // Like RequestUrgent, but behind everything queued, e.g. to drop mips that are no longer sampled
+        void RequestMips(const std::string& filename, TextureUsage usage, uint32_t firstMip);
+        // Starts queued decodes and uploads decoded textures, at most budgetBytes of pixels. Frame thread only.
+        auto Update(uint64_t budgetBytes = kUploadBudgetBytes) -> std::vector<Upload>;
+        // Decodes and uploads one texture on the calling thread, for a texture that is needed right away. With
+        // maxDimension set, only the mips no larger than that are uploaded (a partial texture), which keeps the upload
+        // and its VRAM small until the full chain is streamed in. A queued request for the same file and usage is
+        // dropped.
+        // Frame thread only.
+        auto LoadNow(const std::string& filename, TextureUsage usage, uint32_t maxDimension = 0) -> Upload;
+        // Uploads textures already decoded into CPU memory (see SceneLoadJob) in one batch, without a budget, and
+        // releases their pixels. Frame thread only.
+        auto UploadDecoded(std::vector<DecodedTexture>& textures) -> std::vector<Upload>;
+
+        auto GetPendingCount() const -> size_t;
+        auto GetStagingBytes() const -> uint64_t;
+
+    private:
+        struct StagingBuffer
+        {
+            VkBuffer Buffer{ VK_NULL_HANDLE };
+            VkDeviceMemory Memory{ VK_NULL_HANDLE };
+            uint8_t* Mapped{ nullptr };
+            VkDeviceSize Size{ 0 };
+        };
+
+        struct QueuedRequest
+        {
+            std::string Filename;
+            TextureUsage Usage{ TextureUsage::Color };
+            uint32_t FirstMip{ 0 };
+        };
+
+        struct StagedTexture
+        {
+            std::string Key;      // Of the request, which stays pending until this is taken, decoded or not
+            DecodedTexture Info;  // Pixels are in Staging, not Info.Pixels
+            StagingBuffer Staging;
+            uint32_t FirstMip{ 0 };  // Mips before this one are not uploaded
+        };
+
+        void Enqueue(const std::string& filename, TextureUsage usage, uint32_t firstMip, bool front);
+        // Decodes filename into a staging buffer from the pool. Thread-safe.
+        auto DecodeToStaging(const std::string& filename, TextureUsage usage) -> StagedTexture;
+        // Records the copies of textures into one command buffer and waits for it, then returns their staging buffers
+        // to the pool.
+        auto UploadStaged(std::vector<StagedTexture>& textures) -> std::vector<Upload>;
+
+        auto AcquireStaging(VkDeviceSize size) -> StagingBuffer;
+        void ReleaseStaging(StagingBuffer& staging);
+        void DestroyStaging(StagingBuffer& staging);
+        // Frees pooled buffers beyond keepBytes, largest first
+        void TrimStaging(uint64_t keepBytes);
+
+    private:
+        VkDevice m_Device{ VK_NULL_HANDLE };
+
+        std::deque<QueuedRequest> m_Queued;
+        std::unordered_set<std::string> m_Requested;  // Keys (see TextureLoader::MakeKey) queued, decoding or decoded
+        std::vector<std::future<void>> m_Decodes;
+
+        mutable std::mutex m_Mutex;  // Guards m_Ready and the staging pool, which decode workers touch
+        std::vector<StagedTexture> m_Ready;
+        std::vector<StagingBuffer> m_FreeStaging;
+        uint64_t m_StagingBytes{ 0 };  // Pooled and in use
+    };
+}  // namespace Vlkrt
@@ -0,0 +1,53 @@
+#include "ThreadPool.h"
+
+namespace Vlkrt
+{
+    ThreadPool::ThreadPool(uint32_t threadCount)
+    {
+        if (threadCount == 0) threadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+        m_Workers.reserve(threadCount);
+        for (uint32_t i = 0; i < threadCount; ++i) m_Workers.emplace_back([this] { WorkerLoop(); });
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::scoped_lock lock(m_Mutex);
+            m_Stopping = true;
+        }
+        m_TaskAvailable.notify_all();
+        for (auto& worker : m_Workers) worker.join();
+    }
+
+    auto ThreadPool::Get() -> ThreadPool&
+    {
+        static ThreadPool s_Pool;
+        return s_Pool;
+    }
+
+    void ThreadPool::Enqueue(std::function<void()> task)
+    {
+        {
+            std::scoped_lock lock(m_Mutex);
+            m_Tasks.push_back(std::move(task));
+        }
+        m_TaskAvailable.notify_one();
+    }
+
+    void ThreadPool::WorkerLoop()
+    {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(m_Mutex);
+                m_TaskAvailable.wait(lock, [this] { return m_Stopping || !m_Tasks.empty(); });
+                // Drain queued work before stopping so that no future is left without a value
+                if (m_Tasks.empty()) return;
+                task = std::move(m_Tasks.front());
+                m_Tasks.pop_front();
+            }
+            task();
+        }
+    }
+}  // namespace Vlkrt
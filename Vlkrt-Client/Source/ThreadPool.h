@@ -0,0 +1,110 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Vlkrt
+{
+    /// <summary>
+    /// Fixed-size pool of worker threads for CPU-side jobs (asset decoding, mesh processing).
+    /// Get() returns the process-wide pool, sized to leave one hardware thread for the frame thread.
+    /// </summary>
+    class ThreadPool
+    {
+    public:
+        // threadCount 0 picks hardware_concurrency - 1 (at least one worker)
+        explicit ThreadPool(uint32_t threadCount = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&)            = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        static auto Get() -> ThreadPool&;
+
+        template <typename F>
+        auto Submit(F&& task) -> std::future<std::invoke_result_t<std::decay_t<F>>>
+        {
+            using Result = std::invoke_result_t<std::decay_t<F>>;
+            auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+            auto future   = packaged->get_future();
+            Enqueue([packaged] { (*packaged)(); });
+            return future;
+        }
+
+        // Runs body(begin, end) over [0, count) in chunks of grainSize on the workers and the calling thread, and
+        // returns once every chunk is done. Safe to call from a worker: the caller keeps claiming chunks itself, so it
+        // never waits on helpers that have not started. The first exception thrown by body is rethrown here.
+        template <typename F>
+        void ParallelFor(size_t count, F&& body, size_t grainSize = 1)
+        {
+            if (count == 0) return;
+            grainSize = std::max<size_t>(grainSize, 1);
+
+            const size_t chunkCount = (count + grainSize - 1) / grainSize;
+            if (chunkCount == 1 || m_Workers.empty()) {
+                body(size_t{ 0 }, count);
+                return;
+            }
+
+            struct State
+            {
+                std::atomic<size_t> NextChunk{ 0 };
+                std::atomic<size_t> DoneChunks{ 0 };
+                std::mutex Mutex;
+                std::condition_variable Finished;
+                std::exception_ptr Error;
+            };
+            auto state = std::make_shared<State>();
+
+            // Helpers that start after every chunk has been claimed return without touching body
+            auto work = [state, &body, count, grainSize, chunkCount] {
+                for (size_t chunk = state->NextChunk++; chunk < chunkCount; chunk = state->NextChunk++) {
+                    try {
+                        const size_t begin = chunk * grainSize;
+                        body(begin, std::min(begin + grainSize, count));
+                    }
+                    catch (...) {
+                        std::scoped_lock lock(state->Mutex);
+                        if (!state->Error) state->Error = std::current_exception();
+                    }
+                    if (++state->DoneChunks == chunkCount) {
+                        std::scoped_lock lock(state->Mutex);
+                        state->Finished.notify_all();
+                    }
+                }
+            };
+
+            const size_t helperCount = std::min(chunkCount - 1, m_Workers.size());
+            for (size_t i = 0; i < helperCount; ++i) Enqueue(work);
+            work();
+
+            std::unique_lock lock(state->Mutex);
+            state->Finished.wait(lock, [&] { return state->DoneChunks.load() == chunkCount; });
+            if (state->Error) std::rethrow_exception(state->Error);
+        }
+
+        auto GetThreadCount() const -> uint32_t { return static_cast<uint32_t>(m_Workers.size()); }
+
+    private:
+        void Enqueue(std::function<void()> task);
+        void WorkerLoop();
+
+    private:
+        std::vector<std::thread> m_Workers;
+        std::deque<std::function<void()>> m_Tasks;
+        std::mutex m_Mutex;
+        std::condition_variable m_TaskAvailable;
+        bool m_Stopping{ false };
+    };
+}  // namespace Vlkrt
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
 namespace Vlkrt
 {
     // TODO: Make these configurable via a settings file or environment variables
@@ -12,4 +15,16 @@ namespace Vlkrt
     static const char* SCENES_DIR   = "../resources/scenes/";
     static const char* SCRIPTS_DIR  = "../resources/scripts/";
     static const char* SHADERS_DIR  = "Source/Shaders/";
+
+    // 64-bit FNV-1a, used to key on-disk caches and detect content changes. Chain calls by passing the previous result
+    // as hash; start from kFNVOffsetBasis.
+    static constexpr uint64_t kFNVOffsetBasis = 14695981039346656037ull;
+    static constexpr uint64_t kFNVPrime       = 1099511628211ull;
+
+    inline auto HashBytes(uint64_t hash, const void* data, size_t size) -> uint64_t
+    {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) hash = (hash ^ bytes[i]) * kFNVPrime;
+        return hash;
+    }
 }  // namespace Vlkrt
\ No newline at end of file
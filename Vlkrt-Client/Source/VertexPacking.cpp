@@ -0,0 +1,419 @@
+#include "VertexPacking.h"
+#include "Renderer.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define VLKRT_VERTEX_PACKING_X64 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+// MSVC accepts AVX2 and F16C intrinsics in any function; other compilers need them enabled per function
+#define VLKRT_TARGET_AVX2
+#else
+// No FMA: with it enabled the compiler fuses multiply-adds, which round differently from PackScalar
+#define VLKRT_TARGET_AVX2 __attribute__((target("avx2,f16c")))
+#endif
+#endif
+
+namespace Vlkrt
+{
+    static_assert(sizeof(Vertex) == 32 && offsetof(Vertex, Normal) == 12 && offsetof(Vertex, TexCoord) == 24,
+            "The packing kernels load a Vertex as two 16-byte halves");
+    static_assert(offsetof(GPUVertex, normal) == 12 && offsetof(GPUVertex, texCoord) == 16,
+            "The packing kernels store a GPUVertex's position and normal as one 16-byte row");
+
+    namespace
+    {
+        // Columns of the position transform and of the normal matrix (its inverse transpose), w = 0 for the normals
+        struct PackingTransform
+        {
+            alignas(16) float Position[4][4];
+            alignas(16) float Normal[3][4];
+        };
+
+        static auto MakePackingTransform(const glm::mat4& transform) -> PackingTransform
+        {
+            const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(transform)));
+
+            PackingTransform packing{};
+            for (int c = 0; c < 4; ++c) {
+                for (int r = 0; r < 4; ++r) packing.Position[c][r] = transform[c][r];
+            }
+            for (int c = 0; c < 3; ++c) {
+                for (int r = 0; r < 3; ++r) packing.Normal[c][r] = normalMatrix[c][r];
+            }
+            return packing;
+        }
+
+        // Project onto the octahedron |x| + |y| + |z| = 1 and fold its lower half over the diagonals onto the square
+        static auto OctahedralProject(const glm::vec3& n) -> glm::vec2
+        {
+            const float l1    = std::max((std::abs(n.x) + std::abs(n.y)) + std::abs(n.z), 1e-30f);
+            const glm::vec3 p = glm::vec3(n.x / l1, n.y / l1, n.z / l1);
+            if (p.z >= 0.0f) return glm::vec2(p.x, p.y);
+            return glm::vec2((1.0f - std::abs(p.y)) * std::copysign(1.0f, p.x),
+                    (1.0f - std::abs(p.x)) * std::copysign(1.0f, p.y));
+        }
+
+        // Round to nearest even, with overflow to infinity and gradual underflow
+        static auto FloatToHalf(float value) -> uint16_t
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            const uint32_t sign      = (bits >> 16) & 0x8000u;
+            const uint32_t magnitude = bits & 0x7fffffffu;
+
+            // Infinity and NaN (quietened), then values that round past 65504
+            if (magnitude >= 0x7f800000u) {
+                return static_cast<uint16_t>(sign | 0x7c00u | (magnitude > 0x7f800000u ? 0x200u : 0u));
+            }
+            if (magnitude >= 0x477ff000u) return static_cast<uint16_t>(sign | 0x7c00u);
+            if (magnitude < 0x38800000u) {
+                // Subnormal half: count units of 2^-24
+                float subnormal;
+                std::memcpy(&subnormal, &magnitude, sizeof(subnormal));
+                return static_cast<uint16_t>(sign | static_cast<uint32_t>(std::lrint(subnormal * 16777216.0f)));
+            }
+
+            // Rebias the exponent (127 - 15) and round the mantissa to 10 bits; a carry correctly bumps the exponent
+            const uint32_t rebased = magnitude - 0x38000000u;
+            return static_cast<uint16_t>(sign | ((rebased + 0x0fffu + ((rebased >> 13) & 1u)) >> 13));
+        }
+
+        static auto HalfToFloat(uint16_t half) -> float
+        {
+            const uint32_t sign     = static_cast<uint32_t>(half & 0x8000u) << 16;
+            const uint32_t exponent = (half >> 10) & 0x1fu;
+            const uint32_t mantissa = half & 0x3ffu;
+
+            if (exponent == 0) {
+                const float subnormal = std::ldexp(static_cast<float>(mantissa), -24);
+                return sign ? -subnormal : subnormal;
+            }
+            const uint32_t bits = sign | (exponent == 31 ? 0x7f800000u : (exponent + 112) << 23) | (mantissa << 13);
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+#if VLKRT_VERTEX_PACKING_X64
+        static auto DetectAVX2() -> bool
+        {
+#if defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7) return false;
+
+            // AVX2 needs the OS to save the YMM registers as well as the CPU to have it
+            __cpuid(info, 1);
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            const bool avx     = (info[2] & (1 << 28)) != 0;
+            const bool f16c    = (info[2] & (1 << 29)) != 0;
+            if (!osxsave || !avx || !f16c || (_xgetbv(0) & 0x6) != 0x6) return false;
+
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("f16c");
+#endif
+        }
+
+        static const bool s_HasAVX2 = DetectAVX2();
+
+        // Sum of the four lanes of v, in every lane
+        static inline auto HorizontalSum(__m128 v) -> __m128
+        {
+            v = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+            return _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+        }
+
+        // OctahedralProject of n = (x y z 0), rounded to two snorm16
+        static inline auto EncodeOctahedral(__m128 n) -> uint32_t
+        {
+            const __m128 absMask  = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+            const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000u)));
+            const __m128 one      = _mm_set1_ps(1.0f);
+
+            const __m128 l1     = _mm_max_ps(HorizontalSum(_mm_and_ps(n, absMask)), _mm_set1_ps(1e-30f));
+            const __m128 p      = _mm_div_ps(n, l1);
+            const __m128 yx     = _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 2, 0, 1));
+            const __m128 folded
+                    = _mm_mul_ps(_mm_sub_ps(one, _mm_and_ps(yx, absMask)), _mm_or_ps(one, _mm_and_ps(p, signMask)));
+            const __m128 below  = _mm_cmplt_ps(p, _mm_setzero_ps());
+            const __m128 lower  = _mm_shuffle_ps(below, below, _MM_SHUFFLE(2, 2, 2, 2));
+            const __m128 square = _mm_or_ps(_mm_and_ps(lower, folded), _mm_andnot_ps(lower, p));
+
+            const __m128i snorm = _mm_cvtps_epi32(_mm_mul_ps(square, _mm_set1_ps(32767.0f)));
+            return static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_packs_epi32(snorm, snorm)));
+        }
+
+        // One vertex per iteration. A Vertex loads as a = (px py pz nx) and b = (ny nz u v).
+        template <bool Transformed>
+        static void PackSSE(const Vertex* src, size_t count, GPUVertex* dst, const PackingTransform& t)
+        {
+            const __m128 maskXYZ = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+
+            for (size_t i = 0; i < count; ++i) {
+                const float* in = &src[i].Position.x;
+                const __m128 a  = _mm_loadu_ps(in);
+                const __m128 b  = _mm_loadu_ps(in + 4);
+
+                __m128 position, normal;
+                if constexpr (Transformed) {
+                    // (c0 x + c1 y) + (c2 z + c3), as PackScalar
+                    position = _mm_add_ps(
+                            _mm_add_ps(_mm_mul_ps(_mm_load_ps(t.Position[0]), _mm_shuffle_ps(a, a, 0x00)),
+                                    _mm_mul_ps(_mm_load_ps(t.Position[1]), _mm_shuffle_ps(a, a, 0x55))),
+                            _mm_add_ps(_mm_mul_ps(_mm_load_ps(t.Position[2]), _mm_shuffle_ps(a, a, 0xAA)),
+                                    _mm_load_ps(t.Position[3])));
+                    normal = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_load_ps(t.Normal[0]), _mm_shuffle_ps(a, a, 0xFF)),
+                                                _mm_mul_ps(_mm_load_ps(t.Normal[1]), _mm_shuffle_ps(b, b, 0x00))),
+                            _mm_mul_ps(_mm_load_ps(t.Normal[2]), _mm_shuffle_ps(b, b, 0x55)));
+                }
+                else {
+                    position = a;
+                    // (nx nx ny nz) -> (nx ny nz 0)
+                    const __m128 gathered = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 3, 3));
+                    normal = _mm_and_ps(_mm_shuffle_ps(gathered, gathered, _MM_SHUFFLE(3, 3, 2, 0)), maskXYZ);
+                }
+
+                // (px py pz normal) in one store, then the UVs
+                const __m128 encoded = _mm_castsi128_ps(_mm_cvtsi32_si128(static_cast<int>(EncodeOctahedral(normal))));
+                const __m128 zw      = _mm_shuffle_ps(position, encoded, _MM_SHUFFLE(0, 0, 2, 2));
+                _mm_storeu_ps(&dst[i].position.x, _mm_shuffle_ps(position, zw, _MM_SHUFFLE(2, 0, 1, 0)));
+                dst[i].texCoord = VertexPacking::EncodeTexCoord(src[i].TexCoord);
+            }
+        }
+
+        // Two vertices per iteration, one in each 128-bit lane, then the SSE kernel for an odd tail
+        template <bool Transformed>
+        static VLKRT_TARGET_AVX2 void PackAVX2(
+                const Vertex* src, size_t count, GPUVertex* dst, const PackingTransform& t)
+        {
+            const __m256 absMask  = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+            const __m256 signMask = _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int>(0x80000000u)));
+            const __m256 maskXYZ  = _mm256_castsi256_ps(_mm256_set_epi32(0, -1, -1, -1, 0, -1, -1, -1));
+            const __m256 zero     = _mm256_setzero_ps();
+            const __m256 one      = _mm256_set1_ps(1.0f);
+            const __m256 tiny     = _mm256_set1_ps(1e-30f);
+            const __m256 snormMax = _mm256_set1_ps(32767.0f);
+
+            __m256 positionColumns[4], normalColumns[3];
+            for (int c = 0; c < 4; ++c) {
+                positionColumns[c] = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(t.Position[c]));
+            }
+            for (int c = 0; c < 3; ++c) {
+                normalColumns[c] = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(t.Normal[c]));
+            }
+
+            size_t i = 0;
+            for (; i + 2 <= count; i += 2) {
+                const float* in = &src[i].Position.x;
+                const __m256 v0 = _mm256_loadu_ps(in);      // a0 | b0
+                const __m256 v1 = _mm256_loadu_ps(in + 8);  // a1 | b1
+                const __m256 a  = _mm256_permute2f128_ps(v0, v1, 0x20);
+                const __m256 b  = _mm256_permute2f128_ps(v0, v1, 0x31);
+
+                __m256 position, normal;
+                if constexpr (Transformed) {
+                    // PackScalar's order
+                    const __m256 px = _mm256_mul_ps(positionColumns[0], _mm256_shuffle_ps(a, a, 0x00));
+                    const __m256 py = _mm256_mul_ps(positionColumns[1], _mm256_shuffle_ps(a, a, 0x55));
+                    const __m256 pz = _mm256_mul_ps(positionColumns[2], _mm256_shuffle_ps(a, a, 0xAA));
+                    position = _mm256_add_ps(_mm256_add_ps(px, py), _mm256_add_ps(pz, positionColumns[3]));
+
+                    const __m256 nx = _mm256_mul_ps(normalColumns[0], _mm256_shuffle_ps(a, a, 0xFF));
+                    const __m256 ny = _mm256_mul_ps(normalColumns[1], _mm256_shuffle_ps(b, b, 0x00));
+                    const __m256 nz = _mm256_mul_ps(normalColumns[2], _mm256_shuffle_ps(b, b, 0x55));
+                    normal          = _mm256_add_ps(_mm256_add_ps(nx, ny), nz);
+                }
+                else {
+                    position              = a;
+                    const __m256 gathered = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 3, 3));
+                    normal = _mm256_and_ps(_mm256_shuffle_ps(gathered, gathered, _MM_SHUFFLE(3, 3, 2, 0)), maskXYZ);
+                }
+
+                // EncodeOctahedral on both lanes
+                __m256 l1 = _mm256_and_ps(normal, absMask);
+                l1        = _mm256_add_ps(l1, _mm256_shuffle_ps(l1, l1, _MM_SHUFFLE(2, 3, 0, 1)));
+                l1        = _mm256_add_ps(l1, _mm256_shuffle_ps(l1, l1, _MM_SHUFFLE(1, 0, 3, 2)));
+                const __m256 p      = _mm256_div_ps(normal, _mm256_max_ps(l1, tiny));
+                const __m256 yx     = _mm256_shuffle_ps(p, p, _MM_SHUFFLE(3, 2, 0, 1));
+                const __m256 folded = _mm256_mul_ps(
+                        _mm256_sub_ps(one, _mm256_and_ps(yx, absMask)), _mm256_or_ps(one, _mm256_and_ps(p, signMask)));
+                const __m256 below  = _mm256_cmp_ps(p, zero, _CMP_LT_OQ);
+                const __m256 square = _mm256_blendv_ps(p, folded, _mm256_shuffle_ps(below, below, 0xAA));
+                __m256i snorm       = _mm256_cvtps_epi32(_mm256_mul_ps(square, snormMax));
+                snorm               = _mm256_packs_epi32(snorm, snorm);
+
+                // (px py pz normal) per lane, and both vertices' UVs as halves 0-1 and 4-5
+                const __m256 encoded    = _mm256_castsi256_ps(_mm256_shuffle_epi32(snorm, 0x00));
+                const __m256 rows       = _mm256_blend_ps(position, encoded, 0x88);
+                const __m256 uvs        = _mm256_shuffle_ps(b, zero, _MM_SHUFFLE(0, 0, 3, 2));
+                const __m128i texCoords = _mm256_cvtps_ph(uvs, _MM_FROUND_TO_NEAREST_INT);
+
+                _mm_storeu_ps(&dst[i].position.x, _mm256_castps256_ps128(rows));
+                _mm_storeu_ps(&dst[i + 1].position.x, _mm256_extractf128_ps(rows, 1));
+                dst[i].texCoord     = static_cast<uint32_t>(_mm_cvtsi128_si32(texCoords));
+                dst[i + 1].texCoord = static_cast<uint32_t>(_mm_extract_epi32(texCoords, 2));
+            }
+            _mm256_zeroupper();
+
+            if (i < count) PackSSE<Transformed>(src + i, count - i, dst + i, t);
+        }
+
+        template <bool Transformed>
+        static void PackRange(const Vertex* src, size_t count, GPUVertex* dst, const PackingTransform& t)
+        {
+            if (s_HasAVX2)
+                PackAVX2<Transformed>(src, count, dst, t);
+            else
+                PackSSE<Transformed>(src, count, dst, t);
+        }
+
+        static void PackSSE(const Vertex* src, size_t count, GPUVertex* dst, const glm::mat4* transform)
+        {
+            if (transform)
+                PackSSE<true>(src, count, dst, MakePackingTransform(*transform));
+            else
+                PackSSE<false>(src, count, dst, PackingTransform{});
+        }
+
+        static void PackAVX2(const Vertex* src, size_t count, GPUVertex* dst, const glm::mat4* transform)
+        {
+            if (transform)
+                PackAVX2<true>(src, count, dst, MakePackingTransform(*transform));
+            else
+                PackAVX2<false>(src, count, dst, PackingTransform{});
+        }
+#endif
+    }  // namespace
+
+    void VertexPacking::Pack(const Vertex* src, size_t count, GPUVertex* dst, const glm::mat4* transform)
+    {
+        if (count == 0) return;
+#if !VLKRT_VERTEX_PACKING_X64
+        PackScalar(src, count, dst, transform);
+#else
+        if (transform) {
+            PackRange<true>(src, count, dst, MakePackingTransform(*transform));
+        }
+        else {
+            PackRange<false>(src, count, dst, PackingTransform{});
+        }
+#endif
+    }
+
+    void VertexPacking::PackParallel(const Vertex* src, size_t count, GPUVertex* dst, const glm::mat4* transform)
+    {
+        if (count < kParallelThreshold) {
+            Pack(src, count, dst, transform);
+            return;
+        }
+
+#if !VLKRT_VERTEX_PACKING_X64
+        ThreadPool::Get().ParallelFor(
+                count, [&](size_t begin, size_t end) { PackScalar(src + begin, end - begin, dst + begin, transform); },
+                kParallelGrainSize);
+#else
+        // The normal matrix is inverted once, not per chunk
+        const bool transformed         = transform != nullptr;
+        const PackingTransform packing = transformed ? MakePackingTransform(*transform) : PackingTransform{};
+        ThreadPool::Get().ParallelFor(
+                count,
+                [&](size_t begin, size_t end) {
+                    if (transformed)
+                        PackRange<true>(src + begin, end - begin, dst + begin, packing);
+                    else
+                        PackRange<false>(src + begin, end - begin, dst + begin, packing);
+                },
+                kParallelGrainSize);
+#endif
+    }
+
+    void VertexPacking::PackScalar(const Vertex* src, size_t count, GPUVertex* dst, const glm::mat4* transform)
+    {
+        const PackingTransform t = transform ? MakePackingTransform(*transform) : PackingTransform{};
+        for (size_t i = 0; i < count; ++i) {
+            const glm::vec3& p = src[i].Position;
+            const glm::vec3& n = src[i].Normal;
+
+            GPUVertex gpuVert{};
+            gpuVert.position = p;
+            glm::vec3 normal = n;
+            if (transform) {
+                for (int r = 0; r < 3; ++r) {
+                    gpuVert.position[r] = (t.Position[0][r] * p.x + t.Position[1][r] * p.y)
+                                          + (t.Position[2][r] * p.z + t.Position[3][r]);
+                    normal[r] = (t.Normal[0][r] * n.x + t.Normal[1][r] * n.y) + t.Normal[2][r] * n.z;
+                }
+            }
+            gpuVert.normal   = EncodeNormal(normal);
+            gpuVert.texCoord = EncodeTexCoord(src[i].TexCoord);
+            dst[i]           = gpuVert;
+        }
+    }
+
+    auto VertexPacking::PackWith(
+            Kernel kernel, const Vertex* src, size_t count, GPUVertex* dst, const glm::mat4* transform) -> bool
+    {
+        if (!IsSupported(kernel)) return false;
+        switch (kernel) {
+            case Kernel::Scalar: PackScalar(src, count, dst, transform); break;
+#if VLKRT_VERTEX_PACKING_X64
+            case Kernel::SSE2: PackSSE(src, count, dst, transform); break;
+            case Kernel::AVX2: PackAVX2(src, count, dst, transform); break;
+#endif
+            default: return false;
+        }
+        return true;
+    }
+
+    auto VertexPacking::IsSupported(Kernel kernel) -> bool
+    {
+#if VLKRT_VERTEX_PACKING_X64
+        return kernel != Kernel::AVX2 || s_HasAVX2;
+#else
+        return kernel == Kernel::Scalar;
+#endif
+    }
+
+    auto VertexPacking::EncodeNormal(const glm::vec3& normal) -> uint32_t
+    {
+        const glm::vec2 square = OctahedralProject(normal);
+        const auto x           = static_cast<int16_t>(std::lrint(square.x * 32767.0f));
+        const auto y           = static_cast<int16_t>(std::lrint(square.y * 32767.0f));
+        return static_cast<uint32_t>(static_cast<uint16_t>(x))
+               | (static_cast<uint32_t>(static_cast<uint16_t>(y)) << 16);
+    }
+
+    auto VertexPacking::DecodeNormal(uint32_t encoded) -> glm::vec3
+    {
+        const float x = std::max(static_cast<int16_t>(encoded & 0xffffu) / 32767.0f, -1.0f);
+        const float y = std::max(static_cast<int16_t>(encoded >> 16) / 32767.0f, -1.0f);
+
+        // Unfold the lower half: the inverse of the fold is the fold itself
+        glm::vec3 normal(x, y, 1.0f - std::abs(x) - std::abs(y));
+        if (normal.z < 0.0f) {
+            normal.x = (1.0f - std::abs(y)) * std::copysign(1.0f, x);
+            normal.y = (1.0f - std::abs(x)) * std::copysign(1.0f, y);
+        }
+        return glm::normalize(normal);
+    }
+
+    auto VertexPacking::EncodeTexCoord(const glm::vec2& texCoord) -> uint32_t
+    {
+        return static_cast<uint32_t>(FloatToHalf(texCoord.x)) | (static_cast<uint32_t>(FloatToHalf(texCoord.y)) << 16);
+    }
+
+    auto VertexPacking::DecodeTexCoord(uint32_t encoded) -> glm::vec2
+    {
+        return glm::vec2(HalfToFloat(static_cast<uint16_t>(encoded & 0xffffu)),
+                HalfToFloat(static_cast<uint16_t>(encoded >> 16)));
+    }
+}  // namespace Vlkrt
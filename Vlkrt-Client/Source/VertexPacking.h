@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Scene.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+namespace Vlkrt
+{
+    struct GPUVertex;
+
+    /// <summary>
+    /// Batch conversion of mesh vertices to the compact GPUVertex layout, written straight into the destination
+    /// (typically mapped staging memory) so nothing is read back from it. Positions stay full precision, normals are
+    /// octahedral-encoded to two snorm16 and UVs are converted to half floats. Uses SSE2, and AVX2 + F16C two
+    /// vertices at a time when the CPU has them. An optional transform moves positions and normals to its space,
+    /// normals by its inverse transpose.
+    /// </summary>
+    class VertexPacking
+    {
+    public:
+        enum class Kernel
+        {
+            Scalar,
+            SSE2,
+            AVX2,  // Also needs F16C
+        };
+
+        // Below this many vertices handing chunks to the thread pool costs more than it saves
+        static constexpr size_t kParallelThreshold = 64 * 1024;
+        static constexpr size_t kParallelGrainSize = 16 * 1024;
+
+        static void Pack(const Vertex* src, size_t count, GPUVertex* dst, const glm::mat4* transform = nullptr);
+        // As Pack, split across ThreadPool::Get() for counts of kParallelThreshold and up
+        static void PackParallel(
+                const Vertex* src, size_t count, GPUVertex* dst, const glm::mat4* transform = nullptr);
+        // One vertex at a time through the encoders below, the reference for the SIMD kernels. Every kernel evaluates
+        // the transform in the same order without fused multiply-adds, so all of them produce identical bits.
+        static void PackScalar(const Vertex* src, size_t count, GPUVertex* dst, const glm::mat4* transform = nullptr);
+        // As Pack with the given kernel instead of the fastest one, for testing. False if this CPU cannot run it.
+        static auto PackWith(Kernel kernel, const Vertex* src, size_t count, GPUVertex* dst,
+                const glm::mat4* transform = nullptr) -> bool;
+        static auto IsSupported(Kernel kernel) -> bool;
+
+        // Encodings of GPUVertex::normal and GPUVertex::texCoord, decoded as in the hit shader. Zero normals encode
+        // as +Z; UVs round to nearest even.
+        static auto EncodeNormal(const glm::vec3& normal) -> uint32_t;
+        static auto DecodeNormal(uint32_t encoded) -> glm::vec3;
+        static auto EncodeTexCoord(const glm::vec2& texCoord) -> uint32_t;
+        static auto DecodeTexCoord(uint32_t encoded) -> glm::vec2;
+    };
+}  // namespace Vlkrt
@@ -0,0 +1,19 @@
+#include "VulkanUtils.h"
+
+#include "Walnut/Application.h"
+
+namespace Vlkrt
+{
+    auto FindMemoryTypeIndex(uint32_t typeBits, VkMemoryPropertyFlags properties) -> uint32_t
+    {
+        VkPhysicalDeviceMemoryProperties memoryProperties{};
+        vkGetPhysicalDeviceMemoryProperties(Walnut::Application::GetPhysicalDevice(), &memoryProperties);
+
+        for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+            const bool typeSupported = (typeBits & (1u << i)) != 0;
+            const bool flagsMatch    = (memoryProperties.memoryTypes[i].propertyFlags & properties) == properties;
+            if (typeSupported && flagsMatch) return i;
+        }
+        return UINT32_MAX;
+    }
+}  // namespace Vlkrt
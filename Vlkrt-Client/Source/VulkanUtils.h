@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstdint>
+#include <vulkan/vulkan.h>
+
+namespace Vlkrt
+{
+    // Index of the first memory type allowed by typeBits that has all of properties, or UINT32_MAX if none does
+    auto FindMemoryTypeIndex(uint32_t typeBits, VkMemoryPropertyFlags properties) -> uint32_t;
+}  // namespace Vlkrt
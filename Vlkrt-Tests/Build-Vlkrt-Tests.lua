@@ -0,0 +1,96 @@
+project "Vlkrt-Tests"
+   kind "ConsoleApp"
+   language "C++"
+   cppdialect "C++20"
+   targetdir "bin/%{cfg.buildcfg}"
+   staticruntime "off"
+
+   -- The CPU-side client code under test is compiled in directly; it needs no device
+   files
+   {
+      "Source/**.h",
+      "Source/**.cpp",
+
+      "../Vlkrt-Client/Source/GeometryRegistry.h",
+      "../Vlkrt-Client/Source/GeometryRegistry.cpp",
+      "../Vlkrt-Client/Source/MappedFile.h",
+      "../Vlkrt-Client/Source/MappedFile.cpp",
+      "../Vlkrt-Client/Source/MeshLoader.h",
+      "../Vlkrt-Client/Source/MeshLoader.cpp",
+      "../Vlkrt-Client/Source/MeshOptimizer.h",
+      "../Vlkrt-Client/Source/MeshOptimizer.cpp",
+      "../Vlkrt-Client/Source/MeshSimplifier.h",
+      "../Vlkrt-Client/Source/MeshSimplifier.cpp",
+      "../Vlkrt-Client/Source/MeshletBuilder.h",
+      "../Vlkrt-Client/Source/MeshletBuilder.cpp",
+      "../Vlkrt-Client/Source/ObjParser.h",
+      "../Vlkrt-Client/Source/ObjParser.cpp",
+      "../Vlkrt-Client/Source/ThreadPool.h",
+      "../Vlkrt-Client/Source/ThreadPool.cpp",
+      "../Vlkrt-Client/Source/TextureFeedback.h",
+      "../Vlkrt-Client/Source/TextureFeedback.cpp",
+      "../Vlkrt-Client/Source/VertexPacking.h",
+      "../Vlkrt-Client/Source/VertexPacking.cpp",
+   }
+
+   includedirs
+   {
+      "../Vlkrt-Client/Source",
+
+      -- Renderer.h, for GPUVertex
+      "../vendor/nrd/Include",
+      "../vendor/nrd/_NRD_SDK/Include",
+      "../vendor/FidelityFX-SDK-v1.1.4/sdk/include",
+      "../vendor/FidelityFX-SDK-v1.1.4/ffx-api/include",
+
+      "../Walnut/vendor/imgui",
+      "../Walnut/vendor/glfw/include",
+      "../Walnut/vendor/glm",
+      "../Walnut/vendor/spdlog/include",
+      "../vendor/tinygltf",
+
+      "../Walnut/Walnut/Source",
+      "../Walnut/Walnut/Platform/GUI",
+
+      "%{IncludeDir.VulkanSDK}",
+   }
+
+   defines
+   {
+      "VLKRT_NRD_DIRECT_PATH=1",
+      "VLKRT_FSR_ENABLED=1",
+      "GLM_FORCE_DEPTH_ZERO_TO_ONE"
+   }
+
+   links
+   {
+      "Walnut",
+   }
+
+   targetdir ("../bin/" .. outputdir .. "/%{prj.name}")
+   objdir ("../bin-int/" .. outputdir .. "/%{prj.name}")
+
+   -- Model paths (MODELS_DIR) are relative to the project directory, as for the client
+   debugdir "%{prj.location}"
+
+   filter "system:windows"
+      systemversion "latest"
+      defines { "WL_PLATFORM_WINDOWS" }
+      buildoptions { "/utf-8" }
+
+   filter "configurations:Debug"
+      defines { "WL_DEBUG", "_DEBUG" }
+      runtime "Debug"
+      symbols "On"
+
+   filter "configurations:Release"
+      defines { "WL_RELEASE" }
+      runtime "Release"
+      optimize "On"
+      symbols "On"
+
+   filter "configurations:Dist"
+      defines { "WL_DIST" }
+      runtime "Release"
+      optimize "On"
+      symbols "Off"
@@ -0,0 +1,230 @@
+#include "Testing.h"
+
+#include "MeshLoader.h"
+#include "MeshletBuilder.h"
+#include "MeshSimplifier.h"
+#include "Utils.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Vlkrt;
+
+namespace
+{
+    // Closed UV sphere sharing its seam vertices, upper half material slot 0 and lower half slot 1
+    static auto MakeSphere(uint32_t rings, uint32_t segments) -> MeshGeometry
+    {
+        constexpr float kPi = 3.14159265358979f;
+
+        MeshGeometry geometry;
+        geometry.Vertices.push_back({ { 0.0f, 1.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.5f, 0.0f } });
+        for (uint32_t r = 1; r < rings; ++r) {
+            const float theta = kPi * r / rings;
+            for (uint32_t s = 0; s < segments; ++s) {
+                const float phi = 2.0f * kPi * s / segments;
+                const glm::vec3 p(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+                geometry.Vertices.push_back({ p, p, { float(s) / segments, float(r) / rings } });
+            }
+        }
+        geometry.Vertices.push_back({ { 0.0f, -1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f }, { 0.5f, 1.0f } });
+
+        const auto ring = [&](uint32_t r, uint32_t s) { return 1 + (r - 1) * segments + s % segments; };
+        const uint32_t bottom = static_cast<uint32_t>(geometry.Vertices.size() - 1);
+        auto addTriangle      = [&](uint32_t a, uint32_t b, uint32_t c, uint32_t r) {
+            geometry.Indices.insert(geometry.Indices.end(), { a, b, c });
+            geometry.TriangleMaterials.push_back(r < rings / 2 ? 0u : 1u);
+        };
+        for (uint32_t s = 0; s < segments; ++s) {
+            addTriangle(0, ring(1, s + 1), ring(1, s), 0);
+            for (uint32_t r = 1; r + 1 < rings; ++r) {
+                addTriangle(ring(r, s), ring(r, s + 1), ring(r + 1, s + 1), r);
+                addTriangle(ring(r, s), ring(r + 1, s + 1), ring(r + 1, s), r);
+            }
+            addTriangle(bottom, ring(rings - 1, s), ring(rings - 1, s + 1), rings - 1);
+        }
+        geometry.ComputeBounds();
+        return geometry;
+    }
+
+    static auto SortedTriangles(const std::vector<uint32_t>& indices) -> std::vector<std::array<uint32_t, 3>>
+    {
+        std::vector<std::array<uint32_t, 3>> triangles;
+        triangles.reserve(indices.size() / 3);
+        for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+            std::array<uint32_t, 3> triangle{ indices[t], indices[t + 1], indices[t + 2] };
+            std::sort(triangle.begin(), triangle.end());
+            triangles.push_back(triangle);
+        }
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+
+    static void CheckLODChain(const MeshGeometry& geometry, const std::string& name)
+    {
+        const size_t triangleCount          = geometry.Indices.size() / 3;
+        const std::vector<GeometryLOD> lods = MeshSimplifier::GenerateLODs(geometry, 4);
+        if (triangleCount < MeshSimplifier::kMinTriangles) {
+            VLKRT_CHECK_MSG(lods.empty(), name);
+            return;
+        }
+        VLKRT_CHECK_MSG(!lods.empty(), name);
+
+        // Vertices each material's triangles touch in the full mesh; locked material edges keep LOD triangles inside
+        const bool hasMaterials = geometry.TriangleMaterials.size() == triangleCount;
+        std::vector<uint32_t> vertexMaterials(geometry.Vertices.size(), 0);
+        for (size_t t = 0; hasMaterials && t < triangleCount; ++t) {
+            const uint32_t material = 1u << geometry.TriangleMaterials[t];
+            for (int k = 0; k < 3; ++k) vertexMaterials[geometry.Indices[3 * t + k]] |= material;
+        }
+
+        size_t previousTriangles = triangleCount;
+        float previousError      = 0.0f;
+        for (size_t level = 0; level < lods.size(); ++level) {
+            const GeometryLOD& lod    = lods[level];
+            const std::string what    = name + " LOD " + std::to_string(level + 1);
+            const size_t lodTriangles = lod.Indices.size() / 3;
+
+            VLKRT_CHECK_MSG(lod.Indices.size() % 3 == 0, what);
+            VLKRT_CHECK_MSG(lodTriangles > 0 && lodTriangles < previousTriangles, what);
+            VLKRT_CHECK_MSG(lod.Error >= previousError && lod.Error <= MeshSimplifier::kMaxError, what);
+            VLKRT_CHECK_MSG(lod.TriangleMaterials.size() == (hasMaterials ? lodTriangles : 0), what);
+
+            for (size_t t = 0; t < lodTriangles; ++t) {
+                const uint32_t a = lod.Indices[3 * t], b = lod.Indices[3 * t + 1], c = lod.Indices[3 * t + 2];
+                VLKRT_CHECK_MSG(a < geometry.Vertices.size() && b < geometry.Vertices.size()
+                                        && c < geometry.Vertices.size(),
+                        what + " triangle " + std::to_string(t));
+                VLKRT_CHECK_MSG(a != b && b != c && a != c, what + " degenerate triangle " + std::to_string(t));
+                if (!hasMaterials || lod.TriangleMaterials.size() != lodTriangles) continue;
+
+                const uint32_t material = 1u << lod.TriangleMaterials[t];
+                VLKRT_CHECK_MSG((vertexMaterials[a] & material) && (vertexMaterials[b] & material)
+                                        && (vertexMaterials[c] & material),
+                        what + " triangle " + std::to_string(t) + " crosses a material edge");
+            }
+            previousTriangles = lodTriangles;
+            previousError     = lod.Error;
+        }
+    }
+
+    static void CheckMeshlets(const MeshGeometry& geometry, const std::string& name)
+    {
+        const MeshletData data = MeshletBuilder::Build(geometry);
+
+        // Every triangle lands in exactly one meshlet
+        std::vector<uint32_t> rebuilt;
+        rebuilt.reserve(geometry.Indices.size());
+        for (size_t m = 0; m < data.Meshlets.size(); ++m) {
+            const Meshlet& meshlet = data.Meshlets[m];
+            const std::string what = name + " meshlet " + std::to_string(m);
+            VLKRT_CHECK_MSG(meshlet.VertexCount > 0 && meshlet.VertexCount <= MeshletBuilder::kMaxVertices, what);
+            VLKRT_CHECK_MSG(meshlet.TriangleCount > 0 && meshlet.TriangleCount <= MeshletBuilder::kMaxTriangles, what);
+            if (meshlet.VertexOffset + meshlet.VertexCount > data.VertexIndices.size()
+                    || meshlet.TriangleOffset + 3 * meshlet.TriangleCount > data.TriangleIndices.size()) {
+                VLKRT_CHECK_MSG(false, what + " ranges out of bounds");
+                continue;
+            }
+
+            for (uint32_t t = 0; t < meshlet.TriangleCount; ++t) {
+                for (uint32_t k = 0; k < 3; ++k) {
+                    const uint8_t local = data.TriangleIndices[meshlet.TriangleOffset + 3 * t + k];
+                    VLKRT_CHECK_MSG(local < meshlet.VertexCount, what);
+                    const uint32_t index = data.GetTriangleIndex(meshlet, t, k);
+                    rebuilt.push_back(index);
+
+                    const glm::vec3& p = geometry.Vertices[index].Position;
+                    VLKRT_CHECK_MSG(meshlet.Bounds.Overlaps(AABB{ p, p }), what + " bounds");
+                }
+            }
+        }
+        VLKRT_CHECK_MSG(SortedTriangles(rebuilt) == SortedTriangles(geometry.Indices), name + " triangles");
+
+        // A meshlet reported back-facing must have every triangle facing away from the view
+        std::mt19937 rng(7);
+        const glm::vec3 extent = geometry.LocalBounds.GetExtent();
+        const float scale      = std::max({ extent.x, extent.y, extent.z, 1e-3f });
+        std::uniform_real_distribution<float> offset(-2.0f * scale, 2.0f * scale);
+        for (size_t m = 0; m < data.Meshlets.size(); ++m) {
+            const Meshlet& meshlet = data.Meshlets[m];
+            for (int sample = 0; sample < 8; ++sample) {
+                const glm::vec3 view
+                        = geometry.LocalBounds.GetCenter() + glm::vec3(offset(rng), offset(rng), offset(rng));
+                if (!meshlet.IsBackfacing(view)) continue;
+
+                for (uint32_t t = 0; t < meshlet.TriangleCount; ++t) {
+                    const glm::vec3& p0 = geometry.Vertices[data.GetTriangleIndex(meshlet, t, 0)].Position;
+                    const glm::vec3& p1 = geometry.Vertices[data.GetTriangleIndex(meshlet, t, 1)].Position;
+                    const glm::vec3& p2 = geometry.Vertices[data.GetTriangleIndex(meshlet, t, 2)].Position;
+                    const glm::vec3 n   = glm::cross(p1 - p0, p2 - p0);
+                    const float length  = glm::length(n);
+                    if (length <= 1e-12f) continue;
+                    VLKRT_CHECK_MSG(glm::dot(view - p0, n / length) <= 1e-4f * scale,
+                            name + " meshlet " + std::to_string(m) + " culled a front-facing triangle");
+                }
+            }
+        }
+    }
+
+    static auto ModelExists(const std::string& filename) -> bool
+    {
+        std::error_code ec;
+        return std::filesystem::exists(std::filesystem::path(MODELS_DIR) / filename, ec)
+               || std::filesystem::exists(std::filesystem::path(SCENES_DIR) / filename, ec);
+    }
+}  // namespace
+
+VLKRT_TEST(MeshSimplifier_SphereLODs)
+{
+    CheckLODChain(MakeSphere(64, 128), "sphere");
+}
+
+VLKRT_TEST(MeshSimplifier_SmallMeshHasNoLODs)
+{
+    CheckLODChain(MakeSphere(4, 8), "small sphere");
+}
+
+VLKRT_TEST(MeshletBuilder_SphereMeshlets)
+{
+    CheckMeshlets(MakeSphere(64, 128), "sphere");
+}
+
+VLKRT_TEST(MeshProcessing_Bunny)
+{
+    if (!ModelExists("bunny.obj")) {
+        Testing::Skip("bunny.obj is not installed in " + std::string(MODELS_DIR));
+        return;
+    }
+
+    const Mesh mesh = MeshLoader::LoadOBJ("bunny.obj");
+    VLKRT_CHECK(mesh.Geometry && !mesh.Geometry->Indices.empty());
+    if (!mesh.Geometry) return;
+    CheckLODChain(*mesh.Geometry, "bunny");
+    CheckMeshlets(*mesh.Geometry, "bunny");
+}
+
+VLKRT_TEST(MeshProcessing_Sponza)
+{
+    // The scene from README.md; only its largest meshes are checked, to keep the run short
+    const std::string filename = "sponza/NewSponza_Main_glTF_003.gltf";
+    if (!ModelExists(filename)) {
+        Testing::Skip(filename + " is not installed (see README.md)");
+        return;
+    }
+
+    LoadedGLTFScene scene = MeshLoader::LoadGLTF(filename);
+    VLKRT_CHECK(!scene.Meshes.empty());
+    std::sort(scene.Meshes.begin(), scene.Meshes.end(), [](const Mesh& a, const Mesh& b) {
+        return a.GetIndices().size() > b.GetIndices().size();
+    });
+    for (size_t i = 0; i < scene.Meshes.size() && i < 16; ++i) {
+        if (!scene.Meshes[i].Geometry) continue;
+        CheckLODChain(*scene.Meshes[i].Geometry, "sponza " + scene.Meshes[i].Name);
+        CheckMeshlets(*scene.Meshes[i].Geometry, "sponza " + scene.Meshes[i].Name);
+    }
+}
@@ -0,0 +1,181 @@
+#include "Testing.h"
+
+#include "ObjParser.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace Vlkrt;
+
+namespace
+{
+    // Builds an OBJ file of at least minBytes together with the data a serial reader produces from it. It mixes every
+    // corner form, absolute and relative indices reaching anywhere back in the file, out-of-range references, skipped
+    // statements, CRLF line endings and a few usemtl statements far apart, so that most chunks start with faces that
+    // continue the previous chunk's material.
+    static auto MakeSyntheticObj(size_t minBytes, ObjData& outExpected) -> std::string
+    {
+        std::mt19937 rng(2024);
+        auto chance = [&](uint32_t oneIn) { return rng() % oneIn == 0; };
+        auto pick   = [&](size_t count) { return static_cast<int32_t>(rng() % count); };
+        // Multiples of 1/8 print exactly with three decimals, so parsed values compare exactly
+        auto value = [&] { return static_cast<float>(static_cast<int32_t>(rng() % 2001) - 1000) / 8.0f; };
+
+        const char* const kMaterials[] = { "stone", "wood", "metal" };
+        // Faces come before the first usemtl, so slot 0 is the unnamed one
+        outExpected = ObjData{};
+        outExpected.MaterialNames.emplace_back();
+        std::unordered_map<std::string, uint32_t> slots;
+        uint32_t currentSlot = 0;
+
+        std::string text;
+        char buffer[128];
+        auto endLine = [&] { text += chance(3) ? "\r\n" : "\n"; };
+
+        // A reference to one of count attributes, written 1-based or relative. One in a few hundred points past either
+        // end of the file and must resolve to absent.
+        auto writeIndex = [&](size_t count) -> int32_t {
+            if (chance(300)) {
+                text += chance(2) ? "100000000" : std::to_string(-static_cast<int64_t>(count) - 1 - pick(50));
+                return -1;
+            }
+            const int32_t index = pick(count);
+            text += chance(2) ? std::to_string(index + 1) : std::to_string(index - static_cast<int64_t>(count));
+            return index;
+        };
+
+        for (uint32_t block = 0; text.size() < minBytes; ++block) {
+            if (block % 2500 == 1200) {
+                const std::string name = kMaterials[pick(3)];
+                const auto nextSlot    = static_cast<uint32_t>(outExpected.MaterialNames.size());
+                auto [it, inserted]    = slots.try_emplace(name, nextSlot);
+                if (inserted) outExpected.MaterialNames.push_back(name);
+                currentSlot = it->second;
+                text += "usemtl " + name + (chance(2) ? "  " : "");
+                endLine();
+            }
+            if (chance(40)) text += chance(2) ? "# comment\n" : "\n";
+            if (chance(200)) text += chance(2) ? "o object\ng group\n" : "s 1\nmtllib scene.mtl\n";
+
+            for (int i = 1 + pick(3); i > 0; --i) {
+                const glm::vec3 p(value(), value(), value());
+                std::snprintf(buffer, sizeof(buffer), "v %.3f %.3f %.3f", p.x, p.y, p.z);
+                text += buffer;
+                endLine();
+                outExpected.Positions.push_back(p);
+            }
+            for (int i = pick(3); i > 0; --i) {
+                const bool uOnly = chance(10);
+                const glm::vec2 t(value(), uOnly ? 0.0f : value());
+                std::snprintf(buffer, sizeof(buffer), uOnly ? "vt %.3f" : "vt %.3f %.3f", t.x, t.y);
+                text += buffer;
+                endLine();
+                outExpected.TexCoords.push_back(t);
+            }
+            for (int i = pick(3); i > 0; --i) {
+                const glm::vec3 n(value(), value(), value());
+                std::snprintf(buffer, sizeof(buffer), "vn %.3f %.3f %.3f", n.x, n.y, n.z);
+                text += buffer;
+                endLine();
+                outExpected.Normals.push_back(n);
+            }
+
+            for (int face = 1 + pick(2); face > 0; --face) {
+                std::vector<ObjData::Corner> polygon(3 + pick(2));
+                text += "f";
+                for (auto& corner : polygon) {
+                    text += " ";
+                    corner.Position = writeIndex(outExpected.Positions.size());
+
+                    // v, v/t, v//n, v/t/n and v/t/, as far as the attributes written so far allow
+                    const bool hasTexCoords = !outExpected.TexCoords.empty();
+                    const bool hasNormals   = !outExpected.Normals.empty();
+                    switch (pick(5)) {
+                        case 1:
+                            if (!hasTexCoords) break;
+                            text += "/";
+                            corner.TexCoord = writeIndex(outExpected.TexCoords.size());
+                            break;
+                        case 2:
+                            if (!hasNormals) break;
+                            text += "//";
+                            corner.Normal = writeIndex(outExpected.Normals.size());
+                            break;
+                        case 3:
+                            if (!hasTexCoords || !hasNormals) break;
+                            text += "/";
+                            corner.TexCoord = writeIndex(outExpected.TexCoords.size());
+                            text += "/";
+                            corner.Normal = writeIndex(outExpected.Normals.size());
+                            break;
+                        case 4:
+                            if (!hasTexCoords) break;
+                            text += "/";
+                            corner.TexCoord = writeIndex(outExpected.TexCoords.size());
+                            text += "/";
+                            break;
+                        default: break;
+                    }
+                }
+                endLine();
+
+                for (size_t i = 1; i + 1 < polygon.size(); ++i) {
+                    outExpected.Corners.insert(outExpected.Corners.end(), { polygon[0], polygon[i], polygon[i + 1] });
+                    outExpected.TriangleMaterials.push_back(currentSlot);
+                }
+            }
+        }
+
+        // A last line without a trailing newline
+        text += "f 1 2 -1";
+        outExpected.Corners.push_back({ 0, -1, -1 });
+        outExpected.Corners.push_back({ 1, -1, -1 });
+        outExpected.Corners.push_back({ static_cast<int32_t>(outExpected.Positions.size()) - 1, -1, -1 });
+        outExpected.TriangleMaterials.push_back(currentSlot);
+        return text;
+    }
+
+    static auto SameCorner(const ObjData::Corner& a, const ObjData::Corner& b) -> bool
+    {
+        return a.Position == b.Position && a.Normal == b.Normal && a.TexCoord == b.TexCoord;
+    }
+}  // namespace
+
+VLKRT_TEST(ObjParser_ChunkedMatchesSerial)
+{
+    // Several times the minimum chunk size, so the file is split and stitched back together
+    ObjData expected;
+    const std::string text = MakeSyntheticObj(4 * ObjParser::kMinChunkBytes + 12345, expected);
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "vlkrt_objparser_test.obj";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+
+    ObjData actual;
+    const bool parsed = ObjParser::Parse(path, actual);
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    VLKRT_CHECK(parsed);
+    if (!parsed) return;
+
+    VLKRT_CHECK(actual.Positions == expected.Positions);
+    VLKRT_CHECK(actual.Normals == expected.Normals);
+    VLKRT_CHECK(actual.TexCoords == expected.TexCoords);
+    VLKRT_CHECK(actual.MaterialNames == expected.MaterialNames);
+
+    VLKRT_CHECK(actual.Corners.size() == expected.Corners.size());
+    for (size_t c = 0; c < actual.Corners.size() && c < expected.Corners.size(); ++c) {
+        VLKRT_CHECK_MSG(SameCorner(actual.Corners[c], expected.Corners[c]), "corner " + std::to_string(c));
+    }
+    VLKRT_CHECK(actual.TriangleMaterials.size() == expected.TriangleMaterials.size());
+    for (size_t t = 0; t < actual.TriangleMaterials.size() && t < expected.TriangleMaterials.size(); ++t) {
+        VLKRT_CHECK_MSG(actual.TriangleMaterials[t] == expected.TriangleMaterials[t], "triangle " + std::to_string(t));
+    }
+}
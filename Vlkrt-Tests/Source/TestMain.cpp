@@ -0,0 +1,77 @@
+#include "Testing.h"
+
+#include "Walnut/Core/Log.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace Vlkrt::Testing
+{
+    namespace
+    {
+        struct RunState
+        {
+            uint32_t Failures{ 0 };
+            bool Skipped{ false };
+        };
+
+        static RunState s_Current;
+    }  // namespace
+
+    auto GetTests() -> std::vector<TestCase>&
+    {
+        static std::vector<TestCase> s_Tests;
+        return s_Tests;
+    }
+
+    void ReportFailure(const char* file, int line, const std::string& message)
+    {
+        // Cap the output of a check that fails for every element of a large buffer
+        if (++s_Current.Failures <= 10) std::printf("    %s:%d: %s\n", file, line, message.c_str());
+    }
+
+    void Skip(const std::string& reason)
+    {
+        s_Current.Skipped = true;
+        std::printf("    skipped: %s\n", reason.c_str());
+    }
+}  // namespace Vlkrt::Testing
+
+// Runs every test, or only those whose name contains the first argument. Returns the number of failed tests.
+int main(int argc, char** argv)
+{
+    using namespace Vlkrt::Testing;
+
+    Walnut::Log::Init();
+
+    auto& tests = GetTests();
+    std::sort(tests.begin(), tests.end(),
+            [](const TestCase& a, const TestCase& b) { return std::strcmp(a.Name, b.Name) < 0; });
+
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    int failed = 0, passed = 0, skipped = 0;
+    for (const auto& test : tests) {
+        if (filter && !std::strstr(test.Name, filter)) continue;
+
+        std::printf("[ RUN  ] %s\n", test.Name);
+        s_Current = {};
+        test.Run();
+        if (s_Current.Failures > 0) {
+            std::printf("[ FAIL ] %s (%u failed checks)\n", test.Name, s_Current.Failures);
+            ++failed;
+        }
+        else if (s_Current.Skipped) {
+            std::printf("[ SKIP ] %s\n", test.Name);
+            ++skipped;
+        }
+        else {
+            std::printf("[  OK  ] %s\n", test.Name);
+            ++passed;
+        }
+    }
+
+    std::printf("%d passed, %d failed, %d skipped\n", passed, failed, skipped);
+    Walnut::Log::Shutdown();
+    return failed;
+}
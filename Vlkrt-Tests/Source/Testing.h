@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Vlkrt::Testing
+{
+    /// <summary>
+    /// A named test function. VLKRT_TEST registers one at static initialization; main runs them in name order.
+    /// </summary>
+    struct TestCase
+    {
+        const char* Name;
+        void (*Run)();
+    };
+
+    auto GetTests() -> std::vector<TestCase>&;
+
+    struct Registrar
+    {
+        Registrar(const char* name, void (*run)()) { GetTests().push_back({ name, run }); }
+    };
+
+    // Records a failed check against the running test; the test carries on so that one run reports every failure.
+    void ReportFailure(const char* file, int line, const std::string& message);
+    // Marks the running test as skipped, e.g. when an optional asset is not installed.
+    void Skip(const std::string& reason);
+}  // namespace Vlkrt::Testing
+
+#define VLKRT_TEST(name)                                                                                               \
+    static void name();                                                                                                \
+    static const ::Vlkrt::Testing::Registrar s_##name##Registrar(#name, &name);                                        \
+    static void name()
+
+#define VLKRT_CHECK(condition)                                                                                         \
+    do {                                                                                                               \
+        if (!(condition)) ::Vlkrt::Testing::ReportFailure(__FILE__, __LINE__, #condition);                             \
+    } while (0)
+
+// As VLKRT_CHECK, appending message (a std::string, e.g. naming the offending element) when it fails
+#define VLKRT_CHECK_MSG(condition, message)                                                                            \
+    do {                                                                                                               \
+        if (!(condition)) {                                                                                            \
+            ::Vlkrt::Testing::ReportFailure(__FILE__, __LINE__, std::string(#condition ": ") + (message));             \
+        }                                                                                                              \
+    } while (0)
@@ -0,0 +1,163 @@
+#include "Testing.h"
+
+#include "TextureFeedback.h"
+
+#include <string>
+#include <vector>
+
+using namespace Vlkrt;
+
+namespace
+{
+    constexpr uint64_t kWindow = TextureFeedback::kHistoryFrames;
+
+    // Feedback value for a level relative to the bound texture's top level (negative for finer ones)
+    static auto Sampled(int32_t relativeLevel) -> uint32_t
+    {
+        return static_cast<uint32_t>(TextureFeedback::kLevelBias + relativeLevel);
+    }
+
+    static auto MakeSlot(uint32_t residentFirstMip, uint32_t mipCount = 10, uint32_t tailMip = 6)
+            -> TextureFeedback::Slot
+    {
+        return { residentFirstMip, mipCount, tailMip };
+    }
+
+    static void Feed(TextureFeedback& feedback, const std::vector<uint32_t>& values,
+            const std::vector<TextureFeedback::Slot>& slots, uint64_t frame)
+    {
+        feedback.Accumulate(values, slots, frame);
+    }
+
+    // Feeds frames first..last with the same feedback, as the renderer does once per frame
+    static void Feed(TextureFeedback& feedback, const std::vector<uint32_t>& values,
+            const std::vector<TextureFeedback::Slot>& slots, uint64_t first, uint64_t last)
+    {
+        for (uint64_t frame = first; frame <= last; ++frame) feedback.Accumulate(values, slots, frame);
+    }
+}  // namespace
+
+VLKRT_TEST(TextureFeedback_LevelBiasAndClamping)
+{
+    const std::vector<TextureFeedback::Slot> slots = { MakeSlot(2), MakeSlot(2), MakeSlot(2), MakeSlot(2),
+        MakeSlot(2), MakeSlot(0, 0) };
+    const std::vector<uint32_t> values             = { Sampled(0), Sampled(-1), 0, Sampled(20),
+        TextureFeedback::kNoFeedback, Sampled(0) };
+
+    TextureFeedback feedback;
+    feedback.Reset(slots.size(), 0);
+    feedback.Accumulate(values, slots, 1);
+
+    VLKRT_CHECK(feedback.GetWantedMip(0) == 2);  // The bound top level, in source levels
+    VLKRT_CHECK(feedback.GetWantedMip(1) == 1);  // Finer than bound
+    VLKRT_CHECK(feedback.GetWantedMip(2) == 0);  // Clamped to the finest source level
+    VLKRT_CHECK(feedback.GetWantedMip(3) == 9);  // Clamped to the coarsest source level
+    VLKRT_CHECK(feedback.GetWantedMip(4) == TextureFeedback::kNoFeedback);
+    VLKRT_CHECK(feedback.GetWantedMip(5) == TextureFeedback::kNoFeedback);  // Empty slot
+    VLKRT_CHECK(feedback.GetWantedMip(slots.size()) == TextureFeedback::kNoFeedback);
+
+    // The finest level seen in a window wins
+    Feed(feedback, { Sampled(-2), Sampled(3) }, slots, 2);
+    VLKRT_CHECK(feedback.GetWantedMip(0) == 0);
+    VLKRT_CHECK(feedback.GetWantedMip(1) == 1);
+}
+
+VLKRT_TEST(TextureFeedback_TwoWindowHysteresis)
+{
+    const std::vector<TextureFeedback::Slot> slots = { MakeSlot(0) };
+
+    TextureFeedback feedback;
+    feedback.Reset(slots.size(), 0);
+    Feed(feedback, { Sampled(1) }, slots, 0);
+
+    // Coarser feedback takes over only once the window holding the fine sample has aged out of both windows
+    for (uint64_t frame = 1; frame < 2 * kWindow; ++frame) {
+        Feed(feedback, { Sampled(5) }, slots, frame);
+        VLKRT_CHECK_MSG(feedback.GetWantedMip(0) == 1, "frame " + std::to_string(frame));
+    }
+    Feed(feedback, { Sampled(5) }, slots, 2 * kWindow);
+    VLKRT_CHECK(feedback.GetWantedMip(0) == 5);
+
+    // Finer feedback takes over at once
+    Feed(feedback, { Sampled(3) }, slots, 2 * kWindow + 1);
+    VLKRT_CHECK(feedback.GetWantedMip(0) == 3);
+}
+
+VLKRT_TEST(TextureFeedback_PrioritizeOrderAndCap)
+{
+    // All resident from level 5. Slot 3 wants as many levels as slot 0 but was last sampled earlier; slot 4 samples
+    // below what is resident and gives up levels.
+    const std::vector<TextureFeedback::Slot> slots = { MakeSlot(5), MakeSlot(5), MakeSlot(5), MakeSlot(5),
+        MakeSlot(5), MakeSlot(5) };
+    const uint32_t none                            = TextureFeedback::kNoFeedback;
+
+    TextureFeedback feedback;
+    feedback.Reset(slots.size(), 0);
+    Feed(feedback, { Sampled(-2), Sampled(-5), Sampled(-1), Sampled(-2), Sampled(3), Sampled(0) }, slots, 1);
+    Feed(feedback, { Sampled(-2), Sampled(-5), Sampled(-1), none, Sampled(3), Sampled(0) }, slots, 10);
+
+    const std::vector<TextureFeedback::Request> all = feedback.Prioritize(slots, 10, 8);
+    VLKRT_CHECK(all.size() == 5);
+    if (all.size() == 5) {
+        VLKRT_CHECK(all[0].Slot == 1 && all[0].FirstMip == 0);
+        VLKRT_CHECK(all[1].Slot == 0 && all[1].FirstMip == 3);
+        VLKRT_CHECK(all[2].Slot == 3 && all[2].FirstMip == 3);
+        VLKRT_CHECK(all[3].Slot == 2 && all[3].FirstMip == 4);
+        VLKRT_CHECK(all[4].Slot == 4 && all[4].FirstMip == 7 && all[4].Priority < 0.0f);
+        for (size_t i = 0; i + 1 < 4; ++i) VLKRT_CHECK(all[i].Priority > all[i + 1].Priority);
+    }
+
+    // The cap drops the lowest-priority page-ins but keeps every page-out
+    const std::vector<TextureFeedback::Request> capped = feedback.Prioritize(slots, 10, 2);
+    VLKRT_CHECK(capped.size() == 3);
+    if (capped.size() == 3) {
+        VLKRT_CHECK(capped[0].Slot == 1 && capped[1].Slot == 0);
+        VLKRT_CHECK(capped[2].Slot == 4 && capped[2].Priority < 0.0f);
+    }
+
+    const std::vector<TextureFeedback::Request> pageOutsOnly = feedback.Prioritize(slots, 10, 0);
+    VLKRT_CHECK(pageOutsOnly.size() == 1 && pageOutsOnly[0].Slot == 4);
+}
+
+VLKRT_TEST(TextureFeedback_PageOutUnseen)
+{
+    // Fully resident, sampled once at the top level, then not at all
+    const std::vector<TextureFeedback::Slot> slots = { MakeSlot(0) };
+    const uint32_t none                            = TextureFeedback::kNoFeedback;
+
+    TextureFeedback feedback;
+    feedback.Reset(slots.size(), 0);
+    Feed(feedback, { Sampled(0) }, slots, 0);
+    Feed(feedback, { none }, slots, 1, 2 * kWindow);
+    VLKRT_CHECK(feedback.Prioritize(slots, 2 * kWindow, 4).empty());
+
+    Feed(feedback, { none }, slots, 2 * kWindow + 1);
+    const std::vector<TextureFeedback::Request> requests = feedback.Prioritize(slots, 2 * kWindow + 1, 4);
+    VLKRT_CHECK(requests.size() == 1);
+    if (requests.size() == 1) {
+        VLKRT_CHECK(requests[0].Slot == 0 && requests[0].FirstMip == 6 && requests[0].Priority < 0.0f);
+    }
+
+    // Already at the mip tail: nothing left to page out
+    const std::vector<TextureFeedback::Slot> tail = { MakeSlot(6) };
+    VLKRT_CHECK(feedback.Prioritize(tail, 2 * kWindow + 1, 4).empty());
+}
+
+VLKRT_TEST(TextureFeedback_KeepsOneLevelAboveSampled)
+{
+    // Fully resident but sampled three levels down for long enough that the finer history has aged out
+    const std::vector<TextureFeedback::Slot> slots = { MakeSlot(0) };
+
+    TextureFeedback feedback;
+    feedback.Reset(slots.size(), 0);
+    Feed(feedback, { Sampled(3) }, slots, 0, 2 * kWindow);
+    VLKRT_CHECK(feedback.GetWantedMip(0) == 3);
+
+    const std::vector<TextureFeedback::Request> requests = feedback.Prioritize(slots, 2 * kWindow, 4);
+    VLKRT_CHECK(requests.size() == 1);
+    if (requests.size() == 1) VLKRT_CHECK(requests[0].FirstMip == 2 && requests[0].Priority < 0.0f);
+
+    // One level above what is sampled is kept as is
+    const std::vector<TextureFeedback::Slot> oneAbove = { MakeSlot(2) };
+    VLKRT_CHECK(feedback.Prioritize(oneAbove, 2 * kWindow, 4).empty());
+}
@@ -0,0 +1,140 @@
+#include "Testing.h"
+
+#include "Renderer.h"
+#include "VertexPacking.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Vlkrt;
+
+namespace
+{
+    // Random unit normals and UVs, plus the edge cases the encoders special-case
+    static auto MakeVertices(size_t count) -> std::vector<Vertex>
+    {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+        std::vector<Vertex> vertices(count);
+        for (auto& vertex : vertices) {
+            vertex.Position = glm::vec3(unit(rng), unit(rng), unit(rng)) * 100.0f;
+            glm::vec3 normal(unit(rng), unit(rng), unit(rng));
+            vertex.Normal   = glm::length(normal) > 1e-3f ? glm::normalize(normal) : glm::vec3(0.0f, 0.0f, 1.0f);
+            vertex.TexCoord = glm::vec2(unit(rng), unit(rng)) * 8.0f;
+        }
+
+        const glm::vec3 normals[] = { { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f }, { 1.0f, 0.0f, 0.0f },
+            { -1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f }, { -0.0f, 0.6f, -0.8f },
+            { 0.0f, 0.0f, 0.0f } };
+        const glm::vec2 texCoords[] = { { 0.0f, -0.0f }, { 1e-6f, -3e-8f }, { 65504.0f, -65504.0f },
+            { 70000.0f, 0.5f }, { 1.0f / 3.0f, 2.0f / 3.0f } };
+        for (size_t i = 0; i < std::size(normals) && i < count; ++i) vertices[i].Normal = normals[i];
+        for (size_t i = 0; i < std::size(texCoords) && i < count; ++i) vertices[i].TexCoord = texCoords[i];
+        return vertices;
+    }
+
+    static auto AngleDegrees(const glm::vec3& a, const glm::vec3& b) -> double
+    {
+        // atan2 of cross and dot stays accurate for tiny angles, unlike acos of the dot product
+        const glm::dvec3 da(a), db(b);
+        return glm::degrees(std::atan2(glm::length(glm::cross(da, db)), glm::dot(da, db)));
+    }
+
+    static void CheckKernelMatchesScalar(VertexPacking::Kernel kernel, const char* name)
+    {
+        if (!VertexPacking::IsSupported(kernel)) {
+            Testing::Skip(std::string(name) + " is not supported on this CPU");
+            return;
+        }
+
+        // An odd count exercises the AVX2 kernel's single-vertex tail
+        const std::vector<Vertex> vertices = MakeVertices(4099);
+        const glm::mat4 transform(glm::vec4(0.8f, 0.3f, -0.2f, 0.0f), glm::vec4(-0.1f, 1.7f, 0.4f, 0.0f),
+                glm::vec4(0.5f, -0.6f, 0.9f, 0.0f), glm::vec4(1.0f, 2.0f, 3.0f, 1.0f));
+
+        for (const glm::mat4* t : { static_cast<const glm::mat4*>(nullptr), &transform }) {
+            std::vector<GPUVertex> expected(vertices.size()), actual(vertices.size());
+            VertexPacking::PackScalar(vertices.data(), vertices.size(), expected.data(), t);
+            VLKRT_CHECK(VertexPacking::PackWith(kernel, vertices.data(), vertices.size(), actual.data(), t));
+
+            for (size_t i = 0; i < vertices.size(); ++i) {
+                VLKRT_CHECK_MSG(std::memcmp(&expected[i], &actual[i], sizeof(GPUVertex)) == 0,
+                        std::string(name) + (t ? " transformed" : "") + " vertex " + std::to_string(i));
+            }
+        }
+    }
+}  // namespace
+
+VLKRT_TEST(VertexPacking_NormalRoundTripError)
+{
+    // Two snorm16 octahedral coordinates keep every direction within a few thousandths of a degree
+    constexpr double kMaxErrorDegrees = 0.005;
+
+    const std::vector<Vertex> vertices = MakeVertices(100000);
+    double maxError                    = 0.0;
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const glm::vec3& normal = vertices[i].Normal;
+        if (normal == glm::vec3(0.0f)) continue;
+
+        const glm::vec3 decoded = VertexPacking::DecodeNormal(VertexPacking::EncodeNormal(normal));
+        VLKRT_CHECK_MSG(std::abs(glm::length(decoded) - 1.0f) < 1e-5f, "normal " + std::to_string(i));
+        maxError = std::max(maxError, AngleDegrees(normal, decoded));
+    }
+    VLKRT_CHECK_MSG(maxError < kMaxErrorDegrees, std::to_string(maxError) + " degrees");
+
+    // Zero normals encode as +Z
+    const glm::vec3 zero = VertexPacking::DecodeNormal(VertexPacking::EncodeNormal(glm::vec3(0.0f)));
+    VLKRT_CHECK(zero == glm::vec3(0.0f, 0.0f, 1.0f));
+}
+
+VLKRT_TEST(VertexPacking_TexCoordRoundTripError)
+{
+    const std::vector<Vertex> vertices = MakeVertices(100000);
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const glm::vec2& texCoord = vertices[i].TexCoord;
+        const glm::vec2 decoded   = VertexPacking::DecodeTexCoord(VertexPacking::EncodeTexCoord(texCoord));
+        for (int c = 0; c < 2; ++c) {
+            const float value = texCoord[c];
+            if (std::abs(value) > 65504.0f) {
+                VLKRT_CHECK_MSG(std::isinf(decoded[c]) && std::signbit(decoded[c]) == std::signbit(value),
+                        "overflow at " + std::to_string(i));
+                continue;
+            }
+
+            // Round to nearest: half an ulp, 2^-11 relative for normal halves and 2^-25 absolute for subnormal ones
+            const float bound = std::max(std::abs(value) * std::ldexp(1.0f, -11), std::ldexp(1.0f, -25));
+            VLKRT_CHECK_MSG(std::abs(decoded[c] - value) <= bound, "texcoord " + std::to_string(i));
+        }
+    }
+
+    // Values a half represents exactly survive unchanged
+    for (float value : { 0.0f, 0.5f, 1.0f, -2.0f, 1024.0f, 65504.0f, std::ldexp(1.0f, -24) }) {
+        VLKRT_CHECK(VertexPacking::DecodeTexCoord(VertexPacking::EncodeTexCoord(glm::vec2(value))) == glm::vec2(value));
+    }
+}
+
+VLKRT_TEST(VertexPacking_SSE2MatchesScalar)
+{
+    CheckKernelMatchesScalar(VertexPacking::Kernel::SSE2, "SSE2");
+}
+
+VLKRT_TEST(VertexPacking_AVX2MatchesScalar)
+{
+    CheckKernelMatchesScalar(VertexPacking::Kernel::AVX2, "AVX2");
+}
+
+VLKRT_TEST(VertexPacking_ParallelMatchesScalar)
+{
+    // Above the threshold, so the pool splits the work into chunks
+    const std::vector<Vertex> vertices = MakeVertices(VertexPacking::kParallelThreshold * 2 + 1);
+    std::vector<GPUVertex> expected(vertices.size()), actual(vertices.size());
+    VertexPacking::PackScalar(vertices.data(), vertices.size(), expected.data());
+    VertexPacking::PackParallel(vertices.data(), vertices.size(), actual.data());
+    VLKRT_CHECK(std::memcmp(expected.data(), actual.data(), expected.size() * sizeof(GPUVertex)) == 0);
+}